@@ -53,19 +53,26 @@ if [ -f "../data/extreme_performance_data.csv" ]; then
     echo ""
     echo "✓ Dados coletados com sucesso!"
     echo ""
-    echo "Gerando gráficos com Python..."
     cd ..
-    python3 scripts/analyze_extreme_data.py data/extreme_performance_data.csv
+    if [ -x "build/bench_analyze" ]; then
+        echo "Gerando gráficos com bench_analyze..."
+        ./build/bench_analyze data/extreme_performance_data.csv -o reports
+        CHART="reports/bench_analysis.svg"
+    else
+        echo "Gerando gráficos com Python..."
+        python3 scripts/analyze_extreme_data.py data/extreme_performance_data.csv
+        CHART="reports/extreme_performance_analysis.png"
+    fi
     echo ""
     echo "✓ Teste completo!"
     echo ""
     echo "Arquivos gerados:"
     echo "  - data/extreme_performance_data.csv"
     echo "  - reports/extreme_performance_report.txt"
-    echo "  - reports/extreme_performance_analysis.png"
+    echo "  - $CHART"
     echo ""
     echo "Para visualizar os gráficos:"
-    echo "  xdg-open reports/extreme_performance_analysis.png"
+    echo "  xdg-open $CHART"
     echo ""
 else
     echo ""
@@ -17,6 +17,11 @@ class PerformanceAnalyzer:
     def __init__(self, csv_file):
         self.csv_file = csv_file
         self.data = None
+        self.compressed_data = None
+        self.light_sweep_data = None
+        self.lighting_path_data = None
+        self.depth_data = None
+        self.all_data = None
         self.load_data()
     
     def load_data(self):
@@ -24,6 +29,37 @@ class PerformanceAnalyzer:
         try:
             self.data = pd.read_csv(self.csv_file)
             print(f"Dados carregados: {len(self.data)} registros")
+            self.all_data = self.data
+            
+            # Fases com texturas BC1/BC3 ficam separadas para não misturar com as
+            # comparações de iluminação/texturas (que usam RGBA8)
+            if 'Texture_Format' in self.data.columns:
+                compressed = self.data['Texture_Format'].astype(str).str.startswith('BC')
+                self.compressed_data = self.data[compressed]
+                self.data = self.data[~compressed]
+            
+            # Fases com triângulos espalhados em profundidade (ordenação e pré-passada)
+            if 'Depth_Spread' in self.data.columns:
+                depth = (self.data['Depth_Spread'] > 0) | (self.data['Depth_Prepass'].astype(str) == 'true')
+                self.depth_data = self.data[depth]
+                self.data = self.data[~depth]
+            
+            # Comparação forward vs deferred (fases "Forward"/"Deferred" do teste extremo)
+            if 'Lighting_Path' in self.data.columns and 'Phase' in self.data.columns:
+                paths = self.data['Phase'].isin(['Forward', 'Deferred']) | (self.data['Lighting_Path'] == 'deferred')
+                self.lighting_path_data = self.data[paths]
+                self.data = self.data[~paths]
+            
+            # A cena padrão tem 2 luzes; 8 ou mais só aparecem na varredura de luzes
+            # (CSVs antigos não têm a coluna Phase)
+            if 'Phase' in self.data.columns:
+                sweep = self.data['Phase'] == 'Luzes'
+                self.light_sweep_data = self.data[sweep]
+                self.data = self.data[~sweep]
+            elif 'Light_Count' in self.data.columns:
+                sweep = self.data['Light_Count'] >= 8
+                self.light_sweep_data = self.data[sweep]
+                self.data = self.data[~sweep]
         except FileNotFoundError:
             print(f"Arquivo não encontrado: {self.csv_file}")
             sys.exit(1)
@@ -228,6 +264,289 @@ class PerformanceAnalyzer:
         plt.savefig('reports/cpu_gpu_impact.png', dpi=300, bbox_inches='tight')
         plt.close()
     
+    def generate_texture_compression_plot(self):
+        """Gera gráfico comparando texturas RGBA8 e comprimidas (FPS e memória)"""
+        if self.compressed_data is None or self.compressed_data.empty:
+            return
+        
+        uncompressed = self.data[(self.data['Has_Lighting'] == False) & (self.data['Has_Textures'] == True)]
+        formats = [('RGBA8', uncompressed)]
+        for name, group in self.compressed_data.groupby('Texture_Format'):
+            formats.append((name, group))
+        
+        fig, (ax1, ax2) = plt.subplots(1, 2, figsize=(16, 7))
+        
+        for name, group in formats:
+            if not group.empty:
+                ax1.plot(group['Triangle_Count'], group['FPS'], 'o-', label=name, linewidth=2, markersize=5)
+        ax1.set_xlabel('Número de Triângulos')
+        ax1.set_ylabel('FPS')
+        ax1.set_title('Custo de Amostragem por Formato de Textura')
+        ax1.legend()
+        ax1.grid(True, alpha=0.3)
+        
+        names = [name for name, group in formats if not group.empty]
+        memory = [group['Texture_Bytes'].max() / 1024.0 for name, group in formats if not group.empty]
+        ax2.bar(names, memory, color=['skyblue', 'lightgreen', 'orange', 'salmon'][:len(names)])
+        ax2.set_ylabel('Memória de Textura (KB)')
+        ax2.set_title('Memória de Textura na GPU (com mipmaps)')
+        ax2.grid(True, alpha=0.3, axis='y')
+        
+        plt.tight_layout()
+        plt.savefig('reports/texture_compression.png', dpi=300, bbox_inches='tight')
+        plt.close()
+    
+    def generate_light_sweep_plot(self):
+        """Gera gráfico da varredura de luzes (FPS e custo da atribuição aos clusters)"""
+        if self.light_sweep_data is None or self.light_sweep_data.empty:
+            return
+        
+        sweep = self.light_sweep_data.groupby('Light_Count').agg({'FPS': 'mean', 'Cluster_Build_ms': 'mean'})
+        
+        fig, ax1 = plt.subplots(figsize=(12, 8))
+        ax1.plot(sweep.index, sweep['FPS'], 'o-', color='tab:blue', linewidth=2, markersize=6, label='FPS')
+        ax1.set_xscale('log', base=2)
+        ax1.set_xlabel('Número de Luzes')
+        ax1.set_ylabel('FPS', color='tab:blue')
+        ax1.grid(True, alpha=0.3)
+        
+        ax2 = ax1.twinx()
+        ax2.plot(sweep.index, sweep['Cluster_Build_ms'], 's--', color='tab:red', linewidth=2, markersize=6,
+                 label='Atribuição aos clusters (CPU)')
+        ax2.set_ylabel('Atribuição aos clusters (ms)', color='tab:red')
+        
+        plt.title('Iluminação por Clusters: Desempenho vs Número de Luzes')
+        fig.tight_layout()
+        plt.savefig('reports/light_sweep.png', dpi=300, bbox_inches='tight')
+        plt.close()
+    
+    def generate_lighting_path_plot(self):
+        """Gera gráfico forward vs deferred e marca o ponto de cruzamento"""
+        if self.lighting_path_data is None or self.lighting_path_data.empty:
+            return
+        
+        by_path = self.lighting_path_data.groupby(['Lighting_Path', 'Triangle_Count'])['FPS'].mean()
+        if 'forward' not in by_path.index or 'deferred' not in by_path.index:
+            return
+        forward = by_path['forward']
+        deferred = by_path['deferred']
+        lights = int(self.lighting_path_data['Light_Count'].max())
+        
+        plt.figure(figsize=(12, 8))
+        plt.plot(forward.index, forward.values, 'o-', label='Forward', linewidth=2, markersize=6)
+        plt.plot(deferred.index, deferred.values, 's-', label='Deferred (G-buffer)', linewidth=2, markersize=6)
+        
+        common = forward.index.intersection(deferred.index)
+        faster = [count for count in common if deferred[count] > forward[count]]
+        if faster:
+            plt.axvline(x=faster[0], color='gray', linestyle='--', alpha=0.7,
+                        label=f'Cruzamento: {faster[0]} triângulos')
+        
+        plt.xlabel('Número de Triângulos')
+        plt.ylabel('FPS')
+        plt.title(f'Forward vs Deferred ({lights} luzes)')
+        plt.legend()
+        plt.grid(True, alpha=0.3)
+        plt.tight_layout()
+        plt.savefig('reports/forward_vs_deferred.png', dpi=300, bbox_inches='tight')
+        plt.close()
+    
+    def generate_depth_prepass_plot(self):
+        """Gera gráfico de fragmentos sombreados por pixel e FPS com/sem pré-passada"""
+        if self.depth_data is None or self.depth_data.empty:
+            return
+        
+        def mode_name(row):
+            if str(row['Depth_Prepass']) == 'true':
+                return 'Pré-passada + GL_EQUAL'
+            if str(row['Front_To_Back']) == 'true':
+                # Com mais de um bloco a ordem só vale dentro de cada bloco
+                if str(row.get('Sort_Scope', 'scene')) == 'chunk':
+                    return 'Frente para trás (por bloco)'
+                return 'Frente para trás'
+            return 'Ordem de geração'
+        
+        data = self.depth_data.copy()
+        data['Mode'] = data.apply(mode_name, axis=1)
+        
+        fig, (ax1, ax2) = plt.subplots(1, 2, figsize=(16, 7))
+        for name, group in data.groupby('Mode'):
+            ax1.plot(group['Triangle_Count'], group['Fragments_Per_Pixel'], 'o-', label=name, linewidth=2, markersize=5)
+            ax2.plot(group['Triangle_Count'], group['FPS'], 'o-', label=name, linewidth=2, markersize=5)
+        
+        ax1.set_xlabel('Número de Triângulos')
+        ax1.set_ylabel('Fragmentos sombreados / pixel')
+        ax1.set_title('Overdraw Efetivo')
+        ax1.legend()
+        ax1.grid(True, alpha=0.3)
+        
+        ax2.set_xlabel('Número de Triângulos')
+        ax2.set_ylabel('FPS')
+        ax2.set_title('Desempenho por Ordem de Desenho')
+        ax2.legend()
+        ax2.grid(True, alpha=0.3)
+        
+        plt.tight_layout()
+        plt.savefig('reports/depth_prepass.png', dpi=300, bbox_inches='tight')
+        plt.close()
+    
+    def generate_overdraw_plot(self):
+        """Gera gráfico relacionando FPS e overdraw medido (GLPERF_OVERDRAW=1)"""
+        if self.all_data is None or 'Overdraw_Avg' not in self.all_data.columns:
+            return
+        measured = self.all_data[self.all_data['Overdraw_Avg'] > 0]
+        if measured.empty:
+            return
+        
+        groups = measured.groupby('Phase') if 'Phase' in measured.columns else [('Todas', measured)]
+        
+        fig, (ax1, ax2) = plt.subplots(1, 2, figsize=(16, 7))
+        for name, group in groups:
+            ax1.plot(group['Triangle_Count'], group['Overdraw_Avg'], 'o-', label=name, linewidth=2, markersize=5)
+            ax2.scatter(group['Overdraw_Avg'], group['FPS'], label=name, s=30, alpha=0.8)
+        
+        ax1.set_xlabel('Número de Triângulos')
+        ax1.set_ylabel('Fragmentos rasterizados / pixel')
+        ax1.set_title('Overdraw por Fase')
+        ax1.legend()
+        ax1.grid(True, alpha=0.3)
+        
+        ax2.set_xscale('log')
+        ax2.set_xlabel('Overdraw médio (log)')
+        ax2.set_ylabel('FPS')
+        ax2.set_title('FPS vs Custo de Preenchimento')
+        ax2.legend()
+        ax2.grid(True, alpha=0.3)
+        
+        plt.tight_layout()
+        plt.savefig('reports/overdraw.png', dpi=300, bbox_inches='tight')
+        plt.close()
+    
+    def generate_shading_tier_plot(self):
+        """Gera gráfico de FPS por nível de shading (Shading_Tier)"""
+        if self.all_data is None or 'Shading_Tier' not in self.all_data.columns:
+            return
+        tiered = self.all_data[self.all_data['Shading_Tier'] != '-']
+        if tiered['Shading_Tier'].nunique() < 2:
+            return
+        
+        fig, ax = plt.subplots(figsize=(12, 7))
+        for tier, group in tiered.groupby('Shading_Tier'):
+            by_count = group.groupby('Triangle_Count')['FPS'].mean()
+            ax.plot(by_count.index, by_count.values, 'o-', label=tier, linewidth=2, markersize=5)
+        
+        ax.set_xscale('log')
+        ax.set_xlabel('Número de Triângulos (log)')
+        ax.set_ylabel('FPS médio')
+        ax.set_title('Custo dos Níveis de Shading')
+        ax.legend()
+        ax.grid(True, alpha=0.3)
+        
+        plt.tight_layout()
+        plt.savefig('reports/shading_tiers.png', dpi=300, bbox_inches='tight')
+        plt.close()
+    
+    def generate_dynamic_resolution_plot(self):
+        """Gera gráfico de escala de resolução e erro de tempo (DemoInterativo)"""
+        if self.all_data is None or 'GPU_Frame_ms' not in self.all_data.columns:
+            return
+        measured = self.all_data[self.all_data['GPU_Frame_ms'] > 0]
+        if measured.empty:
+            return
+        
+        by_count = measured.groupby('Triangle_Count').agg({
+            'Resolution_Scale': 'mean', 'Frame_Time_Error_ms': 'mean'}).reset_index()
+        
+        fig, (ax1, ax2) = plt.subplots(1, 2, figsize=(16, 7))
+        ax1.plot(by_count['Triangle_Count'], by_count['Resolution_Scale'] * 100, 'o-', linewidth=2, markersize=5)
+        ax1.set_xlabel('Número de Triângulos')
+        ax1.set_ylabel('Escala da resolução (%)')
+        ax1.set_title('Resolução Dinâmica')
+        ax1.grid(True, alpha=0.3)
+        
+        ax2.plot(by_count['Triangle_Count'], by_count['Frame_Time_Error_ms'], 's-', color='red', linewidth=2, markersize=5)
+        ax2.axhline(0, color='gray', linestyle='--')
+        ax2.set_xlabel('Número de Triângulos')
+        ax2.set_ylabel('Tempo de GPU - orçamento (ms)')
+        ax2.set_title('Erro de Tempo de Frame')
+        ax2.grid(True, alpha=0.3)
+        
+        plt.tight_layout()
+        plt.savefig('reports/dynamic_resolution.png', dpi=300, bbox_inches='tight')
+        plt.close()
+    
+    def generate_pipeline_statistics_plot(self):
+        """Gera gráfico de vazão normalizada pelo trabalho real do pipeline (GL_ARB_pipeline_statistics_query)"""
+        if self.all_data is None or 'FS_Invocations' not in self.all_data.columns:
+            return
+        measured = self.all_data[self.all_data['FS_Invocations'] > 0].copy()
+        if measured.empty:
+            return
+        
+        # Invocações por segundo = invocações por frame * FPS; comparável entre máquinas
+        measured['FS_Per_Second'] = measured['FS_Invocations'] * measured['FPS'] / 1e6
+        measured['VS_Per_Second'] = measured['VS_Invocations'] * measured['FPS'] / 1e6
+        groups = measured.groupby('Phase') if 'Phase' in measured.columns else [('Todas', measured)]
+        
+        fig, (ax1, ax2) = plt.subplots(1, 2, figsize=(16, 7))
+        for name, group in groups:
+            ax1.plot(group['Triangle_Count'], group['FS_Per_Second'], 'o-', label=name, linewidth=2, markersize=5)
+            ax2.plot(group['Triangle_Count'], group['VS_Per_Second'], 's-', label=name, linewidth=2, markersize=5)
+        
+        ax1.set_xscale('log')
+        ax1.set_xlabel('Número de Triângulos (log)')
+        ax1.set_ylabel('Milhões de invocações FS / s')
+        ax1.set_title('Vazão de Fragment Shader')
+        ax1.legend()
+        ax1.grid(True, alpha=0.3)
+        
+        ax2.set_xscale('log')
+        ax2.set_xlabel('Número de Triângulos (log)')
+        ax2.set_ylabel('Milhões de invocações VS / s')
+        ax2.set_title('Vazão de Vertex Shader')
+        ax2.legend()
+        ax2.grid(True, alpha=0.3)
+        
+        plt.tight_layout()
+        plt.savefig('reports/pipeline_statistics.png', dpi=300, bbox_inches='tight')
+        plt.close()
+    
+    def generate_driver_time_plot(self):
+        """Gera gráfico do tempo gasto dentro do driver por frame (build com ENABLE_GL_PROFILER)"""
+        if self.all_data is None or 'GL_Driver_ms' not in self.all_data.columns:
+            return
+        measured = self.all_data[(self.all_data['GL_Driver_ms'] > 0) & (self.all_data['FPS'] > 0)].copy()
+        if measured.empty:
+            return
+        
+        # Fração do frame dentro do driver: perto de 100% = limitado pelo driver, não pelo nosso código
+        measured['Driver_Share'] = 100.0 * measured['GL_Driver_ms'] * measured['FPS'] / 1000.0
+        groups = measured.groupby('Phase') if 'Phase' in measured.columns else [('Todas', measured)]
+        
+        fig, (ax1, ax2) = plt.subplots(1, 2, figsize=(16, 7))
+        for name, group in groups:
+            ax1.plot(group['Triangle_Count'], group['Driver_Share'], 'o-', label=name, linewidth=2, markersize=5)
+            ax2.plot(group['Triangle_Count'], group['GL_Upload_Bytes'] / 1024.0, 's-', label=name,
+                     linewidth=2, markersize=5)
+        
+        ax1.set_xscale('log')
+        ax1.set_xlabel('Número de Triângulos (log)')
+        ax1.set_ylabel('% do frame dentro do driver')
+        ax1.set_title('Tempo em Chamadas GL')
+        ax1.legend()
+        ax1.grid(True, alpha=0.3)
+        
+        ax2.set_xscale('log')
+        ax2.set_xlabel('Número de Triângulos (log)')
+        ax2.set_ylabel('KB enviados por frame')
+        ax2.set_title('Dados Enviados ao Driver')
+        ax2.legend()
+        ax2.grid(True, alpha=0.3)
+        
+        plt.tight_layout()
+        plt.savefig('reports/driver_time.png', dpi=300, bbox_inches='tight')
+        plt.close()
+    
     def generate_summary_table(self):
         """Gera tabela resumo dos resultados"""
         print("\n=== TABELA RESUMO DOS RESULTADOS ===")
@@ -263,6 +582,15 @@ class PerformanceAnalyzer:
         self.generate_texture_impact_plot()
         self.generate_comprehensive_comparison_plot()
         self.generate_cpu_gpu_impact_plot()
+        self.generate_texture_compression_plot()
+        self.generate_light_sweep_plot()
+        self.generate_lighting_path_plot()
+        self.generate_depth_prepass_plot()
+        self.generate_overdraw_plot()
+        self.generate_pipeline_statistics_plot()
+        self.generate_dynamic_resolution_plot()
+        self.generate_shading_tier_plot()
+        self.generate_driver_time_plot()
         
         # Gerar tabela resumo
         self.generate_summary_table()
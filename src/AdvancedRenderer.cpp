@@ -1,9 +1,33 @@
 #include "AdvancedRenderer.h"
+#include "AssetCache.h"
+#include "RadixSort.h"
+#include "GLStateCache.h"
+#include "FrameArena.h"
+#include "StagingPool.h"
+#include "GLProfiler.h"
+#include "StartupProfile.h"
+#include "FrameBudget.h"
 #include <iostream>
 #include <cmath>
+#include <algorithm>
 
-AdvancedRenderer::AdvancedRenderer() : VAO(0), VBO(0), lighting(nullptr), texture(nullptr), 
-                                       useLighting(false), useTextures(false), rng(std::random_device{}()) {
+// Definições fora da classe: std::min recebe as constantes por referência
+const size_t AdvancedRenderer::TRIANGLES_PER_CHUNK;
+const size_t AdvancedRenderer::FLOATS_PER_TRIANGLE;
+
+AdvancedRenderer::AdvancedRenderer() : lighting(nullptr), texture(nullptr), 
+                                       deferred(nullptr), depthPrepass(nullptr), overdraw(nullptr),
+                                       shadingGovernor(nullptr), simulation(nullptr), animation(nullptr), streamer(nullptr),
+                                       animationPath(AnimationPath::CPU), requestedAnimationPath(AnimationPath::CPU),
+                                       useLighting(false),
+                                       useTextures(false), useDeferred(false), useDepthPrepass(false),
+                                       sortFrontToBack(true), depthSpread(0.0f), useOverdrawAnalysis(false),
+                                       useSimulationThread(false), useVertexPulling(false),
+                                       useTextureStreaming(false),
+                                       fragmentQueries{0, 0},
+                                       fragmentQueryPending{false, false}, fragmentQueryIndex(0),
+                                       fragmentsPerPixel(0.0), fragmentsPerFrame(0.0), uvScale(1.0f),
+                                       rng(SCENE_SEED) {
 }
 
 AdvancedRenderer::~AdvancedRenderer() {
@@ -11,237 +35,922 @@ AdvancedRenderer::~AdvancedRenderer() {
 }
 
 bool AdvancedRenderer::initialize() {
-    // Criar sistema de iluminação
-    lighting = new Lighting();
-    if (!lighting->initialize()) {
-        std::cerr << "Erro ao inicializar sistema de iluminação" << std::endl;
-        return false;
-    }
+    StartupProfile::Scope phase("Renderer");
     
-    // Criar textura
-    texture = new Texture();
-    if (!texture->generateProcedural()) {
-        std::cerr << "Erro ao gerar textura" << std::endl;
-        return false;
+    // Criar sistema de iluminação (só a variante básica; as demais quando o modo é ligado)
+    {
+        StartupProfile::Scope shaders("Shaders (variante básica)");
+        lighting = new Lighting();
+        if (!lighting->initialize()) {
+            std::cerr << "Erro ao inicializar sistema de iluminação" << std::endl;
+            return false;
+        }
     }
     
+    // A textura procedural só é gerada quando as texturas são ligadas (ensureTexture)
+    
     // Gerar triângulos iniciais
     generateTriangles(1);
 
-    // Gerar e vincular VAO
-    glGenVertexArrays(1, &VAO);
-    glBindVertexArray(VAO);
-
-    // Gerar e vincular VBO
-    glGenBuffers(1, &VBO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-
-    // Configurar atributos de vértice
-    // Atributo de posição (location = 0)
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-
-    // Atributo de cor (location = 1)
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-
-    // Atributo de normal (location = 2)
-    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (void*)(6 * sizeof(float)));
-    glEnableVertexAttribArray(2);
-
-    // Atributo de coordenada de textura (location = 3)
-    glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (void*)(9 * sizeof(float)));
-    glEnableVertexAttribArray(3);
-
-    // Desvincular VAO
-    glBindVertexArray(0);
+    // VAOs e VBOs são criados por bloco em setTriangleCount()
+    
+    glGenQueries(2, fragmentQueries);
+    
+    if (OverdrawAnalyzer::isRequested()) {
+        setOverdrawAnalysis(true);
+    }
+    if (ShadingGovernor::isRequested()) {
+        setShadingGovernor(true);
+    }
+    if (SimulationThread::isRequested()) {
+        setSimulationThread(true);
+    }
+    if (TriangleAnimation::requestedPath() != AnimationPath::CPU) {
+        setAnimationPath(TriangleAnimation::requestedPath());
+    }
+    if (VertexPulling::isRequested()) {
+        setVertexPulling(true);
+    }
+    if (TextureStreamer::requestedRate() > 0) {
+        setTextureStreaming(true, TextureStreamer::DEFAULT_SIZE, TextureStreamer::requestedRate());
+    }
 
     std::cout << "AdvancedRenderer inicializado com sucesso!" << std::endl;
     return true;
 }
 
-void AdvancedRenderer::setTriangleCount(int count) {
+void AdvancedRenderer::setTriangleCount(int64_t count) {
     if (count <= 0) return;
+    // Só a primeira chamada (antes do primeiro frame) entra no perfil de inicialização
+    StartupProfile::Scope phase("Cena");
+    size_t previousCount = triangles.size();
+    
+    // A simulação volta em applyDepthSpread(), já com o novo conjunto
+    if (simulation) {
+        simulation->stop();
+    }
+    
+    resizeChunks(count);
+    
+    // Conjuntos já gerados em execuções anteriores vêm do cache, sem sortear nada.
+    // O cache guarda só os parâmetros por triângulo: os vértices saem deles
+    bool cached = loadCachedTriangles(count);
+    if (!cached) {
+        generateTriangles(count);
+        saveCachedTriangles();
+    }
+    updateAnimationPath();
+    uploadChunks();
+    applyDepthSpread();
+    trimStaging(previousCount);
+    
+    std::cout << "Triângulos avançados configurados: " << count << " em " << chunks.size()
+              << " bloco(s), " << getGeometryBytes() / (1024 * 1024) << " MB de vértices"
+              << (cached ? " (cache)" : "") << std::endl;
+}
+
+void AdvancedRenderer::uploadChunks() {
+    // Vértices (ou registros) montados um bloco por vez em um buffer do pool: o
+    // pico de memória na CPU é um bloco, não a cena inteira, e o próximo passo reusa o buffer
+    StagingBuffer staging(std::min<size_t>(triangles.size(), TRIANGLES_PER_CHUNK) * floatsPerTriangle() *
+                          sizeof(float));
+    for (const GeometryChunk& chunk : chunks) {
+        if (useVertexPulling) {
+            buildChunkRecords(chunk, staging.as<float>());
+        } else {
+            buildChunkVertices(chunk, staging.as<float>());
+        }
+        uploadChunk(chunk, staging.data(), chunk.triangleCount * floatsPerTriangle() * sizeof(float));
+    }
+}
+
+void AdvancedRenderer::trimStaging(size_t previousCount) {
+    // Cena menor: os buffers livres foram dimensionados para a anterior e só
+    // ocupariam memória. Crescendo, eles ficam para o próximo passo reusar
+    if (triangles.size() < previousCount) {
+        StagingPool::trim();
+    }
+}
+
+void AdvancedRenderer::resizeChunks(size_t count) {
+    size_t needed = (count + TRIANGLES_PER_CHUNK - 1) / TRIANGLES_PER_CHUNK;
+    while (chunks.size() > needed) {
+        GeometryChunk& chunk = chunks.back();
+        if (chunk.recordTexture) {
+            GLStateCache::deleteTextures(1, &chunk.recordTexture);
+        }
+        GLStateCache::deleteVertexArrays(1, &chunk.vao);
+        GLStateCache::deleteBuffers(1, &chunk.vbo);
+        chunks.pop_back();
+    }
     
-    generateTriangles(count);
-    
-    // Atualizar buffer de vértices
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    
-    // Criar dados de vértices para todos os triângulos
-    std::vector<float> vertices;
-    vertices.reserve(count * 33); // 11 floats por vértice, 3 vértices por triângulo
-    
-    for (const auto& triangle : triangles) {
-        // Vértice 1 (topo)
-        vertices.push_back(triangle.x);
-        vertices.push_back(triangle.y + 0.1f);
-        vertices.push_back(triangle.z);
-        vertices.push_back(triangle.r);
-        vertices.push_back(triangle.g);
-        vertices.push_back(triangle.b);
-        vertices.push_back(triangle.nx);
-        vertices.push_back(triangle.ny);
-        vertices.push_back(triangle.nz);
-        vertices.push_back(0.5f);
-        vertices.push_back(1.0f);
+    while (chunks.size() < needed) {
+        GeometryChunk chunk;
+        glGenVertexArrays(1, &chunk.vao);
+        GLStateCache::bindVertexArray(chunk.vao);
+        glGenBuffers(1, &chunk.vbo);
+        GLStateCache::bindBuffer(GL_ARRAY_BUFFER, chunk.vbo);
+        chunk.recordTexture = 0;
         
-        // Vértice 2 (esquerda)
-        vertices.push_back(triangle.x - 0.1f);
-        vertices.push_back(triangle.y - 0.1f);
-        vertices.push_back(triangle.z);
-        vertices.push_back(triangle.r);
-        vertices.push_back(triangle.g);
-        vertices.push_back(triangle.b);
-        vertices.push_back(triangle.nx);
-        vertices.push_back(triangle.ny);
-        vertices.push_back(triangle.nz);
-        vertices.push_back(0.0f);
-        vertices.push_back(0.0f);
+        // Com busca programável o VAO fica vazio: o vertex shader lê os registros pela buffer texture
+        if (useVertexPulling) {
+            glGenTextures(1, &chunk.recordTexture);
+            chunks.push_back(chunk);
+            continue;
+        }
+        
+        // Atributos de vértice: posição (0), cor (1), normal (2) e coordenada de textura (3)
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (void*)0);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (void*)(3 * sizeof(float)));
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (void*)(6 * sizeof(float)));
+        glEnableVertexAttribArray(2);
+        glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (void*)(9 * sizeof(float)));
+        glEnableVertexAttribArray(3);
         
-        // Vértice 3 (direita)
-        vertices.push_back(triangle.x + 0.1f);
-        vertices.push_back(triangle.y - 0.1f);
-        vertices.push_back(triangle.z);
-        vertices.push_back(triangle.r);
-        vertices.push_back(triangle.g);
-        vertices.push_back(triangle.b);
-        vertices.push_back(triangle.nx);
-        vertices.push_back(triangle.ny);
-        vertices.push_back(triangle.nz);
-        vertices.push_back(1.0f);
-        vertices.push_back(0.0f);
+        chunks.push_back(chunk);
     }
     
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_DYNAMIC_DRAW);
+    for (size_t c = 0; c < chunks.size(); ++c) {
+        chunks[c].firstTriangle = c * TRIANGLES_PER_CHUNK;
+        chunks[c].triangleCount = std::min(TRIANGLES_PER_CHUNK, count - chunks[c].firstTriangle);
+    }
+}
+
+void AdvancedRenderer::buildChunkVertices(const GeometryChunk& chunk, float* vertex) const {
+    // 11 floats por vértice, 3 vértices por triângulo
+    const float corners[3][4] = {
+        {0.0f, 0.1f, 0.5f, 1.0f},     // Topo
+        {-0.1f, -0.1f, 0.0f, 0.0f},   // Esquerda
+        {0.1f, -0.1f, 1.0f, 0.0f}     // Direita
+    };
+    size_t end = chunk.firstTriangle + chunk.triangleCount;
+    for (size_t i = chunk.firstTriangle; i < end; ++i) {
+        const AdvancedTriangle& triangle = triangles[i];
+        for (const auto& corner : corners) {
+            vertex[0] = triangle.x + corner[0];
+            vertex[1] = triangle.y + corner[1];
+            vertex[2] = triangle.z;
+            vertex[3] = triangle.r;
+            vertex[4] = triangle.g;
+            vertex[5] = triangle.b;
+            vertex[6] = triangle.nx;
+            vertex[7] = triangle.ny;
+            vertex[8] = triangle.nz;
+            vertex[9] = corner[2];
+            vertex[10] = corner[3];
+            vertex += 11;
+        }
+    }
+}
+
+void AdvancedRenderer::buildChunkRecords(const GeometryChunk& chunk, float* record) const {
+    // Mesmo conteúdo dos vértices: z de quando a geometria foi montada (o
+    // espalhamento em profundidade vai na matriz), normal sempre +z
+    size_t end = chunk.firstTriangle + chunk.triangleCount;
+    for (size_t i = chunk.firstTriangle; i < end; ++i) {
+        const AdvancedTriangle& triangle = triangles[i];
+        record[0] = triangle.x;
+        record[1] = triangle.y;
+        record[2] = triangle.z;
+        record[3] = triangle.rotationSpeed;
+        record[4] = triangle.r;
+        record[5] = triangle.g;
+        record[6] = triangle.b;
+        record[7] = 0.0f;
+        record += VertexPulling::FLOATS_PER_RECORD;
+    }
+}
+
+void AdvancedRenderer::uploadChunk(const GeometryChunk& chunk, const void* data, size_t bytes) {
+    GLStateCache::bindBuffer(GL_ARRAY_BUFFER, chunk.vbo);
+    glBufferData(GL_ARRAY_BUFFER, bytes, data, GL_DYNAMIC_DRAW);
+    if (chunk.recordTexture) {
+        GLStateCache::bindTexture(GL_TEXTURE_BUFFER, chunk.recordTexture);
+        glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, chunk.vbo);
+        GLStateCache::bindTexture(GL_TEXTURE_BUFFER, 0);
+    }
+}
+
+bool AdvancedRenderer::loadCachedTriangles(size_t count) {
+    MappedAsset asset;
+    if (!AssetCache::open("triangles_advanced_seed" + std::to_string(SCENE_SEED), ASSET_TRIANGLES, asset)) {
+        if (AssetCache::isEnabled()) {
+            AssetCache::recordMiss();
+        }
+        return false;
+    }
     
-    std::cout << "Triângulos avançados configurados: " << count << std::endl;
+    // Entrada menor que o pedido ou gravada com outro layout (inclusive as antigas,
+    // que traziam os vértices em blocos extras): gerar e substituir
+    const AssetHeader& header = asset.getHeader();
+    size_t cachedCount = header.params[0];
+    bool valid = cachedCount >= count && header.params[1] == SCENE_SEED &&
+                 header.params[2] == sizeof(AdvancedTriangle) && asset.getChunkCount() == 1 &&
+                 asset.getChunk(0).size >= count * sizeof(AdvancedTriangle);
+    if (!valid) {
+        AssetCache::recordMiss();
+        return false;
+    }
+    
+    const AdvancedTriangle* cached = static_cast<const AdvancedTriangle*>(asset.getChunkData(0));
+    triangles.assign(cached, cached + count);
+    AssetCache::recordHit();
+    return true;
+}
+
+void AdvancedRenderer::saveCachedTriangles() {
+    if (!AssetCache::isEnabled()) {
+        return;
+    }
+    AssetWriter writer;
+    uint32_t params[8] = {(uint32_t)triangles.size(), SCENE_SEED, sizeof(AdvancedTriangle)};
+    if (writer.begin(AssetCache::pathFor("triangles_advanced_seed" + std::to_string(SCENE_SEED)),
+                     ASSET_TRIANGLES, params)) {
+        writer.addChunk(triangles.data(), triangles.size() * sizeof(AdvancedTriangle));
+        writer.finish();
+    }
 }
 
 void AdvancedRenderer::setLightingEnabled(bool enabled) {
+    if (enabled) {
+        lighting->prepareVariants(true, useTextures);
+    }
     useLighting = enabled;
     std::cout << "Iluminação " << (enabled ? "habilitada" : "desabilitada") << std::endl;
 }
 
+void AdvancedRenderer::setLightCount(int count) {
+    if (lighting && count > 0) {
+        lighting->generateLights(count);
+    }
+}
+
+void AdvancedRenderer::setDeferredShading(bool enabled) {
+    // G-buffer e shaders só são criados na primeira vez que o caminho é usado
+    if (enabled && !deferred) {
+        deferred = new DeferredShading();
+        if (!deferred->initialize()) {
+            std::cerr << "Erro ao inicializar iluminação adiada, mantendo forward" << std::endl;
+            delete deferred;
+            deferred = nullptr;
+            return;
+        }
+    }
+    useDeferred = enabled;
+    std::cout << "Iluminação " << (enabled ? "adiada (deferred)" : "forward") << std::endl;
+}
+
+void AdvancedRenderer::setDepthPrepass(bool enabled) {
+    if (enabled && !depthPrepass) {
+        depthPrepass = new DepthPrepass();
+        if (!depthPrepass->initialize()) {
+            std::cerr << "Erro ao inicializar pré-passada de profundidade" << std::endl;
+            delete depthPrepass;
+            depthPrepass = nullptr;
+            return;
+        }
+    }
+    useDepthPrepass = enabled;
+    std::cout << "Pré-passada de profundidade " << (enabled ? "habilitada" : "desabilitada") << std::endl;
+}
+
+void AdvancedRenderer::setOverdrawAnalysis(bool enabled) {
+    if (enabled && !overdraw) {
+        overdraw = new OverdrawAnalyzer();
+        if (!overdraw->initialize()) {
+            std::cerr << "Erro ao inicializar instrumentação de overdraw" << std::endl;
+            delete overdraw;
+            overdraw = nullptr;
+            return;
+        }
+    }
+    useOverdrawAnalysis = enabled;
+    std::cout << "Instrumentação de overdraw " << (enabled ? "habilitada" : "desabilitada") << std::endl;
+}
+
+bool AdvancedRenderer::writeOverdrawHeatmap(const std::string& path) const {
+    return overdraw && overdraw->writeHeatmap(path);
+}
+
+void AdvancedRenderer::setShadingGovernor(bool enabled) {
+    if (!shadingGovernor) {
+        if (!enabled) return;
+        shadingGovernor = new ShadingGovernor(FrameBudget::requestedTargetMs());
+    }
+    shadingGovernor->setAutomatic(enabled);
+}
+
+void AdvancedRenderer::setSimulationThread(bool enabled) {
+    if (enabled && !simulation) {
+        simulation = new SimulationThread();
+    }
+    useSimulationThread = enabled;
+    if (enabled) {
+        simulation->start(triangles, drawOrder);
+    } else if (simulation) {
+        simulation->stop();
+    }
+    std::cout << "Thread de simulação " << (enabled ? "habilitada" : "desabilitada");
+    if (enabled) {
+        std::cout << " (" << simulation->getRateHz() << " Hz)";
+    }
+    std::cout << std::endl;
+}
+
+bool AdvancedRenderer::setAnimationPath(AnimationPath path) {
+    if (path == AnimationPath::Compute && !TriangleAnimation::isComputeSupported()) {
+        std::cerr << "Animação por compute shader requer OpenGL 4.3, mantendo "
+                  << TriangleAnimation::pathName(animationPath) << std::endl;
+        return false;
+    }
+    AnimationPath effective = effectiveAnimationPath(path);
+    if (!prepareAnimation(effective)) {
+        return false;
+    }
+    
+    requestedAnimationPath = path;
+    animationPath = effective;
+    uploadAnimationState();
+    restartSimulation();
+    std::cout << "Animação dos triângulos: " << TriangleAnimation::pathName(animationPath);
+    if (animationPath != path) {
+        std::cout << " (caminho da CPU limitado a " << CPU_PATH_MAX_TRIANGLES << " triângulos)";
+    }
+    std::cout << std::endl;
+    return true;
+}
+
+AnimationPath AdvancedRenderer::effectiveAnimationPath(AnimationPath path) const {
+    if (path == AnimationPath::CPU && triangles.size() > CPU_PATH_MAX_TRIANGLES) {
+        return AnimationPath::VertexShader;
+    }
+    return path;
+}
+
+void AdvancedRenderer::updateAnimationPath() {
+    AnimationPath effective = effectiveAnimationPath(requestedAnimationPath);
+    if (effective == animationPath || !prepareAnimation(effective)) {
+        return;
+    }
+    animationPath = effective;
+    std::cout << "Animação dos triângulos: " << TriangleAnimation::pathName(animationPath);
+    if (animationPath != requestedAnimationPath) {
+        std::cout << " (" << triangles.size() << " triângulos, caminho da CPU limitado a "
+                  << CPU_PATH_MAX_TRIANGLES << ")";
+    }
+    std::cout << std::endl;
+}
+
+bool AdvancedRenderer::prepareAnimation(AnimationPath path) {
+    if (path != AnimationPath::CPU && !animation) {
+        animation = new TriangleAnimation();
+        if (!animation->initialize(TRIANGLES_PER_CHUNK)) {
+            std::cerr << "Erro ao inicializar animação na GPU" << std::endl;
+            delete animation;
+            animation = nullptr;
+            return false;
+        }
+    }
+    // Como em setVertexPulling: recusar quando os limites do driver não comportam as fatias
+    if (path != AnimationPath::CPU && animation->sliceSizeFor(path) == 0) {
+        std::cerr << "Animação " << TriangleAnimation::pathName(path) << " indisponível (sem compute shader ou"
+                  << " GL_MAX_TEXTURE_BUFFER_SIZE/GL_MAX_SHADER_STORAGE_BLOCK_SIZE pequenos demais), mantendo "
+                  << TriangleAnimation::pathName(animationPath) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool AdvancedRenderer::setVertexPulling(bool enabled) {
+    if (enabled == useVertexPulling) {
+        return true;
+    }
+    if (enabled && !VertexPulling::isSupported(TRIANGLES_PER_CHUNK)) {
+        std::cerr << "Busca programável de vértices indisponível (GL_MAX_TEXTURE_BUFFER_SIZE menor que "
+                  << TRIANGLES_PER_CHUNK * VertexPulling::TEXELS_PER_TRIANGLE << " texels)" << std::endl;
+        return false;
+    }
+    
+    // Os VAOs mudam de formato (com/sem atributos): recriar os blocos e reenviar a cena
+    useVertexPulling = enabled;
+    size_t count = chunks.empty() ? 0 : triangles.size();
+    resizeChunks(0);
+    if (count > 0) {
+        setTriangleCount(count);
+    }
+    std::cout << "Busca programável de vértices " << (enabled ? "habilitada" : "desabilitada") << std::endl;
+    return true;
+}
+
+void AdvancedRenderer::uploadAnimationState() {
+    if (animationPath == AnimationPath::CPU || !animation) {
+        return;
+    }
+    // currentRotation é escrito pela simulação: parada aqui, o chamador a
+    // reinicia com restartSimulation() depois do envio
+    if (simulation) {
+        simulation->stop();
+    }
+    
+    if (!animation->allocate(triangles.size(), animationPath == AnimationPath::Compute)) {
+        std::cerr << "Estado da animação não cabe nos limites do driver, voltando para a CPU" << std::endl;
+        animationPath = AnimationPath::CPU;
+        return;
+    }
+    
+    // Uma fatia por vez em um buffer do pool (fora do frame): o pico na CPU é
+    // uma fatia, não a cena
+    size_t sliceTriangles = animation->getSliceTriangles();
+    StagingBuffer staging(std::min(sliceTriangles, triangles.size()) * (sizeof(glm::vec4) + sizeof(float)));
+    glm::vec4* states = staging.as<glm::vec4>();
+    float* rotations = reinterpret_cast<float*>(states + sliceTriangles);
+    for (size_t s = 0; s < animation->getSliceCount(); ++s) {
+        size_t first = s * sliceTriangles;
+        size_t count = std::min(sliceTriangles, triangles.size() - first);
+        for (size_t i = 0; i < count; ++i) {
+            const AdvancedTriangle& triangle = triangles[first + i];
+            states[i] = glm::vec4(triangle.x, triangle.y, triangle.z, triangle.rotationSpeed);
+            rotations[i] = triangle.currentRotation;
+        }
+        animation->uploadSlice(s, states, rotations);
+    }
+}
+
+void AdvancedRenderer::setShadingTier(ShadingTier tier) {
+    if (!shadingGovernor) {
+        shadingGovernor = new ShadingGovernor(FrameBudget::requestedTargetMs());
+    }
+    shadingGovernor->setTier(tier);
+}
+
+void AdvancedRenderer::setDepthSpread(float spread) {
+    depthSpread = std::max(0.0f, spread);
+    applyDepthSpread();
+    std::cout << "Profundidade dos triângulos: z em [-" << depthSpread << ", " << depthSpread << "]" << std::endl;
+}
+
+void AdvancedRenderer::setFrontToBackSort(bool enabled) {
+    sortFrontToBack = enabled;
+    updateDrawOrder();
+    restartSimulation();
+    std::cout << "Ordenação frente para trás " << (enabled ? "habilitada" : "desabilitada") << std::endl;
+}
+
+void AdvancedRenderer::applyDepthSpread() {
+    if (simulation) {
+        simulation->stop();
+    }
+    
+    // Gerador próprio: o z não altera a sequência (nem o cache) dos demais atributos
+    std::mt19937 depthRng(SCENE_SEED + 1);
+    std::uniform_real_distribution<float> depthDist(-depthSpread, depthSpread);
+    for (auto& triangle : triangles) {
+        triangle.z = depthSpread > 0.0f ? depthDist(depthRng) : 0.0f;
+    }
+    updateDrawOrder();
+    uploadAnimationState();
+    restartSimulation();
+}
+
+void AdvancedRenderer::updateDrawOrder() {
+    if (simulation) {
+        simulation->stop();
+    }
+    
+    drawOrder.resize(triangles.size());
+    for (size_t i = 0; i < drawOrder.size(); ++i) {
+        drawOrder[i] = i;
+    }
+    if (sortFrontToBack && depthSpread > 0.0f) {
+        sortDrawOrder();
+    }
+}
+
+void AdvancedRenderer::restartSimulation() {
+    // Snapshots seguem a ordem de desenho: reiniciar com o conjunto novo
+    if (useSimulationThread && simulation) {
+        simulation->start(triangles, drawOrder);
+    }
+}
+
+void AdvancedRenderer::sortDrawOrder() {
+    // Câmera em z = 3 olhando para -z: menor distância primeiro. A rotação é em
+    // torno de z, então a profundidade de cada triângulo não muda entre frames.
+    // Chamada na configuração, fora do frame: rascunho do StagingPool, não da FrameArena
+    StagingBuffer keyBuffer(triangles.size() * sizeof(uint32_t));
+    uint32_t* keys = keyBuffer.as<uint32_t>();
+    for (size_t i = 0; i < triangles.size(); ++i) {
+        keys[i] = floatSortKey(3.0f - triangles[i].z);
+    }
+    parallelRadixSort(keys, drawOrder.data(), drawOrder.size());
+    
+    // Com mais de um bloco, reagrupar por bloco mantendo a ordem de profundidade
+    // dentro de cada um: drawTriangles() liga um VAO e desenha o bloco inteiro
+    if (chunks.size() > 1) {
+        keyBuffer.reset();
+        StagingBuffer groupedBuffer(drawOrder.size() * sizeof(uint32_t));
+        uint32_t* grouped = groupedBuffer.as<uint32_t>();
+        std::vector<size_t> next(chunks.size());
+        for (size_t c = 0; c < chunks.size(); ++c) {
+            next[c] = chunks[c].firstTriangle;
+        }
+        for (uint32_t i : drawOrder) {
+            grouped[next[i / TRIANGLES_PER_CHUNK]++] = i;
+        }
+        std::copy(grouped, grouped + drawOrder.size(), drawOrder.begin());
+    }
+}
+
+bool AdvancedRenderer::ensureTexture() {
+    if (texture) {
+        return true;
+    }
+    StartupProfile::Scope phase("Textura procedural");
+    texture = new Texture();
+    if (!texture->generateProcedural()) {
+        std::cerr << "Erro ao gerar textura" << std::endl;
+        delete texture;
+        texture = nullptr;
+        return false;
+    }
+    return true;
+}
+
 void AdvancedRenderer::setTexturesEnabled(bool enabled) {
+    if (enabled) {
+        if (!ensureTexture()) {
+            return;
+        }
+        lighting->prepareVariants(useLighting, true);
+    }
     useTextures = enabled;
     std::cout << "Texturas " << (enabled ? "habilitadas" : "desabilitadas") << std::endl;
 }
 
+bool AdvancedRenderer::setTextureConfig(int size, int layers, bool cpuMipmaps, TextureFormat format) {
+    StartupProfile::Scope phase("Textura procedural");
+    // Gerada direto na configuração pedida, sem passar pela textura padrão
+    if (!texture) {
+        texture = new Texture();
+    }
+    // Arrays de textura continuam em RGBA8
+    bool ok = layers > 1 ? texture->generateProceduralArray(size, size, layers, cpuMipmaps)
+                         : texture->generateProcedural(size, size, cpuMipmaps, format);
+    if (!ok) {
+        std::cerr << "Erro ao gerar textura " << size << "x" << size << std::endl;
+    }
+    return ok;
+}
+
+bool AdvancedRenderer::setTextureSampling(GLenum minFilter, GLenum magFilter, float anisotropy) {
+    if (!ensureTexture()) {
+        return false;
+    }
+    texture->setSampling(minFilter, magFilter, anisotropy);
+    return true;
+}
+
+void AdvancedRenderer::setUVScale(float scale) {
+    uvScale = scale > 0.0f ? scale : 1.0f;
+}
+
+bool AdvancedRenderer::setTextureStreaming(bool enabled, int size, int texturesPerFrame) {
+    // Outro tamanho ou taxa: recriar PBOs e texturas
+    if (streamer && (!enabled || streamer->getSize() != size || streamer->getTexturesPerFrame() != texturesPerFrame)) {
+        delete streamer;
+        streamer = nullptr;
+    }
+    if (enabled && !streamer) {
+        streamer = new TextureStreamer(size, texturesPerFrame);
+        if (!streamer->initialize()) {
+            std::cerr << "Erro ao inicializar streaming de texturas" << std::endl;
+            delete streamer;
+            streamer = nullptr;
+            return false;
+        }
+        lighting->prepareVariants(useLighting, true);
+    }
+    useTextureStreaming = enabled;
+    std::cout << "Streaming de texturas " << (enabled ? "habilitado" : "desabilitado") << std::endl;
+    return true;
+}
+
 void AdvancedRenderer::render(float deltaTime) {
-    glBindVertexArray(VAO);
+    // O frame anterior terminou: a memória que ele pegou da arena volta a ser livre
+    FrameArena::reset();
+    
+    // Cada modo usa uma variante especializada (sem "if (useTexture)" nem
+    // laço de luzes no shader quando o efeito está desligado)
+    // Com streaming a textura amostrada é a última enviada pelo TextureStreamer
+    // (a procedural até o primeiro upload concluir)
+    GLuint streamedTexture = 0;
+    if (useTextures && useTextureStreaming && streamer) {
+        streamer->update();
+        streamedTexture = streamer->getCurrentTexture();
+    }
+    bool textureArray = !streamedTexture && texture && texture->getLayers() > 1;
     
+    // Os níveis de shading só valem para a iluminação forward
+    bool forwardLighting = useLighting && !useDeferred;
+    if (shadingGovernor && forwardLighting) {
+        shadingGovernor->update(deltaTime, !lighting->isClusteredShading());
+    }
+    ShadingTier tier = forwardLighting ? getShadingTier() : ShadingTier::PerFragment;
+    bool lit = useLighting && tier != ShadingTier::Unlit;
+    
+    // Caminhos na GPU: a rotação avança uma vez, antes de todas as passadas do frame
+    bool gpuAnimation = animationPath != AnimationPath::CPU && animation;
+    if (gpuAnimation) {
+        animation->advance(animationPath, deltaTime);
+        deltaTime = 0.0f;
+    }
+    AnimationPath variantAnimation = gpuAnimation ? animationPath : AnimationPath::CPU;
+    
+    // Todas as passadas do frame usam o mesmo snapshot da simulação
+    const SimulationSnapshot* snapshot = nullptr;
+    if (useSimulationThread && simulation) {
+        simulation->acquire();
+        if (simulation->getSnapshot().transforms.size() == drawOrder.size()) {
+            snapshot = &simulation->getSnapshot();
+        }
+    }
+    
+    // Matriz de visualização
+    glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 0.0f, 3.0f), 
+                               glm::vec3(0.0f, 0.0f, 0.0f), 
+                               glm::vec3(0.0f, 1.0f, 0.0f));
+    
+    // Matriz de projeção
+    glm::mat4 projection = glm::perspective(glm::radians(45.0f), 1024.0f/768.0f, 0.1f, 100.0f);
+    
+    // A divisão em clusters usa a mesma câmera e o viewport atual
+    GLint viewport[4];
+    GLStateCache::getViewport(viewport);
     if (useLighting) {
-        lighting->useShader();
-        lighting->setViewPosition(glm::vec3(0.0f, 0.0f, 3.0f));
-        
-        // Configurar matrizes
-        GLint modelLoc = glGetUniformLocation(lighting->getShaderProgram(), "model");
-        GLint viewLoc = glGetUniformLocation(lighting->getShaderProgram(), "view");
-        GLint projLoc = glGetUniformLocation(lighting->getShaderProgram(), "projection");
-        
-        // Matriz de visualização
-        glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 0.0f, 3.0f), 
-                                   glm::vec3(0.0f, 0.0f, 0.0f), 
-                                   glm::vec3(0.0f, 1.0f, 0.0f));
-        glUniformMatrix4fv(viewLoc, 1, GL_FALSE, glm::value_ptr(view));
-        
-        // Matriz de projeção
-        glm::mat4 projection = glm::perspective(glm::radians(45.0f), 1024.0f/768.0f, 0.1f, 100.0f);
-        glUniformMatrix4fv(projLoc, 1, GL_FALSE, glm::value_ptr(projection));
-        
-        // Configurar textura
-        GLint useTextureLoc = glGetUniformLocation(lighting->getShaderProgram(), "useTexture");
-        glUniform1i(useTextureLoc, useTextures);
-        
-        if (useTextures) {
-            texture->bind(GL_TEXTURE0);
+        lighting->setViewport(viewport[2], viewport[3]);
+        lighting->setCamera(view, glm::radians(45.0f), 1024.0f/768.0f, 0.1f, 100.0f);
+    }
+    
+    // No caminho adiado os triângulos só gravam o G-buffer; as luzes vêm depois
+    bool deferredPass = useLighting && useDeferred;
+    GLuint program;
+    if (deferredPass) {
+        program = deferred->beginGeometryPass(viewport[2], viewport[3], useTextures, textureArray, variantAnimation,
+                                              useVertexPulling);
+        if (!program) {
+            return;
+        }
+    } else {
+        lighting->useVariant(lit, useTextures, textureArray, tier == ShadingTier::PerVertex, variantAnimation,
+                             useVertexPulling);
+        program = lighting->getShaderProgram();
+        if (!program) {
+            return;
         }
         
-        // Renderizar cada triângulo com iluminação
-        for (size_t i = 0; i < triangles.size(); ++i) {
-            AdvancedTriangle& triangle = triangles[i];
-            
-            // Atualizar rotação
-            triangle.currentRotation += triangle.rotationSpeed * deltaTime;
-            if (triangle.currentRotation > 2 * M_PI) {
-                triangle.currentRotation = 0.0f;
+        if (lit) {
+            lighting->setViewPosition(glm::vec3(0.0f, 0.0f, 3.0f));
+        }
+    }
+    
+    // Configurar textura
+    if (useTextures) {
+        glUniform1f(glGetUniformLocation(program, "uvScale"), uvScale);
+    }
+    if (useTextures && streamedTexture) {
+        GLStateCache::bindTextureUnit(GL_TEXTURE0, GL_TEXTURE_2D, streamedTexture);
+    } else if (useTextures) {
+        texture->bind(GL_TEXTURE0);
+        if (textureArray) {
+            glUniform1i(glGetUniformLocation(program, "textureLayers"), texture->getLayers());
+        }
+    }
+    
+    // Pré-passada: a profundidade final de cada pixel é gravada antes do shading
+    // (a rotação avança aqui, e a passada de shading reusa as mesmas matrizes)
+    bool prepass = useDepthPrepass && depthPrepass;
+    if (prepass) {
+        GLuint depthProgram = depthPrepass->beginDepthPass(variantAnimation, useVertexPulling);
+        if (depthProgram) {
+            drawTriangles(depthProgram, view, projection, deltaTime, snapshot);
+            deltaTime = 0.0f;
+            depthPrepass->beginShadingPass();
+            GLStateCache::useProgram(program);
+        } else {
+            prepass = false;
+        }
+    }
+    
+    readFragmentQuery(viewport[2] * viewport[3]);
+    glBeginQuery(GL_SAMPLES_PASSED, fragmentQueries[fragmentQueryIndex]);
+    drawTriangles(program, view, projection, deltaTime, snapshot);
+    glEndQuery(GL_SAMPLES_PASSED);
+    fragmentQueryPending[fragmentQueryIndex] = true;
+    fragmentQueryIndex = 1 - fragmentQueryIndex;
+    
+    if (prepass) {
+        depthPrepass->end();
+    }
+    
+    if (deferredPass) {
+        deferred->lightingPass(lighting, view, glm::vec3(0.0f, 0.0f, 3.0f));
+    }
+    
+    // Instrumentação: redesenhar a cena contando fragmentos (mesmas matrizes do frame)
+    if (useOverdrawAnalysis && overdraw && overdraw->shouldSample()) {
+        GLuint countProgram = overdraw->begin(viewport[2], viewport[3], variantAnimation, useVertexPulling);
+        if (countProgram) {
+            drawTriangles(countProgram, view, projection, 0.0f, snapshot);
+            overdraw->end();
+        }
+    }
+}
+
+void AdvancedRenderer::drawTriangles(GLuint program, const glm::mat4& view, const glm::mat4& projection,
+                                     float deltaTime, const SimulationSnapshot* snapshot) {
+    // Configurar matrizes
+    GLint viewLoc = glGetUniformLocation(program, "view");
+    GLint projLoc = glGetUniformLocation(program, "projection");
+    GLint transformLoc = glGetUniformLocation(program, "transform");
+    GLint modelLoc = glGetUniformLocation(program, "model");
+    GLint normalMatrixLoc = glGetUniformLocation(program, "normalMatrix");
+    GLint recordsLoc = useVertexPulling ? glGetUniformLocation(program, "triangleRecords") : -1;
+    
+    glUniformMatrix4fv(viewLoc, 1, GL_FALSE, glm::value_ptr(view));
+    glUniformMatrix4fv(projLoc, 1, GL_FALSE, glm::value_ptr(projection));
+    
+    // Matrizes calculadas na GPU: um draw por fatia de estado (com os limites
+    // comuns, uma por bloco), na ordem de geração (a ordenação frente para trás
+    // só vale no caminho da CPU)
+    if (animationPath != AnimationPath::CPU && animation) {
+        size_t sliceTriangles = animation->getSliceTriangles();
+        for (const GeometryChunk& chunk : chunks) {
+            bindChunk(chunk, recordsLoc);
+            for (size_t offset = 0; sliceTriangles && offset < chunk.triangleCount; offset += sliceTriangles) {
+                size_t count = std::min(sliceTriangles, chunk.triangleCount - offset);
+                animation->bindSlice(program, animationPath, (chunk.firstTriangle + offset) / sliceTriangles, offset);
+                glDrawArrays(GL_TRIANGLES, (GLint)(offset * 3), (GLsizei)(count * 3));
             }
-            
-            glm::mat4 transform = glm::mat4(1.0f);
-            transform = glm::translate(transform, glm::vec3(triangle.x, triangle.y, triangle.z));
-            transform = glm::rotate(transform, triangle.currentRotation, glm::vec3(0.0f, 0.0f, 1.0f));
-            
-            GLint transformLoc = glGetUniformLocation(lighting->getShaderProgram(), "transform");
-            glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transform));
-            
-            GLint modelLoc = glGetUniformLocation(lighting->getShaderProgram(), "model");
-            glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(transform));
-            
-            // Desenhar triângulo
-            glDrawArrays(GL_TRIANGLES, i * 3, 3);
         }
-    } else {
-        // Renderização simples sem iluminação (similar ao MultiTriangleRenderer)
-        // Criar um shader simples se não tiver iluminação
-        // Por enquanto, vamos usar o shader de iluminação mesmo assim, mas sem as luzes ativas
-        lighting->useShader();
-        
-        // Configurar para não usar texturas nem iluminação
-        GLint useTextureLoc = glGetUniformLocation(lighting->getShaderProgram(), "useTexture");
-        glUniform1i(useTextureLoc, 0);
-        
-        GLint numLightsLoc = glGetUniformLocation(lighting->getShaderProgram(), "numLights");
-        glUniform1i(numLightsLoc, 0); // Sem luzes
-        
-        // Matrizes de visualização
-        GLint viewLoc = glGetUniformLocation(lighting->getShaderProgram(), "view");
-        glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 0.0f, 3.0f), 
-                                   glm::vec3(0.0f, 0.0f, 0.0f), 
-                                   glm::vec3(0.0f, 1.0f, 0.0f));
-        glUniformMatrix4fv(viewLoc, 1, GL_FALSE, glm::value_ptr(view));
-        
-        GLint projLoc = glGetUniformLocation(lighting->getShaderProgram(), "projection");
-        glm::mat4 projection = glm::perspective(glm::radians(45.0f), 1024.0f/768.0f, 0.1f, 100.0f);
-        glUniformMatrix4fv(projLoc, 1, GL_FALSE, glm::value_ptr(projection));
-        
-        // Renderizar cada triângulo
-        for (size_t i = 0; i < triangles.size(); ++i) {
-            AdvancedTriangle& triangle = triangles[i];
-            
-            // Atualizar rotação
-            triangle.currentRotation += triangle.rotationSpeed * deltaTime;
-            if (triangle.currentRotation > 2 * M_PI) {
-                triangle.currentRotation = 0.0f;
+        return;
+    }
+    
+    // Renderizar cada triângulo, um bloco de cada vez: as posições
+    // [firstTriangle, firstTriangle + triangleCount) de drawOrder são os
+    // triângulos do bloco (o VAO fica ligado entre frames com um único bloco)
+    size_t n = 0;
+    for (const GeometryChunk& chunk : chunks) {
+        bindChunk(chunk, recordsLoc);
+        size_t end = std::min(chunk.firstTriangle + chunk.triangleCount, drawOrder.size());
+        for (; n < end; ++n) {
+            uint32_t i = drawOrder[n];
+            glm::mat4 transform;
+            if (snapshot) {
+                transform = snapshot->transforms[n];
+            } else {
+                AdvancedTriangle& triangle = triangles[i];
+                
+                // Atualizar rotação
+                if (deltaTime > 0.0f) {
+                    triangle.currentRotation += triangle.rotationSpeed * deltaTime;
+                    if (triangle.currentRotation > 2 * M_PI) {
+                        triangle.currentRotation = 0.0f;
+                    }
+                }
+                
+                transform = glm::mat4(1.0f);
+                transform = glm::translate(transform, glm::vec3(triangle.x, triangle.y, triangle.z));
+                transform = glm::rotate(transform, triangle.currentRotation, glm::vec3(0.0f, 0.0f, 1.0f));
             }
             
-            glm::mat4 transform = glm::mat4(1.0f);
-            transform = glm::translate(transform, glm::vec3(triangle.x, triangle.y, triangle.z));
-            transform = glm::rotate(transform, triangle.currentRotation, glm::vec3(0.0f, 0.0f, 1.0f));
-            
-            GLint transformLoc = glGetUniformLocation(lighting->getShaderProgram(), "transform");
             glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transform));
+            if (modelLoc != -1) {
+                glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(transform));
+            }
+            if (normalMatrixLoc != -1) {
+                // Transformação rígida (translação + rotação em z): a inversa transposta é a própria rotação
+                glm::mat3 normalMatrix(transform);
+                glUniformMatrix3fv(normalMatrixLoc, 1, GL_FALSE, glm::value_ptr(normalMatrix));
+            }
             
-            GLint modelLoc = glGetUniformLocation(lighting->getShaderProgram(), "model");
-            glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(transform));
-            
-            // Desenhar triângulo
-            glDrawArrays(GL_TRIANGLES, i * 3, 3);
+            // Desenhar triângulo (primeiro vértice relativo ao início do bloco)
+            glDrawArrays(GL_TRIANGLES, (GLint)(i - chunk.firstTriangle) * 3, 3);
         }
     }
-    
-    glBindVertexArray(0);
 }
 
-void AdvancedRenderer::generateTriangles(int count) {
+void AdvancedRenderer::bindChunk(const GeometryChunk& chunk, GLint recordsLoc) {
+    GLStateCache::bindVertexArray(chunk.vao);
+    if (chunk.recordTexture) {
+        GLStateCache::bindTextureUnit(GL_TEXTURE0 + VertexPulling::RECORD_TEXTURE_UNIT, GL_TEXTURE_BUFFER,
+                                      chunk.recordTexture);
+        glUniform1i(recordsLoc, VertexPulling::RECORD_TEXTURE_UNIT);
+    }
+}
+
+void AdvancedRenderer::readFragmentQuery(int pixelCount) {
+    // A consulta deste índice foi emitida dois frames atrás; se ainda não
+    // terminou, mantém o último valor em vez de esperar a GPU
+    if (!fragmentQueryPending[fragmentQueryIndex] || pixelCount <= 0) {
+        return;
+    }
+    GLuint available = 0;
+    glGetQueryObjectuiv(fragmentQueries[fragmentQueryIndex], GL_QUERY_RESULT_AVAILABLE, &available);
+    if (available) {
+        GLuint64 samples = 0;
+        glGetQueryObjectui64v(fragmentQueries[fragmentQueryIndex], GL_QUERY_RESULT, &samples);
+        fragmentsPerFrame = (double)samples;
+        fragmentsPerPixel = fragmentsPerFrame / pixelCount;
+    }
+    fragmentQueryPending[fragmentQueryIndex] = false;
+}
+
+RenderStats AdvancedRenderer::getRenderStats() const {
+    RenderStats stats;
+    if (lighting) {
+        stats.shaderVariant = lighting->getActiveVariantName();
+        if (useLighting) {
+            stats.lightCount = lighting->getEnabledLightCount();
+            stats.clusterBuildMs = lighting->isClusteredShading() ? lighting->getClusterBuildMs() : 0.0;
+        }
+        if (useLighting && useDeferred && deferred) {
+            // A passada de luzes sempre usa as listas por cluster
+            stats.lightingPath = "deferred";
+            stats.shaderVariant = "DEFERRED+" + deferred->getGeometryVariantName();
+            stats.clusterBuildMs = lighting->getClusterBuildMs();
+            stats.gBufferBytes = deferred->getMemoryBytes();
+        } else if (useLighting) {
+            stats.lightingPath = "forward";
+        }
+    }
+    if (useLighting && !useDeferred && lighting) {
+        // Com clusters não há variante Gouraud: o nível por vértice cai para por fragmento
+        ShadingTier tier = getShadingTier();
+        if (tier == ShadingTier::PerVertex && lighting->isClusteredShading()) {
+            tier = ShadingTier::PerFragment;
+        }
+        stats.shadingTier = ShadingGovernor::tierName(tier);
+    }
+    if (useSimulationThread && simulation) {
+        stats.simulationHz = simulation->getMeasuredHz();
+        stats.simulationStepMs = simulation->getStepMs();
+    }
+    stats.arenaAllocations = FrameArena::getLastFrameAllocations();
+    stats.arenaBytes = FrameArena::getLastFrameBytes();
+    stats.stagingBytes = StagingPool::getReservedBytes();
+    stats.geometryBytes = getGeometryBytes();
+    stats.geometryChunks = chunks.size();
+    stats.animationPath = TriangleAnimation::pathName(animationPath);
+    stats.vertexPulling = useVertexPulling;
+    stats.depthPrepass = useDepthPrepass && depthPrepass;
+    // Os caminhos na GPU desenham na ordem de geração. Na CPU a ordem é agrupada
+    // por bloco (um VAO por vez): com mais de um bloco ela só vale dentro de cada um
+    stats.frontToBack = sortFrontToBack && depthSpread > 0.0f && animationPath == AnimationPath::CPU;
+    if (stats.frontToBack) {
+        stats.sortScope = chunks.size() > 1 ? "chunk" : "scene";
+    }
+    stats.depthSpread = depthSpread;
+    stats.shadedFragmentsPerPixel = fragmentsPerPixel;
+    stats.shadedFragments = fragmentsPerFrame;
+    if (useOverdrawAnalysis && overdraw) {
+        stats.overdrawAverage = overdraw->getAverageOverdraw();
+        stats.overdrawMax = overdraw->getMaxOverdraw();
+    }
+    if (texture && useTextures) {
+        stats.textureFormat = TextureCompression::formatName(texture->getFormat());
+        if (TextureCompression::isCompressed(texture->getFormat()) && !texture->isCompressedOnGPU()) {
+            stats.textureFormat += "-decoded";
+        }
+        stats.textureBytes = texture->getMemoryBytes();
+        stats.textureSize = texture->getWidth();
+        stats.minFilter = Texture::filterName(texture->getMinFilter());
+        stats.magFilter = Texture::filterName(texture->getMagFilter());
+        stats.anisotropy = texture->getAnisotropy();
+        stats.uvScale = uvScale;
+    }
+    if (useTextures && useTextureStreaming && streamer) {
+        stats.textureFormat = "RGBA8-stream";
+        stats.textureBytes = (size_t)TextureStreamer::SLOT_COUNT * streamer->getSize() * streamer->getSize() * 4;
+        stats.streamTexturesPerSecond = streamer->getTexturesPerSecond();
+        stats.streamUploadMBps = streamer->getUploadMBps();
+        stats.streamLatencyMs = streamer->getLatencyMs();
+        stats.streamRenderThreadMs = streamer->getRenderThreadMs();
+    }
+    return stats;
+}
+
+void AdvancedRenderer::generateTriangles(size_t count) {
     triangles.clear();
     triangles.reserve(count);
+    rng.seed(SCENE_SEED);
     
     std::uniform_real_distribution<float> posDist(-0.8f, 0.8f);
     std::uniform_real_distribution<float> colorDist(0.5f, 1.0f);
     std::uniform_real_distribution<float> speedDist(0.5f, 2.0f);
     
-    for (int i = 0; i < count; ++i) {
+    for (size_t i = 0; i < count; ++i) {
         AdvancedTriangle triangle;
         triangle.x = posDist(rng);
         triangle.y = posDist(rng);
@@ -262,13 +971,41 @@ void AdvancedRenderer::generateTriangles(int count) {
 }
 
 void AdvancedRenderer::cleanup() {
-    if (VAO) {
-        glDeleteVertexArrays(1, &VAO);
-        VAO = 0;
+    resizeChunks(0);
+    if (fragmentQueries[0]) {
+        glDeleteQueries(2, fragmentQueries);
+        fragmentQueries[0] = fragmentQueries[1] = 0;
+    }
+    if (overdraw) {
+        delete overdraw;
+        overdraw = nullptr;
+    }
+    if (animation) {
+        delete animation;
+        animation = nullptr;
+    }
+    // Para a thread de geração antes de liberar os PBOs mapeados
+    if (streamer) {
+        delete streamer;
+        streamer = nullptr;
+    }
+    // Parar a simulação antes de liberar os triângulos que ela atualiza
+    if (simulation) {
+        delete simulation;
+        simulation = nullptr;
+    }
+    if (shadingGovernor) {
+        shadingGovernor->logSummary();
+        delete shadingGovernor;
+        shadingGovernor = nullptr;
+    }
+    if (depthPrepass) {
+        delete depthPrepass;
+        depthPrepass = nullptr;
     }
-    if (VBO) {
-        glDeleteBuffers(1, &VBO);
-        VBO = 0;
+    if (deferred) {
+        delete deferred;
+        deferred = nullptr;
     }
     if (lighting) {
         delete lighting;
@@ -278,4 +1015,6 @@ void AdvancedRenderer::cleanup() {
         delete texture;
         texture = nullptr;
     }
+    // Nada mais pede staging depois daqui: devolver os buffers livres ao sistema
+    StagingPool::trim();
 }
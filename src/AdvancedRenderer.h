@@ -5,8 +5,18 @@
 #include <vector>
 #include <string>
 #include <random>
+#include <cstdint>
 #include "Lighting.h"
 #include "Texture.h"
+#include "DeferredShading.h"
+#include "DepthPrepass.h"
+#include "OverdrawAnalyzer.h"
+#include "ShadingGovernor.h"
+#include "SimulationThread.h"
+#include "TriangleAnimation.h"
+#include "TextureStreamer.h"
+#include "VertexPulling.h"
+#include "RenderStats.h"
 
 struct AdvancedTriangle {
     float x, y, z;
@@ -17,16 +27,53 @@ struct AdvancedTriangle {
     float currentRotation;
 };
 
+// Faixa contígua de triângulos com VBO e VAO próprios. Nenhum buffer passa de
+// TRIANGLES_PER_CHUNK triângulos, e os deslocamentos do glDrawArrays são
+// relativos ao bloco (cabem em GLint com qualquer total de triângulos)
+struct GeometryChunk {
+    GLuint vao, vbo;
+    GLuint recordTexture;   // Buffer texture sobre o VBO com busca programável de vértices (senão 0)
+    size_t firstTriangle;
+    size_t triangleCount;
+};
+
 class AdvancedRenderer {
 private:
-    GLuint VAO, VBO;
+    std::vector<GeometryChunk> chunks;
     Lighting* lighting;
     Texture* texture;
+    DeferredShading* deferred;
+    DepthPrepass* depthPrepass;
+    OverdrawAnalyzer* overdraw;
+    ShadingGovernor* shadingGovernor;   // nullptr = sempre por fragmento
+    SimulationThread* simulation;       // Rotação dos triângulos fora da thread de render
+    TriangleAnimation* animation;       // Estado dos triângulos na GPU (caminhos VertexShader e Compute)
+    TextureStreamer* streamer;          // Texturas novas a cada frame por PBO (substitui a procedural)
+    AnimationPath animationPath;            // Caminho em uso
+    AnimationPath requestedAnimationPath;   // Pedido em setAnimationPath (CPU vira VertexShader acima do limite)
     std::vector<AdvancedTriangle> triangles;
+    std::vector<uint32_t> drawOrder;   // Índices dos triângulos na ordem de desenho
     std::mt19937 rng;
     
     bool useLighting;
     bool useTextures;
+    bool useDeferred;
+    bool useDepthPrepass;
+    bool sortFrontToBack;
+    float depthSpread;
+    bool useOverdrawAnalysis;
+    bool useSimulationThread;
+    bool useVertexPulling;              // Registro por triângulo em vez de vértices expandidos
+    bool useTextureStreaming;
+    
+    // Fragmentos que passaram no teste de profundidade na passada de shading
+    // (GL_SAMPLES_PASSED; o resultado é lido um frame depois para não travar a CPU)
+    GLuint fragmentQueries[2];
+    bool fragmentQueryPending[2];
+    int fragmentQueryIndex;
+    double fragmentsPerPixel;
+    double fragmentsPerFrame;
+    float uvScale;
     
     // Dados do triângulo com normais e coordenadas de textura
     float triangleVertices[24] = {
@@ -36,23 +83,155 @@ private:
          0.5f, -0.5f, 0.0f,   0.0f, 0.0f, 1.0f,   1.0f, 0.0f   // Direita
     };
 
+    // Semente fixa: o conjunto de N triângulos é prefixo do conjunto de M > N,
+    // então uma única entrada no cache de assets atende qualquer contagem menor
+    static const uint32_t SCENE_SEED = 1337;
+    
+    // 1M triângulos = 132 MB de vértices por buffer
+    static const size_t TRIANGLES_PER_CHUNK = 1 << 20;
+    static const size_t FLOATS_PER_TRIANGLE = 33;   // 3 vértices de 11 floats
+    // O caminho da CPU faz um draw e até três uniforms por triângulo: acima de um
+    // bloco a animação passa para o vertex shader (um draw por bloco)
+    static const size_t CPU_PATH_MAX_TRIANGLES = TRIANGLES_PER_CHUNK;
+
+    // Gerar a textura procedural no primeiro uso
+    bool ensureTexture();
+    
     // Gerar triângulos aleatórios
-    void generateTriangles(int count);
+    void generateTriangles(size_t count);
+    
+    // Criar/remover blocos até cobrir "count" triângulos (VBOs ainda sem dados)
+    void resizeChunks(size_t count);
+    // Devolver ao sistema os buffers de staging livres quando a cena encolheu
+    void trimStaging(size_t previousCount);
+    void buildChunkVertices(const GeometryChunk& chunk, float* vertices) const;
+    // Registros de VertexPulling::FLOATS_PER_RECORD floats por triângulo
+    void buildChunkRecords(const GeometryChunk& chunk, float* records) const;
+    void uploadChunk(const GeometryChunk& chunk, const void* data, size_t bytes);
+    size_t floatsPerTriangle() const {
+        return useVertexPulling ? VertexPulling::FLOATS_PER_RECORD : FLOATS_PER_TRIANGLE;
+    }
+
+    // Montar e enviar os vértices (ou registros) de todos os blocos
+    void uploadChunks();
+
+    // Copiar o prefixo pedido do maior conjunto salvo (só os parâmetros por
+    // triângulo: 52 bytes contra 132 dos vértices montados)
+    bool loadCachedTriangles(size_t count);
+    void saveCachedTriangles();
+    
+    // Sortear o z de cada triângulo em [-depthSpread, depthSpread] (semente fixa)
+    void applyDepthSpread();
+    
+    // Ordem de desenho: frente para trás (radix sort paralelo na profundidade)
+    // quando a cena tem variação de profundidade, senão a ordem de geração.
+    // Para a simulação; ela só volta com restartSimulation()
+    void updateDrawOrder();
+    void sortDrawOrder();
+    
+    // Criar a animação na GPU se preciso; false se o caminho não está disponível
+    bool prepareAnimation(AnimationPath path);
+    AnimationPath effectiveAnimationPath(AnimationPath path) const;
+    // Aplicar o limite do caminho da CPU à contagem atual (antes do envio do estado)
+    void updateAnimationPath();
+    
+    // Enviar centro, velocidade e ângulo dos triângulos para TriangleAnimation
+    // (para a simulação, que escreve os ângulos)
+    void uploadAnimationState();
+    // Religar a simulação (se habilitada) com os triângulos e a ordem atuais,
+    // depois de tudo que lê ou escreve os triângulos fora dela
+    void restartSimulation();
+    
+    // Ligar o VAO do bloco e, com busca programável, os registros dele
+    void bindChunk(const GeometryChunk& chunk, GLint recordsLoc);
+    
+    // Desenhar todos os triângulos com o programa ativo; deltaTime > 0 avança a rotação.
+    // Com snapshot as matrizes vêm prontas da thread de simulação
+    void drawTriangles(GLuint program, const glm::mat4& view, const glm::mat4& projection, float deltaTime,
+                       const SimulationSnapshot* snapshot = nullptr);
+    
+    void readFragmentQuery(int pixelCount);
 
 public:
     AdvancedRenderer();
     ~AdvancedRenderer();
     
     bool initialize();
-    void setTriangleCount(int count);
+    void setTriangleCount(int64_t count);
     void setLightingEnabled(bool enabled);
     void setTexturesEnabled(bool enabled);
+    // Trocar as luzes da cena por "count" luzes pontuais (acima de 8 usa clusters)
+    void setLightCount(int count);
+    // Iluminação adiada (G-buffer + passada de luzes em tela cheia) em vez do shader forward
+    void setDeferredShading(bool enabled);
+    
+    // Pré-passada só de profundidade seguida do shading com GL_EQUAL
+    void setDepthPrepass(bool enabled);
+    // Espalhar os triângulos em profundidade (0 = todos no plano z = 0)
+    void setDepthSpread(float spread);
+    // Desenhar de frente para trás quando há variação de profundidade
+    void setFrontToBackSort(bool enabled);
+    
+    // Contagem de fragmentos por pixel (passada extra a cada OverdrawAnalyzer::SAMPLE_INTERVAL frames)
+    void setOverdrawAnalysis(bool enabled);
+    bool isOverdrawAnalysisEnabled() const { return useOverdrawAnalysis; }
+    // Gravar o mapa de calor da última medição (PPM)
+    bool writeOverdrawHeatmap(const std::string& path) const;
+    
+    // Níveis de shading do caminho forward: seleção automática pelo tempo de
+    // frame (ShadingGovernor) ou nível fixo
+    void setShadingGovernor(bool enabled);
+    void setShadingTier(ShadingTier tier);
+    bool isShadingGovernorEnabled() const { return shadingGovernor && shadingGovernor->isAutomatic(); }
+    ShadingTier getShadingTier() const { return shadingGovernor ? shadingGovernor->getTier() : ShadingTier::PerFragment; }
+    
+    // Simulação (rotação dos triângulos) em thread própria, publicada por buffer triplo
+    void setSimulationThread(bool enabled);
+    bool isSimulationThreadEnabled() const { return useSimulationThread; }
+    
+    // Onde a rotação é calculada: CPU (uniform por triângulo), vertex shader ou
+    // compute shader. Retorna false se o caminho não está disponível (Compute sem GL 4.3).
+    // Com mais de CPU_PATH_MAX_TRIANGLES o pedido CPU usa o vertex shader, e
+    // volta para a CPU quando a contagem cai
+    bool setAnimationPath(AnimationPath path);
+    AnimationPath getAnimationPath() const { return animationPath; }
+    
+    // Busca programável de vértices: um registro compacto por triângulo e os
+    // cantos remontados no vertex shader (recria a geometria da cena atual)
+    bool setVertexPulling(bool enabled);
+    bool isVertexPullingEnabled() const { return useVertexPulling; }
+    
+    // Regenerar a textura procedural (tamanho, camadas de GL_TEXTURE_2D_ARRAY
+    // quando layers > 1, e mipmaps construídos na CPU ou pelo driver)
+    bool setTextureConfig(int size, int layers = 1, bool cpuMipmaps = false,
+                          TextureFormat format = TextureFormat::RGBA8);
+    TextureFormat getTextureFormat() const { return texture ? texture->getFormat() : TextureFormat::RGBA8; }
+    // Filtros e anisotropia da textura procedural (mantidos por setTextureConfig)
+    bool setTextureSampling(GLenum minFilter, GLenum magFilter, float anisotropy = 1.0f);
+    // Coordenadas de textura multiplicadas por "scale": acima de 1 a textura se
+    // repete no triângulo (minificação, acesso espalhado sem mipmaps), abaixo amplia
+    void setUVScale(float scale);
+    float getUVScale() const { return uvScale; }
+    
+    // Amostrar texturas geradas numa thread de fundo e enviadas por PBO, novas a
+    // cada frame (size x size RGBA8, texturesPerFrame por frame)
+    bool setTextureStreaming(bool enabled, int size = TextureStreamer::DEFAULT_SIZE, int texturesPerFrame = 1);
+    bool isTextureStreamingEnabled() const { return useTextureStreaming; }
     void render(float deltaTime);
     void cleanup();
     
-    int getTriangleCount() const { return triangles.size(); }
+    int64_t getTriangleCount() const { return triangles.size(); }
+    size_t getGeometryChunkCount() const { return chunks.size(); }
+    size_t getGeometryBytes() const { return triangles.size() * floatsPerTriangle() * sizeof(float); }
     bool isLightingEnabled() const { return useLighting; }
     bool isTexturesEnabled() const { return useTextures; }
+    bool isDeferredShading() const { return useDeferred; }
+    bool isDepthPrepassEnabled() const { return useDepthPrepass; }
+    float getDepthSpread() const { return depthSpread; }
+    int getLightCount() const { return lighting ? lighting->getEnabledLightCount() : 0; }
+    
+    // Estado atual do renderer para registro junto às medições
+    RenderStats getRenderStats() const;
 };
 
 #endif
@@ -0,0 +1,211 @@
+#include "AssetCache.h"
+#include <iostream>
+#include <sstream>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+std::string AssetCache::directory = "cache/assets";
+int AssetCache::hits = 0;
+int AssetCache::misses = 0;
+
+MappedAsset::MappedAsset() : mapping(nullptr), mappingSize(0), header(nullptr), chunks(nullptr) {
+}
+
+MappedAsset::~MappedAsset() {
+    close();
+}
+
+bool MappedAsset::open(const std::string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < (off_t)sizeof(AssetHeader)) {
+        ::close(fd);
+        return false;
+    }
+
+    void* data = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // O mapeamento continua válido sem o descritor
+    if (data == MAP_FAILED) {
+        return false;
+    }
+    mapping = data;
+    mappingSize = info.st_size;
+
+    // Todo o conteúdo vai ser lido em seguida pelo upload
+    madvise(mapping, mappingSize, MADV_WILLNEED);
+
+    const AssetHeader* candidate = static_cast<const AssetHeader*>(mapping);
+    // Tabela comparada pelo espaço que sobra depois do offset: offset + tamanho
+    // de um cabeçalho corrompido poderia dar a volta em 64 bits
+    if (candidate->magic != ASSET_MAGIC || candidate->version != ASSET_VERSION ||
+        candidate->tableOffset < sizeof(AssetHeader) || candidate->tableOffset % alignof(AssetChunk) != 0 ||
+        candidate->tableOffset > mappingSize ||
+        candidate->chunkCount > (mappingSize - candidate->tableOffset) / sizeof(AssetChunk)) {
+        close();
+        return false;
+    }
+
+    const AssetChunk* table = reinterpret_cast<const AssetChunk*>(static_cast<const char*>(mapping) +
+                                                                  candidate->tableOffset);
+    for (uint32_t i = 0; i < candidate->chunkCount; ++i) {
+        if (table[i].offset > mappingSize || table[i].size > mappingSize - table[i].offset) {
+            close();
+            return false;
+        }
+    }
+
+    header = candidate;
+    chunks = table;
+    return true;
+}
+
+void MappedAsset::close() {
+    if (mapping) {
+        munmap(mapping, mappingSize);
+        mapping = nullptr;
+    }
+    mappingSize = 0;
+    header = nullptr;
+    chunks = nullptr;
+}
+
+AssetWriter::AssetWriter() : position(0) {
+    std::memset(&header, 0, sizeof(header));
+}
+
+AssetWriter::~AssetWriter() {
+    // Gravação abandonada (ex: erro no gerador): descartar o temporário
+    if (file.is_open()) {
+        file.close();
+        std::remove(tempPath.c_str());
+    }
+}
+
+bool AssetWriter::begin(const std::string& filePath, AssetKind kind, const uint32_t params[8]) {
+    // Criar diretório (cache/assets) se necessário
+    std::string partial;
+    std::istringstream parts(filePath.substr(0, filePath.find_last_of('/')));
+    std::string part;
+    while (std::getline(parts, part, '/')) {
+        partial += part + "/";
+        mkdir(partial.c_str(), 0755);
+    }
+
+    // Escrever em arquivo temporário e renomear: processos concorrentes nunca
+    // mapeiam uma entrada pela metade
+    path = filePath;
+    tempPath = path + ".tmp" + std::to_string(getpid());
+    file.open(tempPath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Erro ao gravar cache de assets: " << tempPath << std::endl;
+        return false;
+    }
+
+    std::memset(&header, 0, sizeof(header));
+    header.magic = ASSET_MAGIC;
+    header.version = ASSET_VERSION;
+    header.kind = kind;
+    std::memcpy(header.params, params, sizeof(header.params));
+    chunks.clear();
+
+    // Cabeçalho provisório; o definitivo é gravado em finish()
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    position = sizeof(header);
+    return true;
+}
+
+void AssetWriter::pad() {
+    static const char zeros[ASSET_ALIGNMENT] = {};
+    size_t padding = (ASSET_ALIGNMENT - position % ASSET_ALIGNMENT) % ASSET_ALIGNMENT;
+    file.write(zeros, padding);
+    position += padding;
+}
+
+void AssetWriter::addChunk(const void* data, size_t size, uint32_t width, uint32_t height,
+                           uint32_t level, uint32_t layer, uint32_t glFormat) {
+    if (!file.is_open()) {
+        return;
+    }
+
+    pad();
+    AssetChunk chunk;
+    chunk.offset = position;
+    chunk.size = size;
+    chunk.width = width;
+    chunk.height = height;
+    chunk.level = level;
+    chunk.layer = layer;
+    chunk.glFormat = glFormat;
+    chunk.reserved = 0;
+    chunks.push_back(chunk);
+
+    file.write(static_cast<const char*>(data), size);
+    position += size;
+}
+
+bool AssetWriter::finish() {
+    if (!file.is_open()) {
+        return false;
+    }
+
+    pad();
+    header.chunkCount = chunks.size();
+    header.tableOffset = position;
+    file.write(reinterpret_cast<const char*>(chunks.data()), chunks.size() * sizeof(AssetChunk));
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.close();
+
+    if (file.fail() || std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::cerr << "Erro ao gravar cache de assets: " << path << std::endl;
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool AssetCache::isEnabled() {
+    static int enabled = -1;
+    if (enabled == -1) {
+        const char* env = std::getenv("GLPERF_ASSET_CACHE");
+        enabled = (env && std::string(env) == "0") ? 0 : 1;
+        std::cout << "Cache de assets: "
+                  << (enabled ? "habilitado (" + directory + ")" : std::string("desabilitado (GLPERF_ASSET_CACHE=0)"))
+                  << std::endl;
+    }
+    return enabled == 1;
+}
+
+std::string AssetCache::pathFor(const std::string& name) {
+    return directory + "/" + name + ".glpa";
+}
+
+bool AssetCache::open(const std::string& name, AssetKind kind, MappedAsset& asset) {
+    if (!isEnabled()) {
+        return false;
+    }
+
+    std::string path = pathFor(name);
+    if (access(path.c_str(), F_OK) != 0) {
+        return false;
+    }
+
+    if (!asset.open(path) || asset.getHeader().kind != kind) {
+        std::cerr << "Entrada de cache de assets inválida, gerando novamente: " << path << std::endl;
+        asset.close();
+        std::remove(path.c_str());
+        return false;
+    }
+    return true;
+}
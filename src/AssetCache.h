@@ -0,0 +1,122 @@
+#ifndef ASSETCACHE_H
+#define ASSETCACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Contêiner binário de assets gerados (cadeias de mipmap e conjuntos de triângulos):
+//
+//   [AssetHeader][bloco 0][bloco 1]...[tabela de AssetChunk]
+//
+// Cada bloco começa em um offset múltiplo de ASSET_ALIGNMENT, então o arquivo
+// mapeado com mmap pode ser entregue direto ao driver (glTexImage2D,
+// glBufferData) sem cópia nem parsing.
+const uint32_t ASSET_MAGIC = 0x41504C47;   // "GLPA"
+const uint32_t ASSET_VERSION = 1;          // Incrementar quando os geradores mudarem
+const size_t ASSET_ALIGNMENT = 64;
+
+enum AssetKind : uint32_t {
+    ASSET_TEXTURE = 1,     // params: largura, altura, camadas, TextureFormat, mipmaps da CPU
+    ASSET_TRIANGLES = 2    // params: número de triângulos, semente, sizeof do struct (um bloco só)
+};
+
+struct AssetHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t kind;
+    uint32_t chunkCount;
+    uint64_t tableOffset;
+    uint32_t params[8];    // Parâmetros do gerador, interpretados conforme kind
+};
+
+struct AssetChunk {
+    uint64_t offset;
+    uint64_t size;
+    uint32_t width, height;
+    uint32_t level, layer;
+    uint32_t glFormat;     // Formato interno usado no upload (0 para dados que não são imagem)
+    uint32_t reserved;
+};
+
+// Arquivo de asset mapeado em memória (somente leitura)
+class MappedAsset {
+private:
+    void* mapping;
+    size_t mappingSize;
+    const AssetHeader* header;
+    const AssetChunk* chunks;
+
+public:
+    MappedAsset();
+    ~MappedAsset();
+    MappedAsset(const MappedAsset&) = delete;
+    MappedAsset& operator=(const MappedAsset&) = delete;
+
+    // Mapear e validar o arquivo (magic, versão e limites de todos os blocos)
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return header != nullptr; }
+    const AssetHeader& getHeader() const { return *header; }
+    uint32_t getChunkCount() const { return header->chunkCount; }
+    const AssetChunk& getChunk(uint32_t index) const { return chunks[index]; }
+    const void* getChunkData(uint32_t index) const {
+        return static_cast<const char*>(mapping) + chunks[index].offset;
+    }
+};
+
+// Gravação incremental: os blocos vão direto para o disco, então arrays de
+// texturas grandes não precisam ficar inteiros na memória
+class AssetWriter {
+private:
+    std::ofstream file;
+    std::string path;
+    std::string tempPath;
+    AssetHeader header;
+    std::vector<AssetChunk> chunks;
+    uint64_t position;
+
+    void pad();
+
+public:
+    AssetWriter();
+    ~AssetWriter();
+
+    bool begin(const std::string& filePath, AssetKind kind, const uint32_t params[8]);
+    void addChunk(const void* data, size_t size, uint32_t width = 0, uint32_t height = 0,
+                  uint32_t level = 0, uint32_t layer = 0, uint32_t glFormat = 0);
+    // Gravar a tabela e o cabeçalho final e renomear sobre a entrada antiga
+    bool finish();
+    bool isOpen() const { return file.is_open(); }
+};
+
+// Diretório e estatísticas do cache de assets.
+// Desabilitar com a variável de ambiente GLPERF_ASSET_CACHE=0.
+class AssetCache {
+private:
+    static std::string directory;
+    static int hits;
+    static int misses;
+
+public:
+    static bool isEnabled();
+
+    // Caminho da entrada com o nome dado (os parâmetros do gerador fazem parte do nome)
+    static std::string pathFor(const std::string& name);
+
+    // Abrir a entrada; entradas inválidas ou de outro tipo são removidas
+    static bool open(const std::string& name, AssetKind kind, MappedAsset& asset);
+
+    // O chamador decide se a entrada serve (ex: conjunto de triângulos menor que o pedido)
+    static void recordHit() { hits++; }
+    static void recordMiss() { misses++; }
+
+    static void setDirectory(const std::string& path) { directory = path; }
+    static int getHits() { return hits; }
+    static int getMisses() { return misses; }
+};
+
+#endif
@@ -0,0 +1,649 @@
+#include "BenchAnalyzer.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+// Cores e marcadores padrão do matplotlib, na ordem de BenchAnalyzer::Mode
+const char* const MODE_COLORS[] = {"#1f77b4", "#ff7f0e", "#2ca02c", "#d62728"};
+const char* const MODE_LABELS[] = {"Básico", "Iluminação", "Texturas", "Combinado (Ilum + Text)"};
+
+enum Metric { METRIC_FPS, METRIC_CPU, METRIC_GPU };
+
+double metricValue(const BenchAggregate& aggregate, int metric) {
+    switch (metric) {
+        case METRIC_CPU: return aggregate.cpuAverage();
+        case METRIC_GPU: return aggregate.gpuAverage();
+        default:         return aggregate.fpsAverage();
+    }
+}
+
+// Campo [begin, end) como número. Caminho rápido para o formato que o
+// PerformanceMonitor grava ("-12.345"); expoentes, nan/inf etc. vão para o strtod
+bool parseNumber(const char* begin, const char* end, double& value) {
+    const char* p = begin;
+    bool negative = p < end && *p == '-';
+    if (negative) ++p;
+    uint64_t mantissa = 0;
+    int digits = 0, fractionDigits = 0;
+    bool fraction = false;
+    for (; p < end && digits < 18; ++p) {
+        if (*p >= '0' && *p <= '9') {
+            mantissa = mantissa * 10 + (*p - '0');
+            digits++;
+            fractionDigits += fraction;
+        } else if (*p == '.' && !fraction) {
+            fraction = true;
+        } else {
+            break;
+        }
+    }
+    if (p == end && digits > 0) {
+        static const double powers[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9,
+                                        1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18};
+        value = (double)mantissa / powers[fractionDigits];
+        if (negative) value = -value;
+        return true;
+    }
+
+    // strtod precisa de terminador, e os campos numéricos são curtos
+    char buffer[64];
+    size_t length = end - begin;
+    if (length == 0 || length >= sizeof(buffer)) {
+        return false;
+    }
+    std::memcpy(buffer, begin, length);
+    buffer[length] = '\0';
+    char* parsed = nullptr;
+    value = std::strtod(buffer, &parsed);
+    return parsed == buffer + length && std::isfinite(value);
+}
+
+bool parseBool(const char* begin, const char* end) {
+    return end > begin && (*begin == 't' || *begin == 'T' || *begin == '1');
+}
+
+// Passo "redondo" (1, 2 ou 5 x 10^n) com cerca de 5 divisões
+double niceStep(double range) {
+    if (range <= 0.0) {
+        return 1.0;
+    }
+    double raw = range / 5.0;
+    double magnitude = std::pow(10.0, std::floor(std::log10(raw)));
+    double fraction = raw / magnitude;
+    double nice = fraction < 1.5 ? 1.0 : fraction < 3.0 ? 2.0 : fraction < 7.0 ? 5.0 : 10.0;
+    return nice * magnitude;
+}
+
+// 200000 -> "200.000" (separador de milhar como nos relatórios)
+std::string groupThousands(int64_t value) {
+    std::string digits = std::to_string(value < 0 ? -value : value);
+    std::string result;
+    for (size_t i = 0; i < digits.size(); ++i) {
+        if (i > 0 && (digits.size() - i) % 3 == 0) {
+            result += '.';
+        }
+        result += digits[i];
+    }
+    return value < 0 ? "-" + result : result;
+}
+
+// Rótulo curto de eixo: 150000 -> "150k", 2500000 -> "2.5M"
+std::string axisLabel(double value) {
+    std::ostringstream out;
+    out << std::setprecision(3);
+    if (std::fabs(value) >= 1e6) {
+        out << value / 1e6 << "M";
+    } else if (std::fabs(value) >= 1e3) {
+        out << value / 1e3 << "k";
+    } else {
+        out << value;
+    }
+    return out.str();
+}
+
+std::string escapeXml(const std::string& text) {
+    std::string result;
+    for (char c : text) {
+        switch (c) {
+            case '&': result += "&amp;"; break;
+            case '<': result += "&lt;"; break;
+            case '>': result += "&gt;"; break;
+            default:  result += c;
+        }
+    }
+    return result;
+}
+
+std::string fixed(double value, int precision) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(precision) << value;
+    return out.str();
+}
+
+void appendMarker(std::ostream& svg, int mode, double x, double y) {
+    const char* color = MODE_COLORS[mode];
+    switch (mode) {
+        case BenchAnalyzer::BASIC:
+            svg << "<circle cx=\"" << x << "\" cy=\"" << y << "\" r=\"4\" fill=\"" << color << "\"/>";
+            break;
+        case BenchAnalyzer::LIGHTING:
+            svg << "<rect x=\"" << x - 4 << "\" y=\"" << y - 4 << "\" width=\"8\" height=\"8\" fill=\"" << color
+                << "\"/>";
+            break;
+        case BenchAnalyzer::TEXTURES:
+            svg << "<polygon points=\"" << x << "," << y - 5 << " " << x + 5 << "," << y << " " << x << ","
+                << y + 5 << " " << x - 5 << "," << y << "\" fill=\"" << color << "\"/>";
+            break;
+        default:
+            svg << "<polygon points=\"" << x << "," << y - 5 << " " << x + 5 << "," << y + 4 << " " << x - 5
+                << "," << y + 4 << "\" fill=\"" << color << "\"/>";
+            break;
+    }
+}
+
+}  // namespace
+
+BenchAggregate::BenchAggregate() : samples(0), fpsSum(0.0), fpsMin(0.0), fpsMax(0.0), fpsMinTriangles(0),
+                                   fpsMaxTriangles(0), cpuSum(0.0), gpuSum(0.0), gpuMax(0.0) {
+}
+
+void BenchAggregate::add(int64_t triangles, double fps, double cpu, double gpu) {
+    if (samples == 0 || fps < fpsMin) {
+        fpsMin = fps;
+        fpsMinTriangles = triangles;
+    }
+    if (samples == 0 || fps > fpsMax) {
+        fpsMax = fps;
+        fpsMaxTriangles = triangles;
+    }
+    samples++;
+    fpsSum += fps;
+    cpuSum += cpu;
+    gpuSum += gpu;
+    gpuMax = std::max(gpuMax, gpu);
+}
+
+LinearFit::LinearFit() : n(0.0), sx(0.0), sy(0.0), sxx(0.0), sxy(0.0), syy(0.0) {
+}
+
+void LinearFit::add(double x, double y) {
+    n += 1.0;
+    sx += x;
+    sy += y;
+    sxx += x * x;
+    sxy += x * y;
+    syy += y * y;
+}
+
+double LinearFit::slope() const {
+    double denominator = n * sxx - sx * sx;
+    return n >= 2.0 && denominator != 0.0 ? (n * sxy - sx * sy) / denominator : 0.0;
+}
+
+double LinearFit::intercept() const {
+    return n > 0.0 ? (sy - slope() * sx) / n : 0.0;
+}
+
+double LinearFit::r2() const {
+    double denominator = (n * sxx - sx * sx) * (n * syy - sy * sy);
+    if (n < 3.0 || denominator <= 0.0) {
+        return 0.0;
+    }
+    double numerator = n * sxy - sx * sy;
+    return numerator * numerator / denominator;
+}
+
+BenchAnalyzer::BenchAnalyzer() : rows(0), skippedRows(0), files(0), bytesRead(0), parseMs(0.0),
+                                 minTriangles(0), maxTriangles(0), gpuBottleneckTriangles(-1) {
+}
+
+const char* BenchAnalyzer::modeName(Mode mode) {
+    switch (mode) {
+        case BASIC:    return "Básico";
+        case LIGHTING: return "Iluminação";
+        case TEXTURES: return "Texturas";
+        case COMBINED: return "Combinado";
+        default:       return "?";
+    }
+}
+
+bool BenchAnalyzer::addFile(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Erro: arquivo " << path << " não encontrado!" << std::endl;
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        std::cerr << "Erro: arquivo " << path << " vazio" << std::endl;
+        ::close(fd);
+        return false;
+    }
+
+    void* data = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        std::cerr << "Erro ao mapear " << path << std::endl;
+        return false;
+    }
+    // Leitura sequencial única: o kernel lê adiante e descarta as páginas já lidas
+    madvise(data, info.st_size, MADV_SEQUENTIAL);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    uint64_t rowsBefore = rows;
+    parse(static_cast<const char*>(data), info.st_size, path);
+    parseMs += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    munmap(data, info.st_size);
+
+    bytesRead += info.st_size;
+    files++;
+    return rows > rowsBefore;
+}
+
+void BenchAnalyzer::parse(const char* data, size_t size, const std::string& path) {
+    const char* end = data + size;
+    const char* line = data;
+
+    // Cabeçalho: as colunas são localizadas pelo nome (CSVs antigos têm menos colunas)
+    const char* headerEnd = static_cast<const char*>(std::memchr(line, '\n', end - line));
+    if (!headerEnd) {
+        headerEnd = end;
+    }
+    enum Column { FPS, CPU, GPU, TRIANGLES, LIGHTING_COLUMN, TEXTURES_COLUMN, PHASE, COLUMN_COUNT };
+    const char* const names[COLUMN_COUNT] = {"FPS", "CPU_Usage", "GPU_Usage", "Triangle_Count", "Has_Lighting",
+                                             "Has_Textures", "Phase"};
+    int columnIndex[COLUMN_COUNT];
+    std::fill(columnIndex, columnIndex + COLUMN_COUNT, -1);
+    int fieldCount = 0;
+    for (const char* field = line; field <= headerEnd; ++fieldCount) {
+        const char* fieldEnd = field;
+        while (fieldEnd < headerEnd && *fieldEnd != ',') ++fieldEnd;
+        const char* trimmed = fieldEnd;
+        if (trimmed > field && trimmed[-1] == '\r') --trimmed;
+        for (int c = 0; c < COLUMN_COUNT; ++c) {
+            if ((size_t)(trimmed - field) == std::strlen(names[c]) &&
+                std::memcmp(field, names[c], trimmed - field) == 0) {
+                columnIndex[c] = fieldCount;
+            }
+        }
+        field = fieldEnd + 1;
+    }
+    for (int c = 0; c < PHASE; ++c) {
+        if (columnIndex[c] < 0) {
+            std::cerr << "Erro: " << path << " não tem a coluna " << names[c] << std::endl;
+            return;
+        }
+    }
+
+    // Coluna de cada campo (-1 = ignorado); a linha só é percorrida até o último campo usado
+    std::vector<int> columnOf(fieldCount, -1);
+    int lastField = 0;
+    for (int c = 0; c < COLUMN_COUNT; ++c) {
+        if (columnIndex[c] >= 0) {
+            columnOf[columnIndex[c]] = c;
+            lastField = std::max(lastField, columnIndex[c]);
+        }
+    }
+
+    // Fases vêm em sequências longas: comparar com a anterior antes de procurar no mapa
+    std::string lastPhase;
+    BenchAggregate* lastPhaseAggregate = nullptr;
+
+    // Linhas: cada campo de interesse é guardado como [início, fim) e convertido só se necessário
+    const char* fieldBegin[COLUMN_COUNT];
+    const char* fieldEnd[COLUMN_COUNT];
+    for (line = headerEnd + 1; line < end;) {
+        const char* lineEnd = static_cast<const char*>(std::memchr(line, '\n', end - line));
+        if (!lineEnd) {
+            lineEnd = end;
+        }
+        const char* contentEnd = lineEnd > line && lineEnd[-1] == '\r' ? lineEnd - 1 : lineEnd;
+        if (contentEnd == line) {
+            line = lineEnd + 1;
+            continue;
+        }
+
+        std::fill(fieldBegin, fieldBegin + COLUMN_COUNT, nullptr);
+        int index = 0;
+        for (const char* field = line; field <= contentEnd && index <= lastField; ++index) {
+            const char* next = static_cast<const char*>(std::memchr(field, ',', contentEnd - field));
+            if (!next) {
+                next = contentEnd;
+            }
+            int column = columnOf[index];
+            if (column >= 0) {
+                fieldBegin[column] = field;
+                fieldEnd[column] = next;
+            }
+            field = next + 1;
+        }
+        line = lineEnd + 1;
+
+        double fps, cpu, gpu, triangles;
+        if (!fieldBegin[TRIANGLES] || !fieldBegin[TEXTURES_COLUMN] ||
+            !parseNumber(fieldBegin[FPS], fieldEnd[FPS], fps) ||
+            !parseNumber(fieldBegin[CPU], fieldEnd[CPU], cpu) ||
+            !parseNumber(fieldBegin[GPU], fieldEnd[GPU], gpu) ||
+            !parseNumber(fieldBegin[TRIANGLES], fieldEnd[TRIANGLES], triangles)) {
+            skippedRows++;
+            continue;
+        }
+
+        bool lit = parseBool(fieldBegin[LIGHTING_COLUMN], fieldEnd[LIGHTING_COLUMN]);
+        bool textured = parseBool(fieldBegin[TEXTURES_COLUMN], fieldEnd[TEXTURES_COLUMN]);
+        Mode mode = lit ? (textured ? COMBINED : LIGHTING) : (textured ? TEXTURES : BASIC);
+        int64_t count = (int64_t)triangles;
+
+        ModeStats& stats = modes[mode];
+        stats.total.add(count, fps, cpu, gpu);
+        stats.byCount[count].add(count, fps, cpu, gpu);
+        if (fps > 0.0) {
+            stats.frameTime.add((double)count, 1000.0 / fps);
+            if (count > 0) {
+                stats.logFps.add(std::log((double)count), std::log(fps));
+            }
+        }
+
+        if (fieldBegin[PHASE] && fieldEnd[PHASE] > fieldBegin[PHASE]) {
+            size_t length = fieldEnd[PHASE] - fieldBegin[PHASE];
+            if (!lastPhaseAggregate || lastPhase.size() != length ||
+                std::memcmp(lastPhase.data(), fieldBegin[PHASE], length) != 0) {
+                lastPhase.assign(fieldBegin[PHASE], length);
+                auto found = phases.find(lastPhase);
+                if (found == phases.end()) {
+                    phaseOrder.push_back(lastPhase);
+                    found = phases.emplace(lastPhase, BenchAggregate()).first;
+                }
+                lastPhaseAggregate = &found->second;
+            }
+            lastPhaseAggregate->add(count, fps, cpu, gpu);
+        }
+
+        if (rows == 0 || count < minTriangles) minTriangles = count;
+        if (rows == 0 || count > maxTriangles) maxTriangles = count;
+        if (gpu > 90.0 && (gpuBottleneckTriangles < 0 || count < gpuBottleneckTriangles)) {
+            gpuBottleneckTriangles = count;
+        }
+        rows++;
+    }
+}
+
+std::vector<std::string> BenchAnalyzer::statsLines() const {
+    std::vector<std::string> lines;
+    lines.push_back("ESTATÍSTICAS COMPARATIVAS");
+    lines.push_back("");
+    const char* const upperNames[] = {"BÁSICO", "ILUMINAÇÃO", "TEXTURAS", "COMBINADO"};
+    for (int m = 0; m < MODE_COUNT; ++m) {
+        const BenchAggregate& total = modes[m].total;
+        if (total.samples == 0) continue;
+        lines.push_back(std::string(upperNames[m]) + ":");
+        lines.push_back("  FPS Médio: " + fixed(total.fpsAverage(), 2));
+        lines.push_back("  FPS Mínimo: " + fixed(total.fpsMin, 2) + " (" + std::to_string(total.fpsMinTriangles) +
+                        " tri)");
+        lines.push_back("  FPS Máximo: " + fixed(total.fpsMax, 2) + " (" + std::to_string(total.fpsMaxTriangles) +
+                        " tri)");
+        lines.push_back("  CPU Médio: " + fixed(total.cpuAverage(), 1) + "%");
+        lines.push_back("  GPU Médio: " + fixed(total.gpuAverage(), 1) + "%");
+        lines.push_back("  GPU Máximo: " + fixed(total.gpuMax, 1) + "%");
+        lines.push_back("");
+    }
+
+    lines.push_back("ANÁLISE DE GARGALO:");
+    if (gpuBottleneckTriangles >= 0) {
+        lines.push_back("  GPU atinge 90%+ em: " + std::to_string(gpuBottleneckTriangles) + " triângulos");
+    }
+
+    // Impacto médio dos efeitos, como em analyze_extreme_data.py
+    auto impact = [this](Mode from, Mode to) {
+        double base = modes[from].total.fpsAverage();
+        return base > 0.0 ? (base - modes[to].total.fpsAverage()) / base * 100.0 : 0.0;
+    };
+    lines.push_back("");
+    if (modes[BASIC].total.samples && modes[LIGHTING].total.samples) {
+        lines.push_back("IMPACTO DA ILUMINAÇÃO: -" + fixed(impact(BASIC, LIGHTING), 1) + "%");
+    }
+    if (modes[LIGHTING].total.samples && modes[COMBINED].total.samples) {
+        lines.push_back("IMPACTO DAS TEXTURAS: -" + fixed(impact(LIGHTING, COMBINED), 1) + "%");
+    }
+    if (modes[BASIC].total.samples && modes[COMBINED].total.samples) {
+        lines.push_back("IMPACTO TOTAL (Ilum+Text): -" + fixed(impact(BASIC, COMBINED), 1) + "%");
+    }
+    return lines;
+}
+
+void BenchAnalyzer::writeChart(std::ostream& svg, double left, double top, double width, double height,
+                               const std::string& title, const std::string& yLabel, int metric) const {
+    // Área do gráfico dentro do painel (espaço para título, rótulos e marcas)
+    double plotLeft = left + 80.0, plotTop = top + 40.0;
+    double plotWidth = width - 100.0, plotHeight = height - 100.0;
+
+    // Eixos como no script: x até 105% da maior contagem, uso em 0-100%
+    double xMax = std::max(1.0, maxTriangles * 1.05);
+    double yMax = 100.0;
+    if (metric == METRIC_FPS) {
+        yMax = 0.0;
+        for (const ModeStats& mode : modes) {
+            for (const auto& entry : mode.byCount) {
+                yMax = std::max(yMax, entry.second.fpsAverage());
+            }
+        }
+        yMax = yMax > 0.0 ? yMax * 1.1 : 1.0;
+    }
+    auto toX = [&](double value) { return plotLeft + value / xMax * plotWidth; };
+    auto toY = [&](double value) { return plotTop + plotHeight - std::min(value, yMax) / yMax * plotHeight; };
+
+    svg << "<text x=\"" << left + width / 2 << "\" y=\"" << top + 22
+        << "\" text-anchor=\"middle\" font-size=\"18\" font-weight=\"bold\">" << escapeXml(title) << "</text>\n";
+
+    // Grade e marcas
+    double xStep = niceStep(xMax), yStep = niceStep(yMax);
+    svg << "<g stroke=\"#b0b0b0\" stroke-opacity=\"0.3\">";
+    for (double x = 0.0; x <= xMax; x += xStep) {
+        svg << "<line x1=\"" << toX(x) << "\" y1=\"" << plotTop << "\" x2=\"" << toX(x) << "\" y2=\""
+            << plotTop + plotHeight << "\"/>";
+    }
+    for (double y = 0.0; y <= yMax; y += yStep) {
+        svg << "<line x1=\"" << plotLeft << "\" y1=\"" << toY(y) << "\" x2=\"" << plotLeft + plotWidth << "\" y2=\""
+            << toY(y) << "\"/>";
+    }
+    svg << "</g>\n<g font-size=\"12\">";
+    for (double x = 0.0; x <= xMax; x += xStep) {
+        svg << "<text x=\"" << toX(x) << "\" y=\"" << plotTop + plotHeight + 18 << "\" text-anchor=\"middle\">"
+            << axisLabel(x) << "</text>";
+    }
+    for (double y = 0.0; y <= yMax; y += yStep) {
+        svg << "<text x=\"" << plotLeft - 8 << "\" y=\"" << toY(y) + 4 << "\" text-anchor=\"end\">"
+            << axisLabel(y) << "</text>";
+    }
+    svg << "</g>\n";
+    svg << "<rect x=\"" << plotLeft << "\" y=\"" << plotTop << "\" width=\"" << plotWidth << "\" height=\""
+        << plotHeight << "\" fill=\"none\" stroke=\"#000\"/>\n";
+    svg << "<text x=\"" << plotLeft + plotWidth / 2 << "\" y=\"" << plotTop + plotHeight + 45
+        << "\" text-anchor=\"middle\" font-size=\"14\">Número de Triângulos</text>\n";
+    svg << "<text transform=\"translate(" << left + 20 << "," << plotTop + plotHeight / 2
+        << ") rotate(-90)\" text-anchor=\"middle\" font-size=\"14\">" << escapeXml(yLabel) << "</text>\n";
+
+    // Uso de CPU/GPU: linha tracejada no máximo
+    if (metric != METRIC_FPS) {
+        svg << "<line x1=\"" << plotLeft << "\" y1=\"" << toY(100.0) << "\" x2=\"" << plotLeft + plotWidth
+            << "\" y2=\"" << toY(100.0) << "\" stroke=\"red\" stroke-opacity=\"0.5\" stroke-dasharray=\"6,4\"/>\n";
+    }
+
+    // Uma série por modo: média de cada contagem
+    int legendRow = 0;
+    for (int m = 0; m < MODE_COUNT; ++m) {
+        const std::map<int64_t, BenchAggregate>& byCount = modes[m].byCount;
+        if (byCount.empty()) continue;
+        double opacity = metric == METRIC_FPS ? 1.0 : 0.7;
+        svg << "<g opacity=\"" << opacity << "\"><polyline fill=\"none\" stroke-width=\"2\" stroke=\""
+            << MODE_COLORS[m] << "\" points=\"";
+        for (const auto& entry : byCount) {
+            svg << toX((double)entry.first) << "," << toY(metricValue(entry.second, metric)) << " ";
+        }
+        svg << "\"/>";
+        for (const auto& entry : byCount) {
+            appendMarker(svg, m, toX((double)entry.first), toY(metricValue(entry.second, metric)));
+        }
+        svg << "</g>\n";
+
+        // Legenda no canto superior direito
+        double legendX = plotLeft + plotWidth - 210, legendY = plotTop + 20 + legendRow * 20;
+        svg << "<line x1=\"" << legendX << "\" y1=\"" << legendY << "\" x2=\"" << legendX + 24 << "\" y2=\""
+            << legendY << "\" stroke=\"" << MODE_COLORS[m] << "\" stroke-width=\"2\"/>";
+        appendMarker(svg, m, legendX + 12, legendY);
+        svg << "<text x=\"" << legendX + 32 << "\" y=\"" << legendY + 4 << "\" font-size=\"12\">"
+            << escapeXml(metric == METRIC_FPS || m != COMBINED ? MODE_LABELS[m] : modeName(COMBINED))
+            << "</text>\n";
+        legendRow++;
+    }
+}
+
+bool BenchAnalyzer::writeSvg(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Erro ao criar " << path << std::endl;
+        return false;
+    }
+
+    // Mesma grade 2x2 de reports/extreme_performance_analysis.png
+    const double panelWidth = 800.0, panelHeight = 560.0, headerHeight = 80.0;
+    file << "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"" << 2 * panelWidth << "\" height=\""
+         << headerHeight + 2 * panelHeight << "\" font-family=\"DejaVu Sans, sans-serif\">\n";
+    file << "<rect width=\"100%\" height=\"100%\" fill=\"white\"/>\n";
+    file << "<text x=\"" << panelWidth << "\" y=\"32\" text-anchor=\"middle\" font-size=\"22\" "
+         << "font-weight=\"bold\">Teste Extremo de Performance OpenGL</text>\n";
+    file << "<text x=\"" << panelWidth << "\" y=\"60\" text-anchor=\"middle\" font-size=\"18\" font-weight=\"bold\">"
+         << groupThousands(minTriangles) << " - " << groupThousands(maxTriangles) << " Triângulos (" << rows
+         << " medições)</text>\n";
+
+    writeChart(file, 0.0, headerHeight, panelWidth, panelHeight, "Performance: FPS vs Carga",
+               "FPS (Frames por Segundo)", METRIC_FPS);
+    writeChart(file, panelWidth, headerHeight, panelWidth, panelHeight, "Utilização de CPU", "Uso de CPU (%)",
+               METRIC_CPU);
+    writeChart(file, 0.0, headerHeight + panelHeight, panelWidth, panelHeight, "Utilização de GPU",
+               "Uso de GPU (%)", METRIC_GPU);
+
+    // Painel de estatísticas em texto
+    std::vector<std::string> lines = statsLines();
+    double boxLeft = panelWidth + 80.0, boxTop = headerHeight + panelHeight + 30.0;
+    file << "<rect x=\"" << boxLeft << "\" y=\"" << boxTop << "\" width=\"" << panelWidth - 160.0
+         << "\" height=\"" << 24 + lines.size() * 15.5 << "\" rx=\"10\" fill=\"wheat\" fill-opacity=\"0.5\" "
+         << "stroke=\"#000\" stroke-opacity=\"0.5\"/>\n";
+    file << "<text font-family=\"DejaVu Sans Mono, monospace\" font-size=\"13\" xml:space=\"preserve\">";
+    for (size_t i = 0; i < lines.size(); ++i) {
+        file << "<tspan x=\"" << boxLeft + 14 << "\" y=\"" << boxTop + 22 + i * 15.5 << "\">"
+             << escapeXml(lines[i]) << "</tspan>";
+    }
+    file << "</text>\n</svg>\n";
+    return true;
+}
+
+bool BenchAnalyzer::writeMarkdown(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Erro ao criar " << path << std::endl;
+        return false;
+    }
+
+    file << "# Análise de Performance\n\n";
+    file << "- Arquivos: " << files << " (" << fixed(bytesRead / (1024.0 * 1024.0), 2) << " MB, lidos em "
+         << fixed(parseMs, 1) << " ms)\n";
+    file << "- Medições: " << rows;
+    if (skippedRows > 0) {
+        file << " (" << skippedRows << " linhas descartadas)";
+    }
+    file << "\n- Faixa de triângulos: " << groupThousands(minTriangles) << " - " << groupThousands(maxTriangles)
+         << "\n\n";
+
+    file << "## Modos\n\n";
+    file << "| Modo | Medições | FPS médio | FPS mínimo (triângulos) | FPS máximo (triângulos) | CPU médio | "
+         << "GPU médio | GPU máximo |\n";
+    file << "|---|---:|---:|---:|---:|---:|---:|---:|\n";
+    for (int m = 0; m < MODE_COUNT; ++m) {
+        const BenchAggregate& total = modes[m].total;
+        if (total.samples == 0) continue;
+        file << "| " << modeName((Mode)m) << " | " << total.samples << " | " << fixed(total.fpsAverage(), 2)
+             << " | " << fixed(total.fpsMin, 2) << " (" << total.fpsMinTriangles << ") | "
+             << fixed(total.fpsMax, 2) << " (" << total.fpsMaxTriangles << ") | " << fixed(total.cpuAverage(), 1)
+             << "% | " << fixed(total.gpuAverage(), 1) << "% | " << fixed(total.gpuMax, 1) << "% |\n";
+    }
+
+    // Tempo de frame = custo fixo + custo por triângulo; o expoente de FPS ∝ N^k
+    // mostra se o modo já escala linearmente (k perto de -1) ou ainda tem folga
+    file << "\n## Escala\n\n";
+    file << "| Modo | ms/frame fixo | ms por 1.000 triângulos | R² | FPS ∝ N^k |\n";
+    file << "|---|---:|---:|---:|---:|\n";
+    for (int m = 0; m < MODE_COUNT; ++m) {
+        const ModeStats& stats = modes[m];
+        if (stats.frameTime.n < 2.0) continue;
+        file << "| " << modeName((Mode)m) << " | " << fixed(stats.frameTime.intercept(), 3) << " | "
+             << fixed(stats.frameTime.slope() * 1000.0, 4) << " | " << fixed(stats.frameTime.r2(), 3) << " | "
+             << fixed(stats.logFps.slope(), 3) << " |\n";
+    }
+
+    file << "\n## Resumo\n\n```\n";
+    for (const std::string& line : statsLines()) {
+        file << line << "\n";
+    }
+    file << "```\n";
+
+    if (!phaseOrder.empty()) {
+        file << "\n## Fases\n\n";
+        file << "| Fase | Medições | FPS médio | FPS mínimo | CPU médio | GPU médio |\n";
+        file << "|---|---:|---:|---:|---:|---:|\n";
+        for (const std::string& phase : phaseOrder) {
+            const BenchAggregate& aggregate = phases.at(phase);
+            file << "| " << phase << " | " << aggregate.samples << " | " << fixed(aggregate.fpsAverage(), 2)
+                 << " | " << fixed(aggregate.fpsMin, 2) << " | " << fixed(aggregate.cpuAverage(), 1) << "% | "
+                 << fixed(aggregate.gpuAverage(), 1) << "% |\n";
+        }
+    }
+
+    file << "\n## Por contagem de triângulos\n";
+    for (int m = 0; m < MODE_COUNT; ++m) {
+        if (modes[m].byCount.empty()) continue;
+        file << "\n### " << modeName((Mode)m) << "\n\n";
+        file << "| Triângulos | Medições | FPS | CPU % | GPU % |\n";
+        file << "|---:|---:|---:|---:|---:|\n";
+        for (const auto& entry : modes[m].byCount) {
+            file << "| " << entry.first << " | " << entry.second.samples << " | "
+                 << fixed(entry.second.fpsAverage(), 2) << " | " << fixed(entry.second.cpuAverage(), 1) << " | "
+                 << fixed(entry.second.gpuAverage(), 1) << " |\n";
+        }
+    }
+    return true;
+}
+
+void BenchAnalyzer::printSummary() const {
+    std::cout << std::string(70, '=') << std::endl;
+    std::cout << "TABELA RESUMO" << std::endl;
+    std::cout << std::string(70, '=') << std::endl;
+    std::cout << "Medições: " << rows << " em " << files << " arquivo(s), "
+              << fixed(bytesRead / (1024.0 * 1024.0), 2) << " MB lidos em " << fixed(parseMs, 1) << " ms"
+              << std::endl;
+    std::cout << std::left << "\n" << std::setw(15) << "Modo" << std::setw(12) << "Triângulos" << std::setw(8)
+              << "FPS" << std::setw(8) << "CPU %" << std::setw(8) << "GPU %" << std::endl;
+    std::cout << std::string(70, '-') << std::endl;
+    for (int m = 0; m < MODE_COUNT; ++m) {
+        if (modes[m].byCount.empty()) continue;
+        std::cout << "\n" << modeName((Mode)m) << ":" << std::endl;
+        for (const auto& entry : modes[m].byCount) {
+            std::cout << "  " << std::setw(13) << "" << std::setw(12) << entry.first << std::setw(8)
+                      << fixed(entry.second.fpsAverage(), 2) << std::setw(8) << fixed(entry.second.cpuAverage(), 1)
+                      << std::setw(8) << fixed(entry.second.gpuAverage(), 1) << std::endl;
+        }
+    }
+    std::cout << std::right << "\n" << std::string(70, '=') << std::endl;
+}
@@ -0,0 +1,88 @@
+#ifndef BENCHANALYZER_H
+#define BENCHANALYZER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+// Agregados de um grupo de medições, acumulados linha a linha
+struct BenchAggregate {
+    uint64_t samples;
+    double fpsSum, fpsMin, fpsMax;
+    int64_t fpsMinTriangles, fpsMaxTriangles;
+    double cpuSum, gpuSum, gpuMax;
+
+    BenchAggregate();
+    void add(int64_t triangles, double fps, double cpu, double gpu);
+
+    double fpsAverage() const { return samples ? fpsSum / samples : 0.0; }
+    double cpuAverage() const { return samples ? cpuSum / samples : 0.0; }
+    double gpuAverage() const { return samples ? gpuSum / samples : 0.0; }
+};
+
+// Mínimos quadrados y = a + b*x com somas acumuladas em uma passada
+struct LinearFit {
+    double n, sx, sy, sxx, sxy, syy;
+
+    LinearFit();
+    void add(double x, double y);
+    double slope() const;
+    double intercept() const;
+    double r2() const;
+};
+
+// Leitura dos CSVs do PerformanceMonitor sem Python: cada arquivo é mapeado
+// (mmap) e percorrido uma vez, e só os agregados ficam em memória (por modo,
+// por modo e contagem, e por fase), qualquer que seja o tamanho da captura.
+// Gera os mesmos painéis de scripts/analyze_extreme_data.py em SVG e um
+// resumo em markdown com o ajuste de escala de cada modo.
+class BenchAnalyzer {
+public:
+    // Modos separados por Has_Lighting/Has_Textures, na ordem dos gráficos
+    enum Mode { BASIC, LIGHTING, TEXTURES, COMBINED, MODE_COUNT };
+
+private:
+    struct ModeStats {
+        BenchAggregate total;
+        std::map<int64_t, BenchAggregate> byCount;
+        LinearFit frameTime;   // ms por frame x triângulos
+        LinearFit logFps;      // log(FPS) x log(triângulos): FPS ∝ N^k
+    };
+
+    ModeStats modes[MODE_COUNT];
+    std::map<std::string, BenchAggregate> phases;
+    std::vector<std::string> phaseOrder;   // Fases na ordem em que aparecem
+    uint64_t rows;
+    uint64_t skippedRows;                  // Linhas sem as colunas necessárias ou com número inválido
+    int files;
+    size_t bytesRead;
+    double parseMs;
+    int64_t minTriangles, maxTriangles;
+    int64_t gpuBottleneckTriangles;        // Menor contagem com GPU acima de 90% (-1 se nenhuma)
+
+    void parse(const char* data, size_t size, const std::string& path);
+
+    // Linhas do painel de estatísticas (SVG e markdown)
+    std::vector<std::string> statsLines() const;
+    void writeChart(std::ostream& svg, double left, double top, double width, double height,
+                    const std::string& title, const std::string& yLabel, int metric) const;
+
+public:
+    BenchAnalyzer();
+
+    // Mapear e agregar um CSV; false se não abriu ou não tem as colunas básicas
+    bool addFile(const std::string& path);
+
+    bool writeSvg(const std::string& path) const;
+    bool writeMarkdown(const std::string& path) const;
+    // Tabela por modo e contagem no terminal
+    void printSummary() const;
+
+    static const char* modeName(Mode mode);
+    uint64_t getRowCount() const { return rows; }
+};
+
+#endif
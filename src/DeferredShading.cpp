@@ -0,0 +1,183 @@
+#include "DeferredShading.h"
+#include "Lighting.h"
+#include "GLStateCache.h"
+#include "GLProfiler.h"
+#include <iostream>
+#include <glm/gtc/type_ptr.hpp>
+
+DeferredShading::DeferredShading() : gBuffer(0), albedoTexture(0), normalTexture(0), positionTexture(0),
+                                     depthBuffer(0), emptyVAO(0), previousFramebuffer(0), width(0), height(0),
+                                     geometryVariants(nullptr), lightPassVariants(nullptr) {
+}
+
+DeferredShading::~DeferredShading() {
+    cleanup();
+}
+
+bool DeferredShading::initialize() {
+    geometryVariants = new ShaderVariantCache(geometryVertexSource, geometryFragmentSource, "G-buffer");
+    std::vector<ShaderVariantKey> geometryKeys = {
+        ShaderVariantKey(false, false),
+        ShaderVariantKey(false, true)
+    };
+    if (!geometryVariants->build(geometryKeys)) {
+        std::cerr << "Erro ao criar shaders da passada de geometria" << std::endl;
+        return false;
+    }
+
+    // A passada de luzes sempre lê as listas por cluster (LIGHTING+CLUSTERED)
+    lightPassVariants = new ShaderVariantCache(lightPassVertexSource, lightPassFragmentSource, "luzes adiadas");
+    if (!lightPassVariants->build({ShaderVariantKey(true, false, 0, false, true)})) {
+        std::cerr << "Erro ao criar shader da passada de luzes" << std::endl;
+        return false;
+    }
+
+    // Core profile exige um VAO ligado mesmo sem atributos
+    glGenVertexArrays(1, &emptyVAO);
+    glGenFramebuffers(1, &gBuffer);
+
+    std::cout << "Iluminação adiada inicializada" << std::endl;
+    return gBuffer != 0;
+}
+
+bool DeferredShading::resize(int newWidth, int newHeight) {
+    destroyTargets();
+    width = newWidth;
+    height = newHeight;
+
+    glGenTextures(1, &albedoTexture);
+    glGenTextures(1, &normalTexture);
+    glGenTextures(1, &positionTexture);
+
+    // Lidas com texelFetch, sem filtro nem mipmaps
+    struct Target { GLuint texture; GLint internalFormat; GLenum type; };
+    Target targets[] = {
+        {albedoTexture, GL_RGBA8, GL_UNSIGNED_BYTE},
+        {normalTexture, GL_RGBA16F, GL_FLOAT},
+        {positionTexture, GL_RGBA32F, GL_FLOAT}
+    };
+    for (const Target& target : targets) {
+        GLStateCache::bindTexture(GL_TEXTURE_2D, target.texture);
+        glTexImage2D(GL_TEXTURE_2D, 0, target.internalFormat, width, height, 0, GL_RGBA, target.type, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    }
+    GLStateCache::bindTexture(GL_TEXTURE_2D, 0);
+
+    glGenRenderbuffers(1, &depthBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, gBuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, albedoTexture, 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, normalTexture, 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT2, GL_TEXTURE_2D, positionTexture, 0);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+
+    GLenum drawBuffers[] = {GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1, GL_COLOR_ATTACHMENT2};
+    glDrawBuffers(3, drawBuffers);
+
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, previousFramebuffer);
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "G-buffer incompleto (status 0x" << std::hex << status << std::dec << ")" << std::endl;
+        destroyTargets();
+        return false;
+    }
+
+    std::cout << "G-buffer criado: " << width << "x" << height << " ("
+              << getMemoryBytes() / (1024 * 1024) << " MB)" << std::endl;
+    return true;
+}
+
+GLuint DeferredShading::beginGeometryPass(int viewportWidth, int viewportHeight, bool textureEnabled,
+                                          bool textureArray, AnimationPath animation,
+                                          bool pulledVertices) {
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousFramebuffer);
+    if ((viewportWidth != width || viewportHeight != height || !albedoTexture) &&
+        !resize(viewportWidth, viewportHeight)) {
+        return 0;
+    }
+
+    geometryKey = ShaderVariantKey(false, textureEnabled, 0, textureArray, false, false, animation, pulledVertices);
+    GLuint program = geometryVariants->get(geometryKey);
+    if (!program) {
+        return 0;
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, gBuffer);
+    // Alfa 0 marca os pixels sem geometria (descartados na passada de luzes)
+    GLfloat clearColor[4];
+    glGetFloatv(GL_COLOR_CLEAR_VALUE, clearColor);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    glClearColor(clearColor[0], clearColor[1], clearColor[2], clearColor[3]);
+
+    GLStateCache::useProgram(program);
+    if (geometryKey.texture) {
+        glUniform1i(glGetUniformLocation(program, "texture1"), 0);
+    }
+    return program;
+}
+
+void DeferredShading::lightingPass(Lighting* lighting, const glm::mat4& view, const glm::vec3& viewPos) {
+    glBindFramebuffer(GL_FRAMEBUFFER, previousFramebuffer);
+
+    GLuint program = lightPassVariants->get(ShaderVariantKey(true, false, 0, false, true));
+    if (!program || !albedoTexture) {
+        return;
+    }
+    GLStateCache::useProgram(program);
+
+    GLStateCache::bindTextureUnit(GL_TEXTURE4, GL_TEXTURE_2D, albedoTexture);
+    GLStateCache::bindTextureUnit(GL_TEXTURE5, GL_TEXTURE_2D, normalTexture);
+    GLStateCache::bindTextureUnit(GL_TEXTURE6, GL_TEXTURE_2D, positionTexture);
+    glUniform1i(glGetUniformLocation(program, "gAlbedo"), 4);
+    glUniform1i(glGetUniformLocation(program, "gNormal"), 5);
+    glUniform1i(glGetUniformLocation(program, "gPosition"), 6);
+
+    glUniformMatrix4fv(glGetUniformLocation(program, "view"), 1, GL_FALSE, glm::value_ptr(view));
+    glUniform3fv(glGetUniformLocation(program, "viewPos"), 1, glm::value_ptr(viewPos));
+    lighting->bindClusters(program);
+
+    // Cada pixel é iluminado uma vez, independente de quantos triângulos o cobriram
+    bool depthTest = GLStateCache::isDepthTestEnabled();
+    GLStateCache::setDepthTest(false);
+    GLStateCache::bindVertexArray(emptyVAO);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    GLStateCache::setDepthTest(depthTest);
+}
+
+void DeferredShading::destroyTargets() {
+    GLuint textures[] = {albedoTexture, normalTexture, positionTexture};
+    if (albedoTexture) {
+        GLStateCache::deleteTextures(3, textures);
+    }
+    if (depthBuffer) {
+        glDeleteRenderbuffers(1, &depthBuffer);
+    }
+    albedoTexture = normalTexture = positionTexture = 0;
+    depthBuffer = 0;
+    width = height = 0;
+}
+
+void DeferredShading::cleanup() {
+    destroyTargets();
+    if (gBuffer) {
+        glDeleteFramebuffers(1, &gBuffer);
+        gBuffer = 0;
+    }
+    if (emptyVAO) {
+        GLStateCache::deleteVertexArrays(1, &emptyVAO);
+        emptyVAO = 0;
+    }
+    if (geometryVariants) {
+        delete geometryVariants;
+        geometryVariants = nullptr;
+    }
+    if (lightPassVariants) {
+        delete lightPassVariants;
+        lightPassVariants = nullptr;
+    }
+}
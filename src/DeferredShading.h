@@ -0,0 +1,208 @@
+#ifndef DEFERREDSHADING_H
+#define DEFERREDSHADING_H
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <string>
+#include "ShaderVariants.h"
+
+class Lighting;
+
+// Caminho de iluminação adiada: a passada de geometria grava albedo, normal e
+// posição em um G-buffer e a passada de luzes avalia cada pixel visível uma
+// única vez (triângulo de tela cheia + listas de LightClusters). O custo das
+// luzes passa a depender da resolução, não do número de triângulos nem do overdraw.
+//
+// G-buffer (mesmo tamanho do viewport):
+//   unidade 4 - gAlbedo   (RGBA8):   cor do vértice * textura, alfa 1 onde há geometria
+//   unidade 5 - gNormal   (RGBA16F): normal em espaço de mundo
+//   unidade 6 - gPosition (RGBA32F): posição em espaço de mundo
+//   + renderbuffer de profundidade DEPTH24
+class DeferredShading {
+private:
+    GLuint gBuffer;
+    GLuint albedoTexture, normalTexture, positionTexture;
+    GLuint depthBuffer;
+    GLuint emptyVAO;            // O triângulo de tela cheia é gerado por gl_VertexID
+    GLint previousFramebuffer;  // Restaurado na passada de luzes
+    int width, height;
+
+    ShaderVariantCache* geometryVariants;
+    ShaderVariantCache* lightPassVariants;
+    ShaderVariantKey geometryKey;
+
+    // Passada de geometria (o #version, os #defines TEXTURE/TEXTURE_ARRAY, as
+    // entradas de vértice e a matriz "transform" são inseridos por ShaderVariantCache)
+    const char* geometryVertexSource = R"(
+        uniform mat4 view;
+        uniform mat4 projection;
+        #ifdef GPU_ANIMATION
+        // Matriz lida na GPU (TriangleAnimation); a transformação é rígida, então
+        // model = transform e a inversa transposta é a própria rotação
+        #define model transform
+        #define normalMatrix mat3(transform)
+        #else
+        uniform mat4 model;
+        uniform mat3 normalMatrix;   // transpose(inverse(model)), calculada na CPU
+        #endif
+
+        out vec3 VertexColor;
+        out vec3 FragPos;
+        out vec3 Normal;
+        #ifdef TEXTURE
+        uniform float uvScale;   // Repetições da textura por triângulo
+        out vec2 TexCoord;
+        #endif
+        #ifdef TEXTURE_ARRAY
+        uniform int textureLayers;
+        flat out float TexLayer;
+        #endif
+
+        invariant gl_Position;
+
+        void main() {
+            VertexColor = aColor;
+            FragPos = vec3(model * vec4(aPos, 1.0));
+            Normal = normalMatrix * aNormal;
+            #ifdef TEXTURE
+            TexCoord = aTexCoord * uvScale;
+            #endif
+            #ifdef TEXTURE_ARRAY
+            TexLayer = float((gl_VertexID / 3) % textureLayers);
+            #endif
+
+            gl_Position = projection * view * transform * vec4(aPos, 1.0);
+        }
+    )";
+
+    const char* geometryFragmentSource = R"(
+        in vec3 VertexColor;
+        in vec3 FragPos;
+        in vec3 Normal;
+        #ifdef TEXTURE
+        in vec2 TexCoord;
+        #ifdef TEXTURE_ARRAY
+        flat in float TexLayer;
+        uniform sampler2DArray texture1;
+        #else
+        uniform sampler2D texture1;
+        #endif
+        #endif
+
+        layout (location = 0) out vec4 gAlbedo;
+        layout (location = 1) out vec4 gNormal;
+        layout (location = 2) out vec4 gPosition;
+
+        void main() {
+            vec3 albedo = VertexColor;
+            #ifdef TEXTURE
+            #ifdef TEXTURE_ARRAY
+            albedo *= texture(texture1, vec3(TexCoord, TexLayer)).rgb;
+            #else
+            albedo *= texture(texture1, TexCoord).rgb;
+            #endif
+            #endif
+
+            gAlbedo = vec4(albedo, 1.0);
+            gNormal = vec4(normalize(Normal), 0.0);
+            gPosition = vec4(FragPos, 1.0);
+        }
+    )";
+
+    // Passada de luzes: triângulo que cobre a tela inteira
+    const char* lightPassVertexSource = R"(
+        void main() {
+            vec2 corner = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+            gl_Position = vec4(corner * 2.0 - 1.0, 0.0, 1.0);
+        }
+    )";
+
+    const char* lightPassFragmentSource = R"(
+        uniform sampler2D gAlbedo;
+        uniform sampler2D gNormal;
+        uniform sampler2D gPosition;
+        uniform mat4 view;
+        uniform vec3 viewPos;
+
+        uniform samplerBuffer clusterLights;     // (posição, raio), (cor * intensidade, 0)
+        uniform usamplerBuffer clusterGrid;      // (offset, contagem) por cluster
+        uniform usamplerBuffer clusterIndices;
+        uniform ivec3 clusterDims;
+        uniform vec2 clusterTileSize;
+        uniform vec2 clusterDepthParams;         // fatia = log(profundidade) * x + y
+
+        out vec4 FragColor;
+
+        // Mesma fórmula do caminho forward (Lighting.h)
+        vec3 calculateLight(vec3 lightPos, vec3 lightColor, float radius, vec3 normal, vec3 fragPos, vec3 viewDir) {
+            vec3 lightDir = normalize(lightPos - fragPos);
+            float distance = length(lightPos - fragPos);
+
+            float attenuation = 1.0 / (1.0 + 0.09 * distance + 0.032 * distance * distance);
+            float falloff = clamp(1.0 - pow(distance / radius, 4.0), 0.0, 1.0);
+            attenuation *= falloff * falloff;
+
+            float diff = max(dot(normal, lightDir), 0.0);
+            vec3 diffuse = diff * lightColor * attenuation;
+
+            vec3 reflectDir = reflect(-lightDir, normal);
+            float spec = pow(max(dot(viewDir, reflectDir), 0.0), 32);
+            vec3 specular = spec * lightColor * attenuation;
+
+            return diffuse + specular;
+        }
+
+        void main() {
+            ivec2 pixel = ivec2(gl_FragCoord.xy);
+            vec4 albedo = texelFetch(gAlbedo, pixel, 0);
+            if (albedo.a == 0.0) {
+                discard;   // Fundo: mantém a cor de limpeza do framebuffer de destino
+            }
+            vec3 normal = texelFetch(gNormal, pixel, 0).xyz;
+            vec3 fragPos = texelFetch(gPosition, pixel, 0).xyz;
+            vec3 viewDir = normalize(viewPos - fragPos);
+
+            vec3 result = vec3(0.6, 0.6, 0.7) * albedo.rgb;
+
+            float viewDepth = -(view * vec4(fragPos, 1.0)).z;
+            ivec2 tile = min(ivec2(gl_FragCoord.xy / clusterTileSize), clusterDims.xy - 1);
+            int slice = clamp(int(log(viewDepth) * clusterDepthParams.x + clusterDepthParams.y), 0, clusterDims.z - 1);
+            int cluster = (slice * clusterDims.y + tile.y) * clusterDims.x + tile.x;
+            uvec2 range = texelFetch(clusterGrid, cluster).xy;
+            for (uint i = 0u; i < range.y; i++) {
+                int light = int(texelFetch(clusterIndices, int(range.x + i)).r);
+                vec4 positionRadius = texelFetch(clusterLights, light * 2);
+                vec3 color = texelFetch(clusterLights, light * 2 + 1).rgb;
+                result += calculateLight(positionRadius.xyz, color, positionRadius.w, normal, fragPos, viewDir) * albedo.rgb;
+            }
+
+            FragColor = vec4(result, 1.0);
+        }
+    )";
+
+    // (Re)criar as texturas do G-buffer quando o viewport muda de tamanho
+    bool resize(int newWidth, int newHeight);
+    void destroyTargets();
+
+public:
+    DeferredShading();
+    ~DeferredShading();
+
+    bool initialize();
+
+    // Ligar o G-buffer e o programa de geometria da variante pedida; retorna o
+    // programa para o chamador configurar matrizes e desenhar
+    GLuint beginGeometryPass(int viewportWidth, int viewportHeight, bool textureEnabled, bool textureArray,
+                             AnimationPath animation = AnimationPath::CPU, bool pulledVertices = false);
+
+    // Acumular as luzes da cena no framebuffer que estava ligado antes da geometria
+    void lightingPass(Lighting* lighting, const glm::mat4& view, const glm::vec3& viewPos);
+    void cleanup();
+
+    std::string getGeometryVariantName() const { return geometryKey.name(); }
+    // Memória ocupada pelo G-buffer (cor + profundidade)
+    size_t getMemoryBytes() const { return (size_t)width * height * (4 + 8 + 16 + 4); }
+};
+
+#endif
@@ -0,0 +1,57 @@
+#include "DepthPrepass.h"
+#include "GLStateCache.h"
+#include <iostream>
+
+DepthPrepass::DepthPrepass() : variants(nullptr), previousDepthFunc(GL_LESS), previousDepthTest(true) {
+}
+
+DepthPrepass::~DepthPrepass() {
+    cleanup();
+}
+
+bool DepthPrepass::initialize() {
+    variants = new ShaderVariantCache(vertexShaderSource, fragmentShaderSource, "pré-passada de profundidade");
+    if (!variants->build({ShaderVariantKey()})) {
+        std::cerr << "Erro ao criar shader da pré-passada de profundidade" << std::endl;
+        return false;
+    }
+
+    std::cout << "Pré-passada de profundidade inicializada" << std::endl;
+    return true;
+}
+
+GLuint DepthPrepass::beginDepthPass(AnimationPath animation, bool pulledVertices) {
+    GLuint program = variants->get(ShaderVariantKey(false, false, 0, false, false, false, animation, pulledVertices));
+    if (!program) {
+        return 0;
+    }
+
+    previousDepthFunc = GLStateCache::getDepthFunc();
+    previousDepthTest = GLStateCache::isDepthTestEnabled();
+    GLStateCache::setDepthTest(true);
+    GLStateCache::depthFunc(GL_LESS);
+    GLStateCache::depthMask(true);
+    GLStateCache::colorMask(false);
+
+    GLStateCache::useProgram(program);
+    return program;
+}
+
+void DepthPrepass::beginShadingPass() {
+    GLStateCache::colorMask(true);
+    GLStateCache::depthFunc(GL_EQUAL);
+    GLStateCache::depthMask(false);
+}
+
+void DepthPrepass::end() {
+    GLStateCache::depthFunc(previousDepthFunc);
+    GLStateCache::depthMask(true);
+    GLStateCache::setDepthTest(previousDepthTest);
+}
+
+void DepthPrepass::cleanup() {
+    if (variants) {
+        delete variants;
+        variants = nullptr;
+    }
+}
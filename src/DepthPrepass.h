@@ -0,0 +1,53 @@
+#ifndef DEPTHPREPASS_H
+#define DEPTHPREPASS_H
+
+#include <GL/glew.h>
+#include "ShaderVariants.h"
+
+// Pré-passada só de profundidade: os triângulos são desenhados uma vez sem cor
+// (shader mínimo) e a passada de shading roda com GL_EQUAL e sem escrita de
+// profundidade, então cada pixel executa o fragment shader completo uma vez.
+//
+// Os vertex shaders das duas passadas declaram "invariant gl_Position" e usam a
+// mesma expressão, garantindo profundidades idênticas. Só reduz overdraw em
+// cenas com variação de profundidade: triângulos coplanares passam todos no GL_EQUAL.
+class DepthPrepass {
+private:
+    ShaderVariantCache* variants;
+    GLenum previousDepthFunc;
+    bool previousDepthTest;
+
+    const char* vertexShaderSource = R"(
+        uniform mat4 view;
+        uniform mat4 projection;   // aPos e "transform" vêm de ShaderVariantCache (VertexPulling, TriangleAnimation)
+
+        invariant gl_Position;
+
+        void main() {
+            gl_Position = projection * view * transform * vec4(aPos, 1.0);
+        }
+    )";
+
+    const char* fragmentShaderSource = R"(
+        void main() {
+        }
+    )";
+
+public:
+    DepthPrepass();
+    ~DepthPrepass();
+
+    bool initialize();
+
+    // Desligar escrita de cor e ativar o programa de profundidade; retorna o programa
+    GLuint beginDepthPass(AnimationPath animation = AnimationPath::CPU, bool pulledVertices = false);
+
+    // Religar a cor e testar GL_EQUAL contra a profundidade gravada
+    void beginShadingPass();
+
+    // Restaurar o teste e a escrita de profundidade anteriores
+    void end();
+    void cleanup();
+};
+
+#endif
@@ -0,0 +1,171 @@
+#include "DynamicResolution.h"
+#include "GLStateCache.h"
+#include "GLProfiler.h"
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+
+namespace {
+
+// Zona morta em torno do orçamento e passo da escala: mudanças pequenas não
+// compensam realocar os alvos do renderer (G-buffer, overdraw) que seguem o viewport
+const double DEAD_ZONE = 0.05;
+const double SCALE_STEP = 0.05;
+
+}
+
+DynamicResolution::DynamicResolution(double targetFrameMs)
+    : framebuffer(0), colorTexture(0), depthBuffer(0), targetWidth(0), targetHeight(0),
+      renderWidth(0), renderHeight(0), windowWidth(0), windowHeight(0),
+      timerQueries{}, queryPending{}, queryIndex(0),
+      targetFrameMs(targetFrameMs), scale(MAX_SCALE), gpuFrameMs(0.0), frameTimeErrorMs(0.0),
+      previousDrawFramebuffer(0), previousReadFramebuffer(0), previousViewport{} {
+}
+
+DynamicResolution::~DynamicResolution() {
+    cleanup();
+}
+
+bool DynamicResolution::initialize() {
+    glGenFramebuffers(1, &framebuffer);
+    glGenQueries(QUERY_COUNT, timerQueries);
+
+    std::cout << "Resolução dinâmica inicializada (orçamento " << targetFrameMs
+              << " ms, escala " << MIN_SCALE << "-" << MAX_SCALE << ")" << std::endl;
+    return framebuffer != 0;
+}
+
+bool DynamicResolution::resize(int newWidth, int newHeight) {
+    destroyTargets();
+    targetWidth = newWidth;
+    targetHeight = newHeight;
+
+    glGenTextures(1, &colorTexture);
+    GLStateCache::bindTexture(GL_TEXTURE_2D, colorTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, targetWidth, targetHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    GLStateCache::bindTexture(GL_TEXTURE_2D, 0);
+
+    glGenRenderbuffers(1, &depthBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, targetWidth, targetHeight);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colorTexture, 0);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, previousDrawFramebuffer);
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "Alvo de resolução dinâmica incompleto (status 0x" << std::hex << status << std::dec << ")" << std::endl;
+        destroyTargets();
+        return false;
+    }
+    return true;
+}
+
+void DynamicResolution::readTimerQueries() {
+    // Ler sem bloquear; a consulta mais recente pronta define a escala
+    for (int i = 0; i < QUERY_COUNT; ++i) {
+        int index = (queryIndex + i) % QUERY_COUNT;
+        if (!queryPending[index]) {
+            continue;
+        }
+        GLuint available = 0;
+        glGetQueryObjectuiv(timerQueries[index], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) {
+            continue;
+        }
+        GLuint64 elapsedNs = 0;
+        glGetQueryObjectui64v(timerQueries[index], GL_QUERY_RESULT, &elapsedNs);
+        queryPending[index] = false;
+        adjustScale(elapsedNs / 1e6);
+    }
+}
+
+void DynamicResolution::adjustScale(double measuredMs) {
+    gpuFrameMs = measuredMs;
+    frameTimeErrorMs = measuredMs - targetFrameMs;
+    if (measuredMs <= 0.0 || std::abs(frameTimeErrorMs) < targetFrameMs * DEAD_ZONE) {
+        return;
+    }
+
+    // Custo de fragmento proporcional à área: escala linear segue a raiz da razão
+    double desired = scale * std::sqrt(targetFrameMs / measuredMs);
+    // Metade do caminho por medição, em passos de SCALE_STEP (no mínimo um passo)
+    double next = std::round((scale + (desired - scale) * 0.5) / SCALE_STEP) * SCALE_STEP;
+    if (next == scale) {
+        next = scale + (desired > scale ? SCALE_STEP : -SCALE_STEP);
+    }
+    scale = std::min(MAX_SCALE, std::max(MIN_SCALE, next));
+}
+
+bool DynamicResolution::beginFrame(int newWindowWidth, int newWindowHeight) {
+    if (newWindowWidth <= 0 || newWindowHeight <= 0) {
+        return false;
+    }
+
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousDrawFramebuffer);
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previousReadFramebuffer);
+    GLStateCache::getViewport(previousViewport);
+
+    if ((newWindowWidth != targetWidth || newWindowHeight != targetHeight || !colorTexture) &&
+        !resize(newWindowWidth, newWindowHeight)) {
+        return false;
+    }
+
+    readTimerQueries();
+
+    windowWidth = newWindowWidth;
+    windowHeight = newWindowHeight;
+    renderWidth = std::max(1, (int)std::lround(windowWidth * scale));
+    renderHeight = std::max(1, (int)std::lround(windowHeight * scale));
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    GLStateCache::viewport(0, 0, renderWidth, renderHeight);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    // Uma consulta ainda pendente neste índice é descartada (GPU atrasada 3 frames)
+    glBeginQuery(GL_TIME_ELAPSED, timerQueries[queryIndex]);
+    return true;
+}
+
+void DynamicResolution::endFrame() {
+    glEndQuery(GL_TIME_ELAPSED);
+    queryPending[queryIndex] = true;
+    queryIndex = (queryIndex + 1) % QUERY_COUNT;
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, previousDrawFramebuffer);
+    glBlitFramebuffer(0, 0, renderWidth, renderHeight, 0, 0, windowWidth, windowHeight,
+                      GL_COLOR_BUFFER_BIT, GL_LINEAR);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, previousReadFramebuffer);
+    GLStateCache::viewport(previousViewport[0], previousViewport[1], previousViewport[2], previousViewport[3]);
+}
+
+void DynamicResolution::destroyTargets() {
+    if (colorTexture) {
+        GLStateCache::deleteTextures(1, &colorTexture);
+        colorTexture = 0;
+    }
+    if (depthBuffer) {
+        glDeleteRenderbuffers(1, &depthBuffer);
+        depthBuffer = 0;
+    }
+    targetWidth = targetHeight = 0;
+}
+
+void DynamicResolution::cleanup() {
+    destroyTargets();
+    if (framebuffer) {
+        glDeleteFramebuffers(1, &framebuffer);
+        framebuffer = 0;
+    }
+    if (timerQueries[0]) {
+        glDeleteQueries(QUERY_COUNT, timerQueries);
+        std::fill(timerQueries, timerQueries + QUERY_COUNT, 0);
+    }
+}
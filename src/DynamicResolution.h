@@ -0,0 +1,67 @@
+#ifndef DYNAMICRESOLUTION_H
+#define DYNAMICRESOLUTION_H
+
+#include <GL/glew.h>
+#include "FrameBudget.h"
+
+// Resolução dinâmica: a cena é desenhada em um alvo fora da tela cuja área
+// usada acompanha o tempo de GPU medido (GL_TIME_ELAPSED) e depois ampliada
+// para a janela com glBlitFramebuffer (filtro linear).
+//
+// O alvo é alocado no tamanho da janela e só a região renderWidth x renderHeight
+// é usada, então mudar a escala não realoca nada. O custo por pixel cai com a
+// área (escala ao quadrado); o custo por vértice não muda, e quando a escala
+// chega ao mínimo o erro de tempo que sobra é a carga que a resolução não absorve.
+class DynamicResolution {
+public:
+    static constexpr double DEFAULT_TARGET_MS = FrameBudget::DEFAULT_TARGET_MS;
+    static constexpr double MIN_SCALE = 0.25;
+    static constexpr double MAX_SCALE = 1.0;
+
+private:
+    static const int QUERY_COUNT = 3;    // Consultas em anel: o resultado é lido frames depois
+
+    GLuint framebuffer, colorTexture, depthBuffer;
+    int targetWidth, targetHeight;       // Alocação (tamanho da janela)
+    int renderWidth, renderHeight;       // Região usada no frame atual
+    int windowWidth, windowHeight;
+
+    GLuint timerQueries[QUERY_COUNT];
+    bool queryPending[QUERY_COUNT];
+    int queryIndex;
+
+    double targetFrameMs;
+    double scale;                        // Fator linear (largura e altura)
+    double gpuFrameMs;                   // Última medição lida
+    double frameTimeErrorMs;             // gpuFrameMs - targetFrameMs
+
+    GLint previousDrawFramebuffer, previousReadFramebuffer;
+    GLint previousViewport[4];
+
+    bool resize(int newWidth, int newHeight);
+    void destroyTargets();
+    void readTimerQueries();
+    void adjustScale(double measuredMs);
+
+public:
+    explicit DynamicResolution(double targetFrameMs = DEFAULT_TARGET_MS);
+    ~DynamicResolution();
+
+    bool initialize();
+
+    // Ligar o alvo reduzido, limpar com a cor atual e iniciar a medição de tempo
+    bool beginFrame(int newWindowWidth, int newWindowHeight);
+
+    // Encerrar a medição e ampliar o alvo para o framebuffer anterior
+    void endFrame();
+    void cleanup();
+
+    void setTargetFrameMs(double milliseconds) { targetFrameMs = milliseconds; }
+    double getTargetFrameMs() const { return targetFrameMs; }
+    double getScale() const { return scale; }
+    double getGPUFrameMs() const { return gpuFrameMs; }
+    double getFrameTimeErrorMs() const { return frameTimeErrorMs; }
+
+};
+
+#endif
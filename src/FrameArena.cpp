@@ -0,0 +1,67 @@
+#include "FrameArena.h"
+#include "StagingPool.h"
+#include <algorithm>
+
+const size_t FrameArena::MIN_BLOCK_SIZE;
+std::vector<FrameArena::Block> FrameArena::blocks;
+size_t FrameArena::offset = 0;
+size_t FrameArena::frameBytes = 0;
+uint64_t FrameArena::frameAllocations = 0;
+size_t FrameArena::lastFrameBytes = 0;
+uint64_t FrameArena::lastFrameAllocations = 0;
+size_t FrameArena::peakFrameBytes = 0;
+
+void FrameArena::addBlock(size_t minimumBytes) {
+    // Blocos crescentes: um frame grande não vira uma longa lista de blocos
+    size_t size = std::max(MIN_BLOCK_SIZE, minimumBytes);
+    if (!blocks.empty()) {
+        size = std::max(size, blocks.back().capacity * 2);
+    }
+    Block block;
+    block.memory = StagingPool::acquire(size, block.capacity);
+    blocks.push_back(block);
+    offset = 0;
+}
+
+void* FrameArena::allocate(size_t bytes, size_t alignment) {
+    size_t aligned = (offset + alignment - 1) & ~(alignment - 1);
+    if (blocks.empty() || aligned + bytes > blocks.back().capacity) {
+        // Blocos do pool começam alinhados a página
+        addBlock(bytes);
+        aligned = 0;
+    }
+
+    offset = aligned + bytes;
+    frameBytes += bytes;
+    frameAllocations++;
+    return static_cast<char*>(blocks.back().memory) + aligned;
+}
+
+void FrameArena::reset() {
+    lastFrameBytes = frameBytes;
+    lastFrameAllocations = frameAllocations;
+    peakFrameBytes = std::max(peakFrameBytes, frameBytes);
+
+    // O frame precisou de mais de um bloco: trocar todos por um que comporte o frame inteiro
+    if (blocks.size() > 1) {
+        size_t total = 0;
+        for (const Block& block : blocks) {
+            total += block.capacity;
+            StagingPool::release(block.memory, block.capacity);
+        }
+        blocks.clear();
+        addBlock(total);
+    }
+
+    offset = 0;
+    frameBytes = 0;
+    frameAllocations = 0;
+}
+
+size_t FrameArena::getCapacity() {
+    size_t total = 0;
+    for (const Block& block : blocks) {
+        total += block.capacity;
+    }
+    return total;
+}
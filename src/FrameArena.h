@@ -0,0 +1,56 @@
+#ifndef FRAMEARENA_H
+#define FRAMEARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+// Alocador linear para dados que só vivem dentro de um frame (ou de um passo
+// de teste): cada pedido só avança um ponteiro e nada é liberado um a um;
+// reset() no início do frame seguinte invalida tudo de uma vez.
+//
+// Os blocos vêm do StagingPool. Se um frame não coube no bloco atual, o reset
+// junta tudo em um único bloco do tamanho usado, então em regime a arena não
+// aloca nada. Só a thread de render aloca (workers do parallelFor podem usar a
+// memória que ela entregou). Sem destrutores: apenas tipos triviais.
+class FrameArena {
+public:
+    static const size_t MIN_BLOCK_SIZE = 2 * 1024 * 1024;
+
+private:
+    struct Block {
+        void* memory;
+        size_t capacity;
+    };
+
+    static std::vector<Block> blocks;   // O último é o bloco corrente
+    static size_t offset;               // Posição livre no bloco corrente
+    static size_t frameBytes;
+    static uint64_t frameAllocations;
+    static size_t lastFrameBytes;
+    static uint64_t lastFrameAllocations;
+    static size_t peakFrameBytes;
+
+    static void addBlock(size_t minimumBytes);
+
+public:
+    static void* allocate(size_t bytes, size_t alignment = 16);
+
+    template <typename T>
+    static T* allocateArray(size_t count) {
+        static_assert(std::is_trivially_destructible<T>::value, "FrameArena não chama destrutores");
+        return static_cast<T*>(allocate(count * sizeof(T), alignof(T) > 16 ? alignof(T) : 16));
+    }
+
+    // Fechar o frame: tudo que foi alocado desde o reset anterior deixa de valer
+    static void reset();
+
+    // Medições do último frame fechado
+    static uint64_t getLastFrameAllocations() { return lastFrameAllocations; }
+    static size_t getLastFrameBytes() { return lastFrameBytes; }
+    static size_t getPeakFrameBytes() { return peakFrameBytes; }
+    static size_t getCapacity();
+};
+
+#endif
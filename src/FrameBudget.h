@@ -0,0 +1,28 @@
+#ifndef FRAMEBUDGET_H
+#define FRAMEBUDGET_H
+
+#include <cstdlib>
+#include <iostream>
+
+// Orçamento de tempo de frame compartilhado pelos controles guiados por tempo
+// (ShadingGovernor e DynamicResolution). GLPERF_TARGET_FRAME_MS define o valor.
+class FrameBudget {
+public:
+    static constexpr double DEFAULT_TARGET_MS = 16.6;
+
+    // GLPERF_TARGET_FRAME_MS em ms; ausente ou inválido usa DEFAULT_TARGET_MS
+    static double requestedTargetMs() {
+        const char* env = std::getenv("GLPERF_TARGET_FRAME_MS");
+        if (env) {
+            double value = std::atof(env);
+            if (value > 0.0) {
+                return value;
+            }
+            std::cerr << "GLPERF_TARGET_FRAME_MS inválido (" << env << "), usando "
+                      << DEFAULT_TARGET_MS << " ms" << std::endl;
+        }
+        return DEFAULT_TARGET_MS;
+    }
+};
+
+#endif
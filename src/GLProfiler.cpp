@@ -0,0 +1,66 @@
+#include "GLProfiler.h"
+
+uint64_t GLProfiler::calls[CALL_COUNT];
+uint64_t GLProfiler::bytes[CALL_COUNT];
+uint64_t GLProfiler::nanoseconds[CALL_COUNT];
+uint64_t GLProfiler::frames = 0;
+
+bool GLProfiler::isEnabled() {
+#ifdef GL_PROFILER_ENABLED
+    return true;
+#else
+    return false;
+#endif
+}
+
+const char* GLProfiler::callName(Call call) {
+    static const char* const names[CALL_COUNT] = {
+        "glDrawArrays", "glDispatchCompute", "glMemoryBarrier", "glClear", "glBlitFramebuffer", "glReadPixels",
+        "glBufferData", "glBufferSubData", "glTexImage2D", "glTexSubImage2D", "glTexImage3D", "glTexSubImage3D",
+        "glCompressedTexImage2D", "glTexBuffer", "glMapBufferRange", "glUnmapBuffer",
+        "glUniform1i", "glUniform1ui", "glUniform1f", "glUniform2f", "glUniform3i", "glUniform3fv", "glUniformMatrix3fv",
+        "glUniformMatrix4fv",
+        "glGetUniformLocation", "glGetIntegerv", "glGetFloatv", "glGetQueryObjectuiv", "glGetQueryObjectui64v",
+        "glBeginQuery", "glEndQuery", "glFenceSync", "glClientWaitSync", "glDeleteSync",
+        "glUseProgram", "glBindVertexArray", "glBindBuffer", "glBindBufferRange", "glBindBufferBase", "glBindTexture",
+        "glActiveTexture", "glBindFramebuffer", "glEnable", "glDisable", "glIsEnabled", "glBlendFuncSeparate",
+        "glDepthFunc", "glDepthMask", "glColorMask", "glViewport", "glClearColor"
+    };
+    return call >= 0 && call < CALL_COUNT ? names[call] : "?";
+}
+
+GLProfiler::Totals GLProfiler::getTotals() {
+    Totals totals = {0, 0, 0};
+    for (int i = 0; i < CALL_COUNT; ++i) {
+        totals.calls += calls[i];
+        totals.bytes += bytes[i];
+        totals.nanoseconds += nanoseconds[i];
+    }
+    return totals;
+}
+
+uint64_t GLProfiler::imageBytes(GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type) {
+    uint64_t components;
+    switch (format) {
+        case GL_RED:
+        case GL_RED_INTEGER:
+        case GL_DEPTH_COMPONENT: components = 1; break;
+        case GL_RG:
+        case GL_RG_INTEGER:      components = 2; break;
+        case GL_RGB:
+        case GL_BGR:             components = 3; break;
+        default:                 components = 4; break;
+    }
+
+    uint64_t componentBytes;
+    switch (type) {
+        case GL_UNSIGNED_BYTE:
+        case GL_BYTE:           componentBytes = 1; break;
+        case GL_UNSIGNED_SHORT:
+        case GL_SHORT:
+        case GL_HALF_FLOAT:     componentBytes = 2; break;
+        default:                componentBytes = 4; break;
+    }
+
+    return (uint64_t)width * height * depth * components * componentBytes;
+}
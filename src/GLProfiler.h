@@ -0,0 +1,296 @@
+#ifndef GLPROFILER_H
+#define GLPROFILER_H
+
+#include <GL/glew.h>
+#include <chrono>
+#include <cstdint>
+
+// Interceptação das chamadas GL usadas nos frames: conta chamadas por função,
+// soma os bytes enviados ao driver (buffers, texturas e uniforms) e o tempo de
+// parede dentro de cada chamada. Ligado em tempo de compilação:
+//
+//     cmake -DENABLE_GL_PROFILER=ON ..
+//
+// Desligado, este header só inclui o GLEW e não há custo nenhum. Ligado, cada
+// .cpp que o inclui passa a chamar os invólucros abaixo no lugar das funções
+// GL (os nomes viram macros). Criação de shaders, glGen* e glDelete* ficam de
+// fora: só acontecem na inicialização (a exceção é glDeleteSync, chamado a cada
+// frame pelo streaming de texturas). Todas as chamadas GL vêm da thread
+// principal, então os contadores não são atômicos.
+class GLProfiler {
+public:
+    enum Call {
+        DrawArrays, DispatchCompute, MemoryBarrier, Clear, BlitFramebuffer, ReadPixels,
+        BufferData, BufferSubData, TexImage2D, TexSubImage2D, TexImage3D, TexSubImage3D,
+        CompressedTexImage2D, TexBuffer, MapBufferRange, UnmapBuffer,
+        Uniform1i, Uniform1ui, Uniform1f, Uniform2f, Uniform3i, Uniform3fv, UniformMatrix3fv, UniformMatrix4fv,
+        GetUniformLocation, GetIntegerv, GetFloatv, GetQueryObjectuiv, GetQueryObjectui64v,
+        BeginQuery, EndQuery, FenceSync, ClientWaitSync, DeleteSync,
+        UseProgram, BindVertexArray, BindBuffer, BindBufferRange, BindBufferBase, BindTexture, ActiveTexture,
+        BindFramebuffer, Enable, Disable, IsEnabled, BlendFuncSeparate, DepthFunc, DepthMask, ColorMask, Viewport,
+        ClearColor,
+        CALL_COUNT
+    };
+
+    // Totais desde o início (os consumidores calculam diferenças)
+    struct Totals {
+        uint64_t calls;
+        uint64_t bytes;
+        uint64_t nanoseconds;
+    };
+
+private:
+    static uint64_t calls[CALL_COUNT];
+    static uint64_t bytes[CALL_COUNT];
+    static uint64_t nanoseconds[CALL_COUNT];
+    static uint64_t frames;
+
+public:
+    // Mede uma chamada do construtor ao destrutor
+    class Scope {
+    private:
+        Call call;
+        std::chrono::steady_clock::time_point start;
+
+    public:
+        Scope(Call call, uint64_t uploadedBytes) : call(call), start(std::chrono::steady_clock::now()) {
+            calls[call]++;
+            bytes[call] += uploadedBytes;
+        }
+        ~Scope() {
+            nanoseconds[call] += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count();
+        }
+    };
+
+    // true se o executável foi compilado com ENABLE_GL_PROFILER
+    static bool isEnabled();
+
+    static const char* callName(Call call);
+    static uint64_t getCalls(Call call) { return calls[call]; }
+    static uint64_t getBytes(Call call) { return bytes[call]; }
+    static uint64_t getNanoseconds(Call call) { return nanoseconds[call]; }
+    static Totals getTotals();
+
+    // Chamado uma vez por frame (PerformanceMonitor::update)
+    static void endFrame() { frames++; }
+    static uint64_t getFrames() { return frames; }
+
+    // Tamanho de uma imagem width x height x depth no formato/tipo dados
+    static uint64_t imageBytes(GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type);
+};
+
+#ifdef GL_PROFILER_ENABLED
+
+// Os invólucros chamam as funções GL originais: as macros só são redefinidas no fim
+#define GLPERF_WRAP(name, call, bytes, params, args) \
+    inline void glperf##name params { GLProfiler::Scope scope(GLProfiler::call, bytes); gl##name args; }
+#define GLPERF_WRAP_RETURN(type, name, call, params, args) \
+    inline type glperf##name params { GLProfiler::Scope scope(GLProfiler::call, 0); return gl##name args; }
+
+GLPERF_WRAP(DrawArrays, DrawArrays, 0, (GLenum mode, GLint first, GLsizei count), (mode, first, count))
+GLPERF_WRAP(DispatchCompute, DispatchCompute, 0, (GLuint groupsX, GLuint groupsY, GLuint groupsZ),
+            (groupsX, groupsY, groupsZ))
+GLPERF_WRAP(MemoryBarrier, MemoryBarrier, 0, (GLbitfield barriers), (barriers))
+GLPERF_WRAP(Clear, Clear, 0, (GLbitfield mask), (mask))
+GLPERF_WRAP(BlitFramebuffer, BlitFramebuffer, 0,
+            (GLint sx0, GLint sy0, GLint sx1, GLint sy1, GLint dx0, GLint dy0, GLint dx1, GLint dy1,
+             GLbitfield mask, GLenum filter),
+            (sx0, sy0, sx1, sy1, dx0, dy0, dx1, dy1, mask, filter))
+GLPERF_WRAP(ReadPixels, ReadPixels, 0,
+            (GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void* pixels),
+            (x, y, width, height, format, type, pixels))
+
+GLPERF_WRAP(BufferData, BufferData, data ? (uint64_t)size : 0,
+            (GLenum target, GLsizeiptr size, const void* data, GLenum usage), (target, size, data, usage))
+GLPERF_WRAP(BufferSubData, BufferSubData, (uint64_t)size,
+            (GLenum target, GLintptr offset, GLsizeiptr size, const void* data), (target, offset, size, data))
+GLPERF_WRAP(TexImage2D, TexImage2D, pixels ? GLProfiler::imageBytes(width, height, 1, format, type) : 0,
+            (GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height, GLint border,
+             GLenum format, GLenum type, const void* pixels),
+            (target, level, internalFormat, width, height, border, format, type, pixels))
+GLPERF_WRAP(TexSubImage2D, TexSubImage2D, GLProfiler::imageBytes(width, height, 1, format, type),
+            (GLenum target, GLint level, GLint x, GLint y, GLsizei width, GLsizei height,
+             GLenum format, GLenum type, const void* pixels),
+            (target, level, x, y, width, height, format, type, pixels))
+GLPERF_WRAP(TexImage3D, TexImage3D, pixels ? GLProfiler::imageBytes(width, height, depth, format, type) : 0,
+            (GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height, GLsizei depth,
+             GLint border, GLenum format, GLenum type, const void* pixels),
+            (target, level, internalFormat, width, height, depth, border, format, type, pixels))
+GLPERF_WRAP(TexSubImage3D, TexSubImage3D, GLProfiler::imageBytes(width, height, depth, format, type),
+            (GLenum target, GLint level, GLint x, GLint y, GLint z, GLsizei width, GLsizei height, GLsizei depth,
+             GLenum format, GLenum type, const void* pixels),
+            (target, level, x, y, z, width, height, depth, format, type, pixels))
+GLPERF_WRAP(CompressedTexImage2D, CompressedTexImage2D, (uint64_t)imageSize,
+            (GLenum target, GLint level, GLenum internalFormat, GLsizei width, GLsizei height, GLint border,
+             GLsizei imageSize, const void* data),
+            (target, level, internalFormat, width, height, border, imageSize, data))
+GLPERF_WRAP(TexBuffer, TexBuffer, 0, (GLenum target, GLenum internalFormat, GLuint buffer),
+            (target, internalFormat, buffer))
+GLPERF_WRAP_RETURN(void*, MapBufferRange, MapBufferRange,
+                   (GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access),
+                   (target, offset, length, access))
+GLPERF_WRAP_RETURN(GLboolean, UnmapBuffer, UnmapBuffer, (GLenum target), (target))
+
+GLPERF_WRAP(Uniform1i, Uniform1i, sizeof(GLint), (GLint location, GLint v0), (location, v0))
+GLPERF_WRAP(Uniform1ui, Uniform1ui, sizeof(GLuint), (GLint location, GLuint v0), (location, v0))
+GLPERF_WRAP(Uniform1f, Uniform1f, sizeof(GLfloat), (GLint location, GLfloat v0), (location, v0))
+GLPERF_WRAP(Uniform2f, Uniform2f, 2 * sizeof(GLfloat), (GLint location, GLfloat v0, GLfloat v1), (location, v0, v1))
+GLPERF_WRAP(Uniform3i, Uniform3i, 3 * sizeof(GLint), (GLint location, GLint v0, GLint v1, GLint v2),
+            (location, v0, v1, v2))
+GLPERF_WRAP(Uniform3fv, Uniform3fv, (uint64_t)count * 3 * sizeof(GLfloat),
+            (GLint location, GLsizei count, const GLfloat* value), (location, count, value))
+GLPERF_WRAP(UniformMatrix3fv, UniformMatrix3fv, (uint64_t)count * 9 * sizeof(GLfloat),
+            (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value),
+            (location, count, transpose, value))
+GLPERF_WRAP(UniformMatrix4fv, UniformMatrix4fv, (uint64_t)count * 16 * sizeof(GLfloat),
+            (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value),
+            (location, count, transpose, value))
+
+GLPERF_WRAP_RETURN(GLint, GetUniformLocation, GetUniformLocation, (GLuint program, const GLchar* name),
+                   (program, name))
+GLPERF_WRAP(GetIntegerv, GetIntegerv, 0, (GLenum name, GLint* data), (name, data))
+GLPERF_WRAP(GetFloatv, GetFloatv, 0, (GLenum name, GLfloat* data), (name, data))
+GLPERF_WRAP(GetQueryObjectuiv, GetQueryObjectuiv, 0, (GLuint id, GLenum name, GLuint* params), (id, name, params))
+GLPERF_WRAP(GetQueryObjectui64v, GetQueryObjectui64v, 0, (GLuint id, GLenum name, GLuint64* params),
+            (id, name, params))
+GLPERF_WRAP(BeginQuery, BeginQuery, 0, (GLenum target, GLuint id), (target, id))
+GLPERF_WRAP(EndQuery, EndQuery, 0, (GLenum target), (target))
+GLPERF_WRAP_RETURN(GLsync, FenceSync, FenceSync, (GLenum condition, GLbitfield flags), (condition, flags))
+GLPERF_WRAP_RETURN(GLenum, ClientWaitSync, ClientWaitSync, (GLsync sync, GLbitfield flags, GLuint64 timeout),
+                   (sync, flags, timeout))
+GLPERF_WRAP(DeleteSync, DeleteSync, 0, (GLsync sync), (sync))
+
+GLPERF_WRAP(UseProgram, UseProgram, 0, (GLuint program), (program))
+GLPERF_WRAP(BindVertexArray, BindVertexArray, 0, (GLuint array), (array))
+GLPERF_WRAP(BindBuffer, BindBuffer, 0, (GLenum target, GLuint buffer), (target, buffer))
+GLPERF_WRAP(BindBufferRange, BindBufferRange, 0,
+            (GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size),
+            (target, index, buffer, offset, size))
+GLPERF_WRAP(BindBufferBase, BindBufferBase, 0, (GLenum target, GLuint index, GLuint buffer),
+            (target, index, buffer))
+GLPERF_WRAP(BindTexture, BindTexture, 0, (GLenum target, GLuint texture), (target, texture))
+GLPERF_WRAP(ActiveTexture, ActiveTexture, 0, (GLenum unit), (unit))
+GLPERF_WRAP(BindFramebuffer, BindFramebuffer, 0, (GLenum target, GLuint framebuffer), (target, framebuffer))
+GLPERF_WRAP(Enable, Enable, 0, (GLenum capability), (capability))
+GLPERF_WRAP(Disable, Disable, 0, (GLenum capability), (capability))
+GLPERF_WRAP_RETURN(GLboolean, IsEnabled, IsEnabled, (GLenum capability), (capability))
+GLPERF_WRAP(BlendFuncSeparate, BlendFuncSeparate, 0,
+            (GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha), (srcRGB, dstRGB, srcAlpha, dstAlpha))
+GLPERF_WRAP(DepthFunc, DepthFunc, 0, (GLenum function), (function))
+GLPERF_WRAP(DepthMask, DepthMask, 0, (GLboolean flag), (flag))
+GLPERF_WRAP(ColorMask, ColorMask, 0, (GLboolean r, GLboolean g, GLboolean b, GLboolean a), (r, g, b, a))
+GLPERF_WRAP(Viewport, Viewport, 0, (GLint x, GLint y, GLsizei width, GLsizei height), (x, y, width, height))
+GLPERF_WRAP(ClearColor, ClearColor, 0, (GLfloat r, GLfloat g, GLfloat b, GLfloat a), (r, g, b, a))
+
+#undef GLPERF_WRAP
+#undef GLPERF_WRAP_RETURN
+
+// A partir daqui os nomes GL apontam para os invólucros (as funções do GLEW
+// também são macros, por isso o #undef antes)
+#undef glDrawArrays
+#define glDrawArrays glperfDrawArrays
+#undef glDispatchCompute
+#define glDispatchCompute glperfDispatchCompute
+#undef glMemoryBarrier
+#define glMemoryBarrier glperfMemoryBarrier
+#undef glClear
+#define glClear glperfClear
+#undef glBlitFramebuffer
+#define glBlitFramebuffer glperfBlitFramebuffer
+#undef glReadPixels
+#define glReadPixels glperfReadPixels
+#undef glBufferData
+#define glBufferData glperfBufferData
+#undef glBufferSubData
+#define glBufferSubData glperfBufferSubData
+#undef glTexImage2D
+#define glTexImage2D glperfTexImage2D
+#undef glTexSubImage2D
+#define glTexSubImage2D glperfTexSubImage2D
+#undef glTexImage3D
+#define glTexImage3D glperfTexImage3D
+#undef glTexSubImage3D
+#define glTexSubImage3D glperfTexSubImage3D
+#undef glCompressedTexImage2D
+#define glCompressedTexImage2D glperfCompressedTexImage2D
+#undef glTexBuffer
+#define glTexBuffer glperfTexBuffer
+#undef glMapBufferRange
+#define glMapBufferRange glperfMapBufferRange
+#undef glUnmapBuffer
+#define glUnmapBuffer glperfUnmapBuffer
+#undef glUniform1i
+#define glUniform1i glperfUniform1i
+#undef glUniform1ui
+#define glUniform1ui glperfUniform1ui
+#undef glUniform1f
+#define glUniform1f glperfUniform1f
+#undef glUniform2f
+#define glUniform2f glperfUniform2f
+#undef glUniform3i
+#define glUniform3i glperfUniform3i
+#undef glUniform3fv
+#define glUniform3fv glperfUniform3fv
+#undef glUniformMatrix3fv
+#define glUniformMatrix3fv glperfUniformMatrix3fv
+#undef glUniformMatrix4fv
+#define glUniformMatrix4fv glperfUniformMatrix4fv
+#undef glGetUniformLocation
+#define glGetUniformLocation glperfGetUniformLocation
+#undef glGetIntegerv
+#define glGetIntegerv glperfGetIntegerv
+#undef glGetFloatv
+#define glGetFloatv glperfGetFloatv
+#undef glGetQueryObjectuiv
+#define glGetQueryObjectuiv glperfGetQueryObjectuiv
+#undef glGetQueryObjectui64v
+#define glGetQueryObjectui64v glperfGetQueryObjectui64v
+#undef glBeginQuery
+#define glBeginQuery glperfBeginQuery
+#undef glEndQuery
+#define glEndQuery glperfEndQuery
+#undef glFenceSync
+#define glFenceSync glperfFenceSync
+#undef glClientWaitSync
+#define glClientWaitSync glperfClientWaitSync
+#undef glDeleteSync
+#define glDeleteSync glperfDeleteSync
+#undef glUseProgram
+#define glUseProgram glperfUseProgram
+#undef glBindVertexArray
+#define glBindVertexArray glperfBindVertexArray
+#undef glBindBuffer
+#define glBindBuffer glperfBindBuffer
+#undef glBindBufferRange
+#define glBindBufferRange glperfBindBufferRange
+#undef glBindBufferBase
+#define glBindBufferBase glperfBindBufferBase
+#undef glBindTexture
+#define glBindTexture glperfBindTexture
+#undef glActiveTexture
+#define glActiveTexture glperfActiveTexture
+#undef glBindFramebuffer
+#define glBindFramebuffer glperfBindFramebuffer
+#undef glEnable
+#define glEnable glperfEnable
+#undef glDisable
+#define glDisable glperfDisable
+#undef glIsEnabled
+#define glIsEnabled glperfIsEnabled
+#undef glBlendFuncSeparate
+#define glBlendFuncSeparate glperfBlendFuncSeparate
+#undef glDepthFunc
+#define glDepthFunc glperfDepthFunc
+#undef glDepthMask
+#define glDepthMask glperfDepthMask
+#undef glColorMask
+#define glColorMask glperfColorMask
+#undef glViewport
+#define glViewport glperfViewport
+#undef glClearColor
+#define glClearColor glperfClearColor
+
+#endif
+
+#endif
@@ -0,0 +1,273 @@
+#include "GLStateCache.h"
+#include "GLProfiler.h"
+
+namespace {
+
+// Valor ainda não observado: a primeira chamada sempre vai ao driver
+const GLuint UNKNOWN = 0xFFFFFFFFu;
+
+}
+
+GLuint GLStateCache::program = UNKNOWN;
+GLuint GLStateCache::vertexArray = UNKNOWN;
+GLuint GLStateCache::buffers[BUFFER_TARGETS] = {UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN};
+GLenum GLStateCache::activeUnit = UNKNOWN;
+GLuint GLStateCache::textures[MAX_TEXTURE_UNITS][TEXTURE_TARGETS];
+bool GLStateCache::textureKnown[MAX_TEXTURE_UNITS][TEXTURE_TARGETS];
+int GLStateCache::blendEnabled = -1;
+int GLStateCache::depthTestEnabled = -1;
+int GLStateCache::depthMaskEnabled = -1;
+GLenum GLStateCache::blendFuncs[4] = {UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN};
+GLenum GLStateCache::depthFunction = UNKNOWN;
+int GLStateCache::colorMaskEnabled = -1;
+GLint GLStateCache::viewportRect[4] = {0, 0, 0, 0};
+bool GLStateCache::viewportKnown = false;
+uint64_t GLStateCache::issued = 0;
+uint64_t GLStateCache::elided = 0;
+uint64_t GLStateCache::frames = 0;
+
+void GLStateCache::invalidate() {
+    program = UNKNOWN;
+    vertexArray = UNKNOWN;
+    for (int i = 0; i < BUFFER_TARGETS; ++i) {
+        buffers[i] = UNKNOWN;
+    }
+    activeUnit = UNKNOWN;
+    for (int unit = 0; unit < MAX_TEXTURE_UNITS; ++unit) {
+        for (int target = 0; target < TEXTURE_TARGETS; ++target) {
+            textureKnown[unit][target] = false;
+        }
+    }
+    blendEnabled = depthTestEnabled = depthMaskEnabled = colorMaskEnabled = -1;
+    for (int i = 0; i < 4; ++i) {
+        blendFuncs[i] = UNKNOWN;
+    }
+    depthFunction = UNKNOWN;
+    viewportKnown = false;
+}
+
+bool GLStateCache::skip(bool unchanged) {
+    if (unchanged) {
+        elided++;
+    } else {
+        issued++;
+    }
+    return unchanged;
+}
+
+int GLStateCache::textureTargetIndex(GLenum target) {
+    switch (target) {
+        case GL_TEXTURE_2D:       return 0;
+        case GL_TEXTURE_2D_ARRAY: return 1;
+        case GL_TEXTURE_BUFFER:   return 2;
+    }
+    return -1;
+}
+
+int GLStateCache::bufferTargetIndex(GLenum target) {
+    // GL_ELEMENT_ARRAY_BUFFER faz parte do VAO e não é guardado aqui
+    switch (target) {
+        case GL_ARRAY_BUFFER:        return 0;
+        case GL_TEXTURE_BUFFER:      return 1;
+        case GL_PIXEL_UNPACK_BUFFER: return 2;
+        case GL_PIXEL_PACK_BUFFER:   return 3;
+    }
+    return -1;
+}
+
+void GLStateCache::useProgram(GLuint newProgram) {
+    if (skip(program == newProgram)) return;
+    glUseProgram(newProgram);
+    program = newProgram;
+}
+
+void GLStateCache::bindVertexArray(GLuint newVertexArray) {
+    if (skip(vertexArray == newVertexArray)) return;
+    glBindVertexArray(newVertexArray);
+    vertexArray = newVertexArray;
+}
+
+void GLStateCache::bindBuffer(GLenum target, GLuint buffer) {
+    int index = bufferTargetIndex(target);
+    if (skip(index >= 0 && buffers[index] == buffer)) return;
+    glBindBuffer(target, buffer);
+    if (index >= 0) {
+        buffers[index] = buffer;
+    }
+}
+
+void GLStateCache::activeTexture(GLenum unit) {
+    if (skip(activeUnit == unit)) return;
+    glActiveTexture(unit);
+    activeUnit = unit;
+}
+
+void GLStateCache::bindTexture(GLenum target, GLuint texture) {
+    int unit = activeUnit == UNKNOWN ? -1 : (int)(activeUnit - GL_TEXTURE0);
+    int index = textureTargetIndex(target);
+    bool tracked = unit >= 0 && unit < MAX_TEXTURE_UNITS && index >= 0;
+    if (skip(tracked && textureKnown[unit][index] && textures[unit][index] == texture)) return;
+    glBindTexture(target, texture);
+    if (tracked) {
+        textures[unit][index] = texture;
+        textureKnown[unit][index] = true;
+    }
+}
+
+void GLStateCache::bindTextureUnit(GLenum unit, GLenum target, GLuint texture) {
+    int slot = (int)(unit - GL_TEXTURE0);
+    int index = textureTargetIndex(target);
+    if (slot >= 0 && slot < MAX_TEXTURE_UNITS && index >= 0 &&
+        textureKnown[slot][index] && textures[slot][index] == texture) {
+        // Já ligada: nem a troca de unidade é necessária
+        elided++;
+        return;
+    }
+    activeTexture(unit);
+    bindTexture(target, texture);
+}
+
+void GLStateCache::setCapability(GLenum capability, int& cached, bool enabled) {
+    if (skip(cached == (enabled ? 1 : 0))) return;
+    if (enabled) {
+        glEnable(capability);
+    } else {
+        glDisable(capability);
+    }
+    cached = enabled ? 1 : 0;
+}
+
+void GLStateCache::setBlend(bool enabled) {
+    setCapability(GL_BLEND, blendEnabled, enabled);
+}
+
+void GLStateCache::setDepthTest(bool enabled) {
+    setCapability(GL_DEPTH_TEST, depthTestEnabled, enabled);
+}
+
+void GLStateCache::blendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha) {
+    if (skip(blendFuncs[0] == srcRGB && blendFuncs[1] == dstRGB &&
+             blendFuncs[2] == srcAlpha && blendFuncs[3] == dstAlpha)) return;
+    glBlendFuncSeparate(srcRGB, dstRGB, srcAlpha, dstAlpha);
+    blendFuncs[0] = srcRGB;
+    blendFuncs[1] = dstRGB;
+    blendFuncs[2] = srcAlpha;
+    blendFuncs[3] = dstAlpha;
+}
+
+void GLStateCache::depthFunc(GLenum function) {
+    if (skip(depthFunction == function)) return;
+    glDepthFunc(function);
+    depthFunction = function;
+}
+
+void GLStateCache::depthMask(bool enabled) {
+    if (skip(depthMaskEnabled == (enabled ? 1 : 0))) return;
+    glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+    depthMaskEnabled = enabled ? 1 : 0;
+}
+
+void GLStateCache::colorMask(bool enabled) {
+    if (skip(colorMaskEnabled == (enabled ? 1 : 0))) return;
+    GLboolean value = enabled ? GL_TRUE : GL_FALSE;
+    glColorMask(value, value, value, value);
+    colorMaskEnabled = enabled ? 1 : 0;
+}
+
+void GLStateCache::viewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+    if (skip(viewportKnown && viewportRect[0] == x && viewportRect[1] == y &&
+             viewportRect[2] == width && viewportRect[3] == height)) return;
+    glViewport(x, y, width, height);
+    viewportRect[0] = x;
+    viewportRect[1] = y;
+    viewportRect[2] = width;
+    viewportRect[3] = height;
+    viewportKnown = true;
+}
+
+bool GLStateCache::isBlendEnabled() {
+    if (blendEnabled < 0) {
+        blendEnabled = glIsEnabled(GL_BLEND) ? 1 : 0;
+    }
+    return blendEnabled == 1;
+}
+
+bool GLStateCache::isDepthTestEnabled() {
+    if (depthTestEnabled < 0) {
+        depthTestEnabled = glIsEnabled(GL_DEPTH_TEST) ? 1 : 0;
+    }
+    return depthTestEnabled == 1;
+}
+
+GLenum GLStateCache::getDepthFunc() {
+    if (depthFunction == UNKNOWN) {
+        GLint value = GL_LESS;
+        glGetIntegerv(GL_DEPTH_FUNC, &value);
+        depthFunction = value;
+    }
+    return depthFunction;
+}
+
+void GLStateCache::getBlendFunc(GLenum funcs[4]) {
+    if (blendFuncs[0] == UNKNOWN) {
+        const GLenum names[4] = {GL_BLEND_SRC_RGB, GL_BLEND_DST_RGB, GL_BLEND_SRC_ALPHA, GL_BLEND_DST_ALPHA};
+        for (int i = 0; i < 4; ++i) {
+            GLint value = 0;
+            glGetIntegerv(names[i], &value);
+            blendFuncs[i] = value;
+        }
+    }
+    for (int i = 0; i < 4; ++i) {
+        funcs[i] = blendFuncs[i];
+    }
+}
+
+void GLStateCache::getViewport(GLint rect[4]) {
+    if (!viewportKnown) {
+        glGetIntegerv(GL_VIEWPORT, viewportRect);
+        viewportKnown = true;
+    }
+    for (int i = 0; i < 4; ++i) {
+        rect[i] = viewportRect[i];
+    }
+}
+
+void GLStateCache::deleteProgram(GLuint oldProgram) {
+    if (program == oldProgram) {
+        program = UNKNOWN;
+    }
+    glDeleteProgram(oldProgram);
+}
+
+void GLStateCache::deleteVertexArrays(GLsizei count, const GLuint* names) {
+    for (GLsizei i = 0; i < count; ++i) {
+        if (vertexArray == names[i]) {
+            vertexArray = UNKNOWN;
+        }
+    }
+    glDeleteVertexArrays(count, names);
+}
+
+void GLStateCache::deleteBuffers(GLsizei count, const GLuint* names) {
+    for (GLsizei i = 0; i < count; ++i) {
+        for (int target = 0; target < BUFFER_TARGETS; ++target) {
+            if (buffers[target] == names[i]) {
+                buffers[target] = UNKNOWN;
+            }
+        }
+    }
+    glDeleteBuffers(count, names);
+}
+
+void GLStateCache::deleteTextures(GLsizei count, const GLuint* names) {
+    for (GLsizei i = 0; i < count; ++i) {
+        for (int unit = 0; unit < MAX_TEXTURE_UNITS; ++unit) {
+            for (int target = 0; target < TEXTURE_TARGETS; ++target) {
+                if (textureKnown[unit][target] && textures[unit][target] == names[i]) {
+                    textureKnown[unit][target] = false;
+                }
+            }
+        }
+    }
+    glDeleteTextures(count, names);
+}
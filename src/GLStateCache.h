@@ -0,0 +1,87 @@
+#ifndef GLSTATECACHE_H
+#define GLSTATECACHE_H
+
+#include <GL/glew.h>
+#include <cstdint>
+
+// Cópia na CPU do estado GL mais trocado (programa, VAO, buffers, texturas por
+// unidade, blend, profundidade, máscara de cor e viewport). Cada função só
+// chama o driver quando o valor muda e conta as chamadas emitidas e evitadas.
+//
+// Todo o código que mexe nesse estado precisa passar por aqui: uma chamada
+// direta ao GL deixa a cópia desatualizada. Objetos apagados com glDelete*
+// devem passar pelas funções delete*, porque o driver reaproveita os nomes e
+// um bind de um objeto novo com o nome antigo seria evitado por engano.
+// Um único contexto por processo (como em todos os executáveis do projeto).
+class GLStateCache {
+private:
+    static const int MAX_TEXTURE_UNITS = 16;
+    static const int TEXTURE_TARGETS = 3;   // 2D, 2D_ARRAY, BUFFER
+    static const int BUFFER_TARGETS = 4;    // ARRAY, TEXTURE, PIXEL_UNPACK, PIXEL_PACK
+
+    static GLuint program;
+    static GLuint vertexArray;
+    static GLuint buffers[BUFFER_TARGETS];
+    static GLenum activeUnit;
+    static GLuint textures[MAX_TEXTURE_UNITS][TEXTURE_TARGETS];
+    static bool textureKnown[MAX_TEXTURE_UNITS][TEXTURE_TARGETS];   // Zerado = desconhecido
+    static int blendEnabled, depthTestEnabled, depthMaskEnabled;   // -1 = desconhecido
+    static GLenum blendFuncs[4];            // src/dst RGB, src/dst alfa
+    static GLenum depthFunction;
+    static int colorMaskEnabled;
+    static GLint viewportRect[4];
+    static bool viewportKnown;
+
+    static uint64_t issued, elided;
+    static uint64_t frames;
+
+    static int textureTargetIndex(GLenum target);
+    static int bufferTargetIndex(GLenum target);
+    static bool skip(bool unchanged);
+    static void setCapability(GLenum capability, int& cached, bool enabled);
+
+public:
+    // Esquecer tudo (próxima chamada de cada estado vai ao driver)
+    static void invalidate();
+
+    static void useProgram(GLuint newProgram);
+    static void bindVertexArray(GLuint newVertexArray);
+    static void bindBuffer(GLenum target, GLuint buffer);
+    // Trocar a unidade ativa (GL_TEXTURE0 + i)
+    static void activeTexture(GLenum unit);
+    // Ligar na unidade ativa
+    static void bindTexture(GLenum target, GLuint texture);
+    // Ligar em uma unidade específica (troca a unidade ativa só se precisar)
+    static void bindTextureUnit(GLenum unit, GLenum target, GLuint texture);
+
+    static void setBlend(bool enabled);
+    static void blendFunc(GLenum src, GLenum dst) { blendFuncSeparate(src, dst, src, dst); }
+    static void blendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha);
+    static void setDepthTest(bool enabled);
+    static void depthFunc(GLenum function);
+    static void depthMask(bool enabled);
+    static void colorMask(bool enabled);
+    static void viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+
+    // Leituras sem glGet (que força sincronização com o driver)
+    static bool isBlendEnabled();
+    static bool isDepthTestEnabled();
+    static GLenum getDepthFunc();
+    static void getBlendFunc(GLenum funcs[4]);
+    static void getViewport(GLint rect[4]);
+    static GLuint getProgram() { return program; }
+
+    static void deleteProgram(GLuint oldProgram);
+    static void deleteVertexArrays(GLsizei count, const GLuint* names);
+    static void deleteBuffers(GLsizei count, const GLuint* names);
+    static void deleteTextures(GLsizei count, const GLuint* names);
+
+    // Chamado uma vez por frame (PerformanceMonitor::update)
+    static void endFrame() { frames++; }
+
+    static uint64_t getIssued() { return issued; }
+    static uint64_t getElided() { return elided; }
+    static uint64_t getFrames() { return frames; }
+};
+
+#endif
@@ -0,0 +1,255 @@
+#include "LightClusters.h"
+#include "ParallelFor.h"
+#include "FrameArena.h"
+#include "GLStateCache.h"
+#include "GLProfiler.h"
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+// Índice de tile para uma coordenada NDC em [-1, 1]
+int ndcToTile(float ndc, int tiles) {
+    int tile = (int)std::floor((ndc * 0.5f + 0.5f) * tiles);
+    return std::min(std::max(tile, 0), tiles - 1);
+}
+
+}
+
+LightClusters::LightClusters() : lightBuffer(0), lightTexture(0), gridBuffer(0), gridTexture(0),
+                                 indexBuffer(0), indexTexture(0), nearPlane(0.1f), farPlane(100.0f),
+                                 lastBuildMs(0.0), activeClusters(0) {
+}
+
+LightClusters::~LightClusters() {
+    cleanup();
+}
+
+bool LightClusters::initialize() {
+    glGenBuffers(1, &lightBuffer);
+    glGenBuffers(1, &gridBuffer);
+    glGenBuffers(1, &indexBuffer);
+    glGenTextures(1, &lightTexture);
+    glGenTextures(1, &gridTexture);
+    glGenTextures(1, &indexTexture);
+
+    clusterLights.resize(CLUSTER_COUNT);
+    grid.resize(CLUSTER_COUNT * 2);
+
+    GLint maxTexels = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &maxTexels);
+    std::cout << "Clusters de luz: " << CLUSTERS_X << "x" << CLUSTERS_Y << "x" << CLUSTERS_Z
+              << " (buffer texture máximo: " << maxTexels << " texels)" << std::endl;
+    return lightBuffer && gridBuffer && indexBuffer;
+}
+
+int LightClusters::depthSlice(float depth) const {
+    // Fatias logarítmicas: cada fatia cobre a mesma razão far/near
+    int slice = (int)std::floor(std::log(depth / nearPlane) * CLUSTERS_Z / std::log(farPlane / nearPlane));
+    return std::min(std::max(slice, 0), CLUSTERS_Z - 1);
+}
+
+void LightClusters::computeBounds(const glm::vec4* positionRadius, size_t count, const glm::mat4& view,
+                                  float tanHalfFovX, float tanHalfFovY) {
+    minX.resize(count); maxX.resize(count);
+    minY.resize(count); maxY.resize(count);
+    minZ.resize(count); maxZ.resize(count);
+
+    // Para v em [vmin, vmax] e profundidade em [near, far] (> 0), os extremos de
+    // v / d são vmin/near ou vmin/far (e idem para vmax) conforme o sinal
+    float* ndcMinX = FrameArena::allocateArray<float>(count);
+    float* ndcMaxX = FrameArena::allocateArray<float>(count);
+    float* ndcMinY = FrameArena::allocateArray<float>(count);
+    float* ndcMaxY = FrameArena::allocateArray<float>(count);
+    float* depthNear = FrameArena::allocateArray<float>(count);
+    float* depthFar = FrameArena::allocateArray<float>(count);
+
+    size_t i = 0;
+#ifdef __SSE2__
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 nearV = _mm_set1_ps(nearPlane);
+    const __m128 invTanX = _mm_set1_ps(1.0f / tanHalfFovX);
+    const __m128 invTanY = _mm_set1_ps(1.0f / tanHalfFovY);
+    for (; i + 4 <= count; i += 4) {
+        // Transpor 4 luzes para SoA
+        __m128 px = _mm_set_ps(positionRadius[i + 3].x, positionRadius[i + 2].x, positionRadius[i + 1].x, positionRadius[i].x);
+        __m128 py = _mm_set_ps(positionRadius[i + 3].y, positionRadius[i + 2].y, positionRadius[i + 1].y, positionRadius[i].y);
+        __m128 pz = _mm_set_ps(positionRadius[i + 3].z, positionRadius[i + 2].z, positionRadius[i + 1].z, positionRadius[i].z);
+        __m128 r = _mm_set_ps(positionRadius[i + 3].w, positionRadius[i + 2].w, positionRadius[i + 1].w, positionRadius[i].w);
+
+        // Espaço de visão (glm é column-major: view[coluna][linha])
+        __m128 vx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(px, _mm_set1_ps(view[0][0])), _mm_mul_ps(py, _mm_set1_ps(view[1][0]))),
+                               _mm_add_ps(_mm_mul_ps(pz, _mm_set1_ps(view[2][0])), _mm_set1_ps(view[3][0])));
+        __m128 vy = _mm_add_ps(_mm_add_ps(_mm_mul_ps(px, _mm_set1_ps(view[0][1])), _mm_mul_ps(py, _mm_set1_ps(view[1][1]))),
+                               _mm_add_ps(_mm_mul_ps(pz, _mm_set1_ps(view[2][1])), _mm_set1_ps(view[3][1])));
+        __m128 vz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(px, _mm_set1_ps(view[0][2])), _mm_mul_ps(py, _mm_set1_ps(view[1][2]))),
+                               _mm_add_ps(_mm_mul_ps(pz, _mm_set1_ps(view[2][2])), _mm_set1_ps(view[3][2])));
+
+        // A câmera olha para -Z
+        __m128 depth = _mm_sub_ps(zero, vz);
+        __m128 dn = _mm_max_ps(_mm_sub_ps(depth, r), nearV);
+        __m128 df = _mm_max_ps(_mm_add_ps(depth, r), nearV);
+        __m128 invDn = _mm_div_ps(_mm_set1_ps(1.0f), dn);
+        __m128 invDf = _mm_div_ps(_mm_set1_ps(1.0f), df);
+
+        __m128 xMin = _mm_sub_ps(vx, r), xMax = _mm_add_ps(vx, r);
+        __m128 yMin = _mm_sub_ps(vy, r), yMax = _mm_add_ps(vy, r);
+
+        // Seleção sem branch: negativo divide por near, positivo por far (e o inverso no máximo)
+        __m128 negMinX = _mm_cmplt_ps(xMin, zero), posMaxX = _mm_cmpgt_ps(xMax, zero);
+        __m128 negMinY = _mm_cmplt_ps(yMin, zero), posMaxY = _mm_cmpgt_ps(yMax, zero);
+        __m128 sMinX = _mm_or_ps(_mm_and_ps(negMinX, invDn), _mm_andnot_ps(negMinX, invDf));
+        __m128 sMaxX = _mm_or_ps(_mm_and_ps(posMaxX, invDn), _mm_andnot_ps(posMaxX, invDf));
+        __m128 sMinY = _mm_or_ps(_mm_and_ps(negMinY, invDn), _mm_andnot_ps(negMinY, invDf));
+        __m128 sMaxY = _mm_or_ps(_mm_and_ps(posMaxY, invDn), _mm_andnot_ps(posMaxY, invDf));
+
+        _mm_storeu_ps(&ndcMinX[i], _mm_mul_ps(_mm_mul_ps(xMin, sMinX), invTanX));
+        _mm_storeu_ps(&ndcMaxX[i], _mm_mul_ps(_mm_mul_ps(xMax, sMaxX), invTanX));
+        _mm_storeu_ps(&ndcMinY[i], _mm_mul_ps(_mm_mul_ps(yMin, sMinY), invTanY));
+        _mm_storeu_ps(&ndcMaxY[i], _mm_mul_ps(_mm_mul_ps(yMax, sMaxY), invTanY));
+        _mm_storeu_ps(&depthNear[i], _mm_sub_ps(depth, r));
+        _mm_storeu_ps(&depthFar[i], _mm_add_ps(depth, r));
+    }
+#endif
+    for (; i < count; ++i) {
+        glm::vec3 v = glm::vec3(view * glm::vec4(glm::vec3(positionRadius[i]), 1.0f));
+        float r = positionRadius[i].w;
+        float depth = -v.z;
+        float dn = std::max(depth - r, nearPlane);
+        float df = std::max(depth + r, nearPlane);
+        float xMin = v.x - r, xMax = v.x + r;
+        float yMin = v.y - r, yMax = v.y + r;
+        ndcMinX[i] = (xMin < 0.0f ? xMin / dn : xMin / df) / tanHalfFovX;
+        ndcMaxX[i] = (xMax > 0.0f ? xMax / dn : xMax / df) / tanHalfFovX;
+        ndcMinY[i] = (yMin < 0.0f ? yMin / dn : yMin / df) / tanHalfFovY;
+        ndcMaxY[i] = (yMax > 0.0f ? yMax / dn : yMax / df) / tanHalfFovY;
+        depthNear[i] = depth - r;
+        depthFar[i] = depth + r;
+    }
+
+    // Converter para índices de cluster (log por luz, não por cluster)
+    for (size_t l = 0; l < count; ++l) {
+        bool outside = depthFar[l] < nearPlane || depthNear[l] > farPlane ||
+                       ndcMaxX[l] < -1.0f || ndcMinX[l] > 1.0f ||
+                       ndcMaxY[l] < -1.0f || ndcMinY[l] > 1.0f;
+        if (outside) {
+            minX[l] = minY[l] = minZ[l] = 1;
+            maxX[l] = maxY[l] = maxZ[l] = 0;
+            continue;
+        }
+        minX[l] = ndcToTile(ndcMinX[l], CLUSTERS_X);
+        maxX[l] = ndcToTile(ndcMaxX[l], CLUSTERS_X);
+        minY[l] = ndcToTile(ndcMinY[l], CLUSTERS_Y);
+        maxY[l] = ndcToTile(ndcMaxY[l], CLUSTERS_Y);
+        minZ[l] = depthSlice(std::max(depthNear[l], nearPlane));
+        maxZ[l] = depthSlice(std::min(depthFar[l], farPlane));
+    }
+}
+
+void LightClusters::build(const glm::vec4* positionRadius, const glm::vec3* colors, size_t lightCount,
+                          const glm::mat4& view, float fovY, float aspect, float nearPlane, float farPlane) {
+    auto start = std::chrono::high_resolution_clock::now();
+    this->nearPlane = nearPlane;
+    this->farPlane = farPlane;
+
+    float tanHalfFovY = std::tan(fovY * 0.5f);
+    computeBounds(positionRadius, lightCount, view, tanHalfFovY * aspect, tanHalfFovY);
+
+    // Cada thread preenche um intervalo de fatias Z: sem atomics e com a mesma
+    // ordem de luzes em qualquer número de threads
+    parallelFor(0, CLUSTERS_Z, [&](size_t sliceBegin, size_t sliceEnd) {
+        for (size_t z = sliceBegin; z < sliceEnd; ++z) {
+            std::vector<uint32_t>* slice = &clusterLights[z * CLUSTERS_X * CLUSTERS_Y];
+            for (int c = 0; c < CLUSTERS_X * CLUSTERS_Y; ++c) {
+                slice[c].clear();
+            }
+            for (size_t l = 0; l < lightCount; ++l) {
+                if ((int)z < minZ[l] || (int)z > maxZ[l]) continue;
+                for (int y = minY[l]; y <= maxY[l]; ++y) {
+                    for (int x = minX[l]; x <= maxX[l]; ++x) {
+                        slice[y * CLUSTERS_X + x].push_back(l);
+                    }
+                }
+            }
+        }
+    }, 2);
+
+    // Concatenar as listas (offset, contagem)
+    indices.clear();
+    activeClusters = 0;
+    for (int c = 0; c < CLUSTER_COUNT; ++c) {
+        grid[c * 2] = indices.size();
+        grid[c * 2 + 1] = clusterLights[c].size();
+        indices.insert(indices.end(), clusterLights[c].begin(), clusterLights[c].end());
+        if (!clusterLights[c].empty()) activeClusters++;
+    }
+
+    lightData.resize(lightCount * 8);
+    for (size_t l = 0; l < lightCount; ++l) {
+        float* texel = &lightData[l * 8];
+        texel[0] = positionRadius[l].x;
+        texel[1] = positionRadius[l].y;
+        texel[2] = positionRadius[l].z;
+        texel[3] = positionRadius[l].w;
+        texel[4] = colors[l].x;
+        texel[5] = colors[l].y;
+        texel[6] = colors[l].z;
+        texel[7] = 0.0f;
+    }
+
+    // Buffer texture não aceita tamanho zero: manter pelo menos um elemento
+    if (indices.empty()) indices.push_back(0);
+    if (lightData.empty()) lightData.resize(8, 0.0f);
+
+    // Realocar com glBufferData (orphaning) em vez de esperar o frame anterior
+    GLStateCache::bindBuffer(GL_TEXTURE_BUFFER, lightBuffer);
+    glBufferData(GL_TEXTURE_BUFFER, lightData.size() * sizeof(float), lightData.data(), GL_STREAM_DRAW);
+    GLStateCache::bindBuffer(GL_TEXTURE_BUFFER, gridBuffer);
+    glBufferData(GL_TEXTURE_BUFFER, grid.size() * sizeof(uint32_t), grid.data(), GL_STREAM_DRAW);
+    GLStateCache::bindBuffer(GL_TEXTURE_BUFFER, indexBuffer);
+    glBufferData(GL_TEXTURE_BUFFER, indices.size() * sizeof(uint32_t), indices.data(), GL_STREAM_DRAW);
+    GLStateCache::bindBuffer(GL_TEXTURE_BUFFER, 0);
+
+    GLStateCache::bindTexture(GL_TEXTURE_BUFFER, lightTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, lightBuffer);
+    GLStateCache::bindTexture(GL_TEXTURE_BUFFER, gridTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RG32UI, gridBuffer);
+    GLStateCache::bindTexture(GL_TEXTURE_BUFFER, indexTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_R32UI, indexBuffer);
+    GLStateCache::bindTexture(GL_TEXTURE_BUFFER, 0);
+
+    lastBuildMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+void LightClusters::bind(GLuint program, int viewportWidth, int viewportHeight) {
+    GLStateCache::bindTextureUnit(GL_TEXTURE1, GL_TEXTURE_BUFFER, lightTexture);
+    GLStateCache::bindTextureUnit(GL_TEXTURE2, GL_TEXTURE_BUFFER, gridTexture);
+    GLStateCache::bindTextureUnit(GL_TEXTURE3, GL_TEXTURE_BUFFER, indexTexture);
+
+    glUniform1i(glGetUniformLocation(program, "clusterLights"), 1);
+    glUniform1i(glGetUniformLocation(program, "clusterGrid"), 2);
+    glUniform1i(glGetUniformLocation(program, "clusterIndices"), 3);
+    glUniform3i(glGetUniformLocation(program, "clusterDims"), CLUSTERS_X, CLUSTERS_Y, CLUSTERS_Z);
+    glUniform2f(glGetUniformLocation(program, "clusterTileSize"),
+                (float)viewportWidth / CLUSTERS_X, (float)viewportHeight / CLUSTERS_Y);
+
+    // fatia = log(profundidade) * escala + deslocamento
+    float scale = CLUSTERS_Z / std::log(farPlane / nearPlane);
+    glUniform2f(glGetUniformLocation(program, "clusterDepthParams"), scale, -std::log(nearPlane) * scale);
+}
+
+void LightClusters::cleanup() {
+    GLuint buffers[] = {lightBuffer, gridBuffer, indexBuffer};
+    GLuint textures[] = {lightTexture, gridTexture, indexTexture};
+    if (lightBuffer) {
+        GLStateCache::deleteBuffers(3, buffers);
+        GLStateCache::deleteTextures(3, textures);
+    }
+    lightBuffer = gridBuffer = indexBuffer = 0;
+    lightTexture = gridTexture = indexTexture = 0;
+}
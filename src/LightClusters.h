@@ -0,0 +1,69 @@
+#ifndef LIGHTCLUSTERS_H
+#define LIGHTCLUSTERS_H
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+// Iluminação "clustered forward": o frustum é dividido em CLUSTERS_X x CLUSTERS_Y
+// tiles de tela e CLUSTERS_Z fatias de profundidade logarítmicas. Cada luz é
+// atribuída na CPU aos clusters que a esfera (posição + raio) pode tocar, e o
+// fragment shader percorre só a lista do seu cluster.
+//
+// Os dados vão para a GPU em buffer textures (OpenGL 3.3, sem SSBO):
+//   unidade 1 - clusterLights  (RGBA32F): 2 texels por luz, (posição, raio) e (cor * intensidade, 0)
+//   unidade 2 - clusterGrid    (RG32UI):  (offset, contagem) por cluster
+//   unidade 3 - clusterIndices (R32UI):   índices de luz concatenados
+class LightClusters {
+public:
+    static const int CLUSTERS_X = 32;
+    static const int CLUSTERS_Y = 18;
+    static const int CLUSTERS_Z = 24;
+    static const int CLUSTER_COUNT = CLUSTERS_X * CLUSTERS_Y * CLUSTERS_Z;
+
+private:
+    GLuint lightBuffer, lightTexture;
+    GLuint gridBuffer, gridTexture;
+    GLuint indexBuffer, indexTexture;
+
+    // Limites de cada luz em coordenadas de cluster (min > max = fora do frustum)
+    std::vector<int> minX, maxX, minY, maxY, minZ, maxZ;
+
+    // Listas por cluster; cada thread escreve só nas fatias Z que recebeu
+    std::vector<std::vector<uint32_t>> clusterLights;
+
+    std::vector<float> lightData;
+    std::vector<uint32_t> grid;
+    std::vector<uint32_t> indices;
+
+    float nearPlane, farPlane;
+    double lastBuildMs;
+    int activeClusters;
+
+    // Projetar as esferas em coordenadas de cluster (4 luzes por instrução SSE2)
+    void computeBounds(const glm::vec4* positionRadius, size_t count, const glm::mat4& view,
+                       float tanHalfFovX, float tanHalfFovY);
+
+    int depthSlice(float depth) const;
+
+public:
+    LightClusters();
+    ~LightClusters();
+
+    bool initialize();
+
+    // Reatribuir as luzes (posição/raio em coordenadas de mundo) e enviar os buffers
+    void build(const glm::vec4* positionRadius, const glm::vec3* colors, size_t lightCount,
+               const glm::mat4& view, float fovY, float aspect, float nearPlane, float farPlane);
+
+    // Ligar os buffers nas unidades 1-3 e configurar os uniforms do programa
+    void bind(GLuint program, int viewportWidth, int viewportHeight);
+    void cleanup();
+
+    double getLastBuildMs() const { return lastBuildMs; }
+    size_t getIndexCount() const { return indices.size(); }
+    int getActiveClusterCount() const { return activeClusters; }
+};
+
+#endif
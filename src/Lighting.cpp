@@ -1,7 +1,17 @@
 #include "Lighting.h"
+#include "GLStateCache.h"
+#include "FrameArena.h"
+#include "GLProfiler.h"
 #include <iostream>
+#include <random>
+#include <cmath>
+#include <algorithm>
+#include <cstdio>
 
-Lighting::Lighting() : shaderProgram(0) {
+Lighting::Lighting() : variants(nullptr), activeProgram(0), lightsVersion(0), clusters(nullptr), clustersDirty(true),
+                       forceClustered(false), cameraView(1.0f), cameraFovY(glm::radians(45.0f)),
+                       cameraAspect(4.0f / 3.0f), cameraNear(0.1f), cameraFar(100.0f),
+                       viewportWidth(1024), viewportHeight(768) {
 }
 
 Lighting::~Lighting() {
@@ -9,13 +19,23 @@ Lighting::~Lighting() {
 }
 
 bool Lighting::initialize() {
-    if (!createShaderProgram()) {
+    // Adicionar luzes padrão (antes dos shaders: NUM_LIGHTS é fixado em cada variante)
+    addOmnidirectionalLight(glm::vec3(0.0f, 0.0f, 2.0f), glm::vec3(1.0f, 1.0f, 1.0f), 1.0f);
+    addSpotLight(glm::vec3(0.0f, 1.0f, 1.0f), glm::vec3(1.0f, 0.5f, 0.0f), 1.5f, 5.0f);
+    
+    // Só a variante básica antes do primeiro frame: as de iluminação e textura
+    // são compiladas em lote por prepareVariants() quando o modo é ligado
+    variants = new ShaderVariantCache(vertexShaderSource, fragmentShaderSource, "iluminação");
+    if (!variants->build({ShaderVariantKey(false, false)})) {
+        std::cerr << "Erro ao criar variantes de shader de iluminação" << std::endl;
         return false;
     }
     
-    // Adicionar luzes padrão
-    addOmnidirectionalLight(glm::vec3(0.0f, 0.0f, 2.0f), glm::vec3(1.0f, 1.0f, 1.0f), 1.0f);
-    addSpotLight(glm::vec3(0.0f, 1.0f, 1.0f), glm::vec3(1.0f, 0.5f, 0.0f), 1.5f, 5.0f);
+    clusters = new LightClusters();
+    if (!clusters->initialize()) {
+        std::cerr << "Erro ao criar buffers de clusters de luz" << std::endl;
+        return false;
+    }
     
     std::cout << "Sistema de iluminação inicializado com " << lights.size() << " luzes" << std::endl;
     return true;
@@ -30,6 +50,8 @@ void Lighting::addOmnidirectionalLight(glm::vec3 position, glm::vec3 color, floa
     light.enabled = true;
     
     lights.push_back(light);
+    lightsVersion++;
+    clustersDirty = true;
     std::cout << "Luz omnidirecional adicionada na posição (" 
               << position.x << ", " << position.y << ", " << position.z << ")" << std::endl;
 }
@@ -43,98 +65,196 @@ void Lighting::addSpotLight(glm::vec3 position, glm::vec3 color, float intensity
     light.enabled = true;
     
     lights.push_back(light);
+    lightsVersion++;
+    clustersDirty = true;
     std::cout << "Spotlight adicionada na posição (" 
               << position.x << ", " << position.y << ", " << position.z << ")" << std::endl;
 }
 
+void Lighting::prepareVariants(bool lightingEnabled, bool textureEnabled) {
+    int numLights = getEnabledLightCount();
+    std::vector<ShaderVariantKey> keys;
+    if (textureEnabled) {
+        keys.push_back(ShaderVariantKey(false, true));
+    }
+    if (lightingEnabled) {
+        // Por fragmento, por clusters e Gouraud, com e sem textura. Acima de
+        // MAX_UNIFORM_LIGHTS os arrays de uniforms não cabem: só clusters
+        bool uniformLights = numLights <= MAX_UNIFORM_LIGHTS;
+        for (bool texture : {false, true}) {
+            if (texture && !textureEnabled) continue;
+            keys.push_back(ShaderVariantKey(true, texture, 0, false, true));
+            if (uniformLights) {
+                keys.push_back(ShaderVariantKey(true, texture, numLights));
+                keys.push_back(ShaderVariantKey(true, texture, numLights, false, false, true));
+            }
+        }
+    }
+    if (!variants->build(keys)) {
+        std::cerr << "Erro ao criar variantes de shader de iluminação" << std::endl;
+    }
+}
+
+int Lighting::getEnabledLightCount() const {
+    int count = 0;
+    for (const auto& light : lights) {
+        if (light.enabled) count++;
+    }
+    return count;
+}
+
 void Lighting::setViewPosition(glm::vec3 viewPos) {
-    glUseProgram(shaderProgram);
-    GLint viewPosLoc = glGetUniformLocation(shaderProgram, "viewPos");
+    GLStateCache::useProgram(activeProgram);
+    GLint viewPosLoc = glGetUniformLocation(activeProgram, "viewPos");
     glUniform3fv(viewPosLoc, 1, glm::value_ptr(viewPos));
 }
 
-void Lighting::useShader() {
-    glUseProgram(shaderProgram);
+void Lighting::setCamera(const glm::mat4& view, float fovY, float aspect, float nearPlane, float farPlane) {
+    if (view != cameraView || fovY != cameraFovY || aspect != cameraAspect ||
+        nearPlane != cameraNear || farPlane != cameraFar) {
+        cameraView = view;
+        cameraFovY = fovY;
+        cameraAspect = aspect;
+        cameraNear = nearPlane;
+        cameraFar = farPlane;
+        clustersDirty = true;
+    }
+}
+
+void Lighting::setViewport(int width, int height) {
+    // O tamanho dos tiles é só um uniform; as listas não dependem do viewport
+    viewportWidth = std::max(1, width);
+    viewportHeight = std::max(1, height);
+}
+
+void Lighting::generateLights(int count) {
+    lights.clear();
     
-    // Enviar luzes para o shader
-    GLint numLightsLoc = glGetUniformLocation(shaderProgram, "numLights");
-    glUniform1i(numLightsLoc, lights.size());
+    std::mt19937 rng(4242);
+    std::uniform_real_distribution<float> posDist(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> colorDist(0.3f, 1.0f);
     
-    for (size_t i = 0; i < lights.size() && i < 8; ++i) {
-        std::string lightName = "lights[" + std::to_string(i) + "]";
-        
-        GLint posLoc = glGetUniformLocation(shaderProgram, (lightName + ".position").c_str());
-        GLint colorLoc = glGetUniformLocation(shaderProgram, (lightName + ".color").c_str());
-        GLint intensityLoc = glGetUniformLocation(shaderProgram, (lightName + ".intensity").c_str());
-        GLint radiusLoc = glGetUniformLocation(shaderProgram, (lightName + ".radius").c_str());
-        GLint enabledLoc = glGetUniformLocation(shaderProgram, (lightName + ".enabled").c_str());
-        
-        if (posLoc != -1) glUniform3fv(posLoc, 1, glm::value_ptr(lights[i].position));
-        if (colorLoc != -1) glUniform3fv(colorLoc, 1, glm::value_ptr(lights[i].color));
-        if (intensityLoc != -1) glUniform1f(intensityLoc, lights[i].intensity);
-        if (radiusLoc != -1) glUniform1f(radiusLoc, lights[i].radius);
-        if (enabledLoc != -1) glUniform1i(enabledLoc, lights[i].enabled);
+    // Área coberta pelas luzes constante: raio ~ 1/sqrt(count)
+    float radius = std::min(0.9f, 0.9f * std::sqrt(8.0f / std::max(count, 1)));
+    for (int i = 0; i < count; ++i) {
+        Light light;
+        light.position = glm::vec3(posDist(rng), posDist(rng), 0.3f * radius);
+        light.color = glm::vec3(colorDist(rng), colorDist(rng), colorDist(rng));
+        light.intensity = 1.0f;
+        light.radius = radius;
+        light.enabled = true;
+        lights.push_back(light);
     }
+    lightsVersion++;
+    clustersDirty = true;
+    
+    std::cout << count << " luzes pontuais geradas (raio " << radius << ", "
+              << (isClusteredShading() ? "clusters" : "uniforms") << ")" << std::endl;
 }
 
-void Lighting::cleanup() {
-    if (shaderProgram) {
-        glDeleteProgram(shaderProgram);
-        shaderProgram = 0;
+void Lighting::buildClusters() {
+    // Arrays do frame: somem no próximo FrameArena::reset()
+    glm::vec4* positionRadius = FrameArena::allocateArray<glm::vec4>(lights.size());
+    glm::vec3* colors = FrameArena::allocateArray<glm::vec3>(lights.size());
+    size_t count = 0;
+    for (const auto& light : lights) {
+        if (!light.enabled) continue;
+        positionRadius[count] = glm::vec4(light.position, light.radius);
+        colors[count] = light.color * light.intensity;
+        count++;
     }
+    
+    clusters->build(positionRadius, colors, count, cameraView, cameraFovY, cameraAspect, cameraNear, cameraFar);
+    clustersDirty = false;
 }
 
-GLuint Lighting::compileShader(GLenum type, const char* source) {
-    GLuint shader = glCreateShader(type);
-    glShaderSource(shader, 1, &source, nullptr);
-    glCompileShader(shader);
-
-    // Verificar erros de compilação
-    GLint success;
-    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-    if (!success) {
-        GLchar infoLog[512];
-        glGetShaderInfoLog(shader, 512, nullptr, infoLog);
-        std::cerr << "Erro ao compilar shader de iluminação: " << infoLog << std::endl;
-        glDeleteShader(shader);
-        return 0;
+void Lighting::useVariant(bool lightingEnabled, bool textureEnabled, bool textureArray, bool perVertex,
+                          AnimationPath animation, bool pulledVertices) {
+    int numLights = getEnabledLightCount();
+    bool clustered = lightingEnabled && isClusteredShading();
+    
+    // Sem luzes habilitadas a variante iluminada se reduz à básica
+    ShaderVariantKey key(lightingEnabled && numLights > 0, textureEnabled, numLights, textureArray, clustered,
+                         perVertex, animation, pulledVertices);
+    GLuint program = variants->get(key);
+    if (!program) {
+        // Sem a variante pedida: desenhar com a básica (mesma origem da matriz e
+        // dos vértices) em vez de manter o programa do frame anterior
+        ShaderVariantKey fallback(false, false, 0, false, false, false, animation, pulledVertices);
+        if (reportedFallbacks.insert(key).second) {
+            std::cerr << "Variante " << key.name() << " indisponível, usando " << fallback.name() << std::endl;
+        }
+        key = fallback;
+        program = variants->get(key);
     }
-
-    return shader;
+    
+    activeKey = key;
+    if (!program) {
+        activeProgram = 0;
+        return;
+    }
+    activeProgram = program;
+    GLStateCache::useProgram(activeProgram);
+    
+    if (activeKey.clustered) {
+        bindClusters(activeProgram);
+    }
+    
+    auto uploaded = uploadedVersion.find(activeProgram);
+    if (uploaded != uploadedVersion.end() && uploaded->second == lightsVersion) {
+        return;
+    }
+    if (activeKey.texture) {
+        glUniform1i(glGetUniformLocation(activeProgram, "texture1"), 0);
+    }
+    if (!activeKey.clustered && activeKey.lighting) {
+        uploadLights();
+    }
+    uploadedVersion[activeProgram] = lightsVersion;
 }
 
-bool Lighting::createShaderProgram() {
-    // Compilar shaders
-    GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertexShaderSource);
-    GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentShaderSource);
-
-    if (!vertexShader || !fragmentShader) {
-        return false;
+void Lighting::bindClusters(GLuint program) {
+    if (clustersDirty) {
+        buildClusters();
     }
+    clusters->bind(program, viewportWidth, viewportHeight);
+}
 
-    // Criar programa
-    shaderProgram = glCreateProgram();
-    glAttachShader(shaderProgram, vertexShader);
-    glAttachShader(shaderProgram, fragmentShader);
-    glLinkProgram(shaderProgram);
-
-    // Verificar erros de linking
-    GLint success;
-    glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
-    if (!success) {
-        GLchar infoLog[512];
-        glGetProgramInfoLog(shaderProgram, 512, nullptr, infoLog);
-        std::cerr << "Erro ao linkar programa de shader de iluminação: " << infoLog << std::endl;
+void Lighting::uploadLights() {
+    // Enviar luzes habilitadas para o shader (índices compactos, sem teste de "enabled" na GPU)
+    int index = 0;
+    for (size_t i = 0; i < lights.size(); ++i) {
+        if (!lights[i].enabled) continue;
         
-        glDeleteShader(vertexShader);
-        glDeleteShader(fragmentShader);
-        return false;
+        // Nomes montados em buffer da pilha (sem strings no heap por luz)
+        char name[48];
+        std::snprintf(name, sizeof(name), "lights[%d].position", index);
+        GLint posLoc = glGetUniformLocation(activeProgram, name);
+        std::snprintf(name, sizeof(name), "lights[%d].color", index);
+        GLint colorLoc = glGetUniformLocation(activeProgram, name);
+        std::snprintf(name, sizeof(name), "lights[%d].intensity", index);
+        GLint intensityLoc = glGetUniformLocation(activeProgram, name);
+        std::snprintf(name, sizeof(name), "lights[%d].radius", index);
+        GLint radiusLoc = glGetUniformLocation(activeProgram, name);
+        
+        if (posLoc != -1) glUniform3fv(posLoc, 1, glm::value_ptr(lights[i].position));
+        if (colorLoc != -1) glUniform3fv(colorLoc, 1, glm::value_ptr(lights[i].color));
+        if (intensityLoc != -1) glUniform1f(intensityLoc, lights[i].intensity);
+        if (radiusLoc != -1) glUniform1f(radiusLoc, lights[i].radius);
+        index++;
     }
+}
 
-    // Limpar shaders individuais
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
-
-    std::cout << "Programa de shader de iluminação criado com sucesso!" << std::endl;
-    return true;
+void Lighting::cleanup() {
+    if (variants) {
+        delete variants;
+        variants = nullptr;
+    }
+    uploadedVersion.clear();
+    reportedFallbacks.clear();
+    if (clusters) {
+        delete clusters;
+        clusters = nullptr;
+    }
+    activeProgram = 0;
 }
@@ -6,6 +6,11 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <vector>
+#include <unordered_map>
+#include <set>
+#include <string>
+#include "ShaderVariants.h"
+#include "LightClusters.h"
 
 struct Light {
     glm::vec3 position;
@@ -19,84 +24,191 @@ struct Light {
 
 class Lighting {
 private:
-    GLuint shaderProgram;
     std::vector<Light> lights;
+    ShaderVariantCache* variants;
+    ShaderVariantKey activeKey;
+    GLuint activeProgram;
     
-    // Shader source code com iluminação
+    // Uniforms que só mudam com as luzes (texture1 e lights[]) ficam gravados no
+    // programa: cada variante recebe de novo só quando lightsVersion avança
+    unsigned lightsVersion;
+    std::unordered_map<GLuint, unsigned> uploadedVersion;
+    
+    // Variantes que falharam e já foram trocadas pela básica (aviso uma vez só)
+    std::set<ShaderVariantKey> reportedFallbacks;
+    
+    // Iluminação por clusters (usada acima de MAX_UNIFORM_LIGHTS luzes ou quando forçada)
+    LightClusters* clusters;
+    bool clustersDirty;
+    bool forceClustered;
+    glm::mat4 cameraView;
+    float cameraFovY, cameraAspect, cameraNear, cameraFar;
+    int viewportWidth, viewportHeight;
+    
+    // Shader source code com iluminação (modelos; o #version, os #defines
+    // LIGHTING, GOURAUD, TEXTURE e NUM_LIGHTS, as entradas de vértice e a
+    // matriz "transform" são inseridos por ShaderVariantCache)
     const char* vertexShaderSource = R"(
-        #version 330 core
-        layout (location = 0) in vec3 aPos;
-        layout (location = 1) in vec3 aColor;
-        layout (location = 2) in vec3 aNormal;
-        layout (location = 3) in vec2 aTexCoord;
-        
-        uniform mat4 model;
         uniform mat4 view;
         uniform mat4 projection;
-        uniform mat4 transform;
+        #ifdef GPU_ANIMATION
+        // Matriz lida na GPU (TriangleAnimation); a transformação é rígida, então
+        // model = transform e a inversa transposta é a própria rotação
+        #define model transform
+        #define normalMatrix mat3(transform)
+        #else
+        uniform mat4 model;
+        uniform mat3 normalMatrix;   // transpose(inverse(model)), calculada na CPU
+        #endif
         
-        out vec3 FragPos;
         out vec3 VertexColor;
+        #ifdef GOURAUD
+        out vec3 LitColor;
+        uniform vec3 viewPos;
+        
+        struct Light {
+            vec3 position;
+            vec3 color;
+            float intensity;
+            float radius;
+        };
+        
+        uniform Light lights[NUM_LIGHTS];
+        
+        // Mesma fórmula do fragment shader, avaliada só nos vértices
+        vec3 calculateLight(vec3 lightPos, vec3 lightColor, float radius, vec3 normal, vec3 fragPos, vec3 viewDir) {
+            vec3 lightDir = normalize(lightPos - fragPos);
+            float distance = length(lightPos - fragPos);
+            
+            float attenuation = 1.0 / (1.0 + 0.09 * distance + 0.032 * distance * distance);
+            float falloff = clamp(1.0 - pow(distance / radius, 4.0), 0.0, 1.0);
+            attenuation *= falloff * falloff;
+            
+            float diff = max(dot(normal, lightDir), 0.0);
+            vec3 diffuse = diff * lightColor * attenuation;
+            
+            vec3 reflectDir = reflect(-lightDir, normal);
+            float spec = pow(max(dot(viewDir, reflectDir), 0.0), 32);
+            vec3 specular = spec * lightColor * attenuation;
+            
+            return diffuse + specular;
+        }
+        #elif defined(LIGHTING)
+        out vec3 FragPos;
         out vec3 Normal;
+        #endif
+        #ifdef TEXTURE
+        uniform float uvScale;   // Repetições da textura por triângulo
         out vec2 TexCoord;
+        #endif
+        #ifdef TEXTURE_ARRAY
+        uniform int textureLayers;
+        flat out float TexLayer;
+        #endif
+        #ifdef CLUSTERED
+        out float ViewDepth;
+        #endif
+        
+        // Mesma profundidade que a pré-passada (DepthPrepass), necessário para GL_EQUAL
+        invariant gl_Position;
         
         void main() {
-            FragPos = vec3(model * vec4(aPos, 1.0));
             VertexColor = aColor;
-            Normal = mat3(transpose(inverse(model))) * aNormal;
-            TexCoord = aTexCoord;
+            #ifdef GOURAUD
+            vec3 worldPos = vec3(model * vec4(aPos, 1.0));
+            vec3 normal = normalize(normalMatrix * aNormal);
+            vec3 viewDir = normalize(viewPos - worldPos);
+            LitColor = vec3(0.6, 0.6, 0.7) * aColor;
+            for (int i = 0; i < NUM_LIGHTS; i++) {
+                LitColor += calculateLight(lights[i].position, lights[i].color * lights[i].intensity,
+                                           lights[i].radius, normal, worldPos, viewDir) * aColor;
+            }
+            #elif defined(LIGHTING)
+            FragPos = vec3(model * vec4(aPos, 1.0));
+            Normal = normalMatrix * aNormal;
+            #endif
+            #ifdef TEXTURE
+            TexCoord = aTexCoord * uvScale;
+            #endif
+            #ifdef TEXTURE_ARRAY
+            // Cada triângulo (3 vértices consecutivos) usa uma camada do array
+            TexLayer = float((gl_VertexID / 3) % textureLayers);
+            #endif
+            #ifdef CLUSTERED
+            // Profundidade em espaço de visão escolhe a fatia Z do cluster
+            ViewDepth = -(view * transform * vec4(aPos, 1.0)).z;
+            #endif
             
             gl_Position = projection * view * transform * vec4(aPos, 1.0);
         }
     )";
 
     const char* fragmentShaderSource = R"(
-        #version 330 core
+        in vec3 VertexColor;
+        #ifdef GOURAUD
+        in vec3 LitColor;
+        #elif defined(LIGHTING)
+        in vec3 FragPos;
+        in vec3 Normal;
+        #endif
+        #ifdef TEXTURE
+        in vec2 TexCoord;
+        #ifdef TEXTURE_ARRAY
+        flat in float TexLayer;
+        uniform sampler2DArray texture1;
+        #else
+        uniform sampler2D texture1;
+        #endif
+        #endif
+        
+        out vec4 FragColor;
+        
+        #if defined(LIGHTING) && !defined(GOURAUD)
+        uniform vec3 viewPos;
+        
+        #ifdef CLUSTERED
+        in float ViewDepth;
+        uniform samplerBuffer clusterLights;     // (posição, raio), (cor * intensidade, 0)
+        uniform usamplerBuffer clusterGrid;      // (offset, contagem) por cluster
+        uniform usamplerBuffer clusterIndices;
+        uniform ivec3 clusterDims;
+        uniform vec2 clusterTileSize;
+        uniform vec2 clusterDepthParams;         // fatia = log(profundidade) * x + y
+        #else
         struct Light {
             vec3 position;
             vec3 color;
             float intensity;
             float radius;
-            bool enabled;
         };
         
-        in vec3 FragPos;
-        in vec3 VertexColor;
-        in vec3 Normal;
-        in vec2 TexCoord;
-        
-        uniform vec3 viewPos;
-        uniform Light lights[8];
-        uniform int numLights;
-        uniform sampler2D texture1;
-        uniform bool useTexture;
-        
-        out vec4 FragColor;
+        uniform Light lights[NUM_LIGHTS];
+        #endif
         
-        vec3 calculateLight(Light light, vec3 normal, vec3 fragPos, vec3 viewDir) {
-            if (!light.enabled) return vec3(0.0);
-            
-            vec3 lightDir = normalize(light.position - fragPos);
-            float distance = length(light.position - fragPos);
+        // lightColor já multiplicada pela intensidade
+        vec3 calculateLight(vec3 lightPos, vec3 lightColor, float radius, vec3 normal, vec3 fragPos, vec3 viewDir) {
+            vec3 lightDir = normalize(lightPos - fragPos);
+            float distance = length(lightPos - fragPos);
             
-            // Atenuação
+            // Atenuação, levada suavemente a zero no raio da luz
             float attenuation = 1.0 / (1.0 + 0.09 * distance + 0.032 * distance * distance);
+            float falloff = clamp(1.0 - pow(distance / radius, 4.0), 0.0, 1.0);
+            attenuation *= falloff * falloff;
             
             // Difusa
             float diff = max(dot(normal, lightDir), 0.0);
-            vec3 diffuse = diff * light.color * light.intensity * attenuation;
+            vec3 diffuse = diff * lightColor * attenuation;
             
             // Especular
             vec3 reflectDir = reflect(-lightDir, normal);
             float spec = pow(max(dot(viewDir, reflectDir), 0.0), 32);
-            vec3 specular = spec * light.color * light.intensity * attenuation;
+            vec3 specular = spec * lightColor * attenuation;
             
             return diffuse + specular;
         }
+        #endif
+        
         void main() {
-            vec3 normal = normalize(Normal);
-            vec3 viewDir = normalize(viewPos - FragPos);
-            
             // Usar cor do vértice como base
             vec3 baseColor = VertexColor;
             
@@ -104,39 +216,99 @@ private:
             vec3 ambient = vec3(0.6, 0.6, 0.7);
             vec3 result = ambient * baseColor;
             
-            // Calcular todas as luzes
-            for (int i = 0; i < numLights; i++) {
-                result += calculateLight(lights[i], normal, FragPos, viewDir) * baseColor;
-            }
+            #ifdef GOURAUD
+            result = LitColor;
+            #elif defined(LIGHTING)
+            vec3 normal = normalize(Normal);
+            vec3 viewDir = normalize(viewPos - FragPos);
             
-            if (useTexture) {
-                vec4 texColor = texture(texture1, TexCoord);
-                result *= texColor.rgb;
+            #ifdef CLUSTERED
+            // Só as luzes atribuídas ao cluster deste fragmento
+            ivec2 tile = min(ivec2(gl_FragCoord.xy / clusterTileSize), clusterDims.xy - 1);
+            int slice = clamp(int(log(ViewDepth) * clusterDepthParams.x + clusterDepthParams.y), 0, clusterDims.z - 1);
+            int cluster = (slice * clusterDims.y + tile.y) * clusterDims.x + tile.x;
+            uvec2 range = texelFetch(clusterGrid, cluster).xy;
+            for (uint i = 0u; i < range.y; i++) {
+                int light = int(texelFetch(clusterIndices, int(range.x + i)).r);
+                vec4 positionRadius = texelFetch(clusterLights, light * 2);
+                vec3 color = texelFetch(clusterLights, light * 2 + 1).rgb;
+                result += calculateLight(positionRadius.xyz, color, positionRadius.w, normal, FragPos, viewDir) * baseColor;
             }
+            #else
+            // Calcular todas as luzes (limite constante, o compilador desenrola o laço)
+            for (int i = 0; i < NUM_LIGHTS; i++) {
+                result += calculateLight(lights[i].position, lights[i].color * lights[i].intensity,
+                                         lights[i].radius, normal, FragPos, viewDir) * baseColor;
+            }
+            #endif
+            #endif
+            
+            #ifdef TEXTURE
+            #ifdef TEXTURE_ARRAY
+            vec4 texColor = texture(texture1, vec3(TexCoord, TexLayer));
+            #else
+            vec4 texColor = texture(texture1, TexCoord);
+            #endif
+            result *= texColor.rgb;
+            #endif
             
             FragColor = vec4(result, 1.0);
         }
     )";
 
-    // Compilar shader
-    GLuint compileShader(GLenum type, const char* source);
-    
-    // Criar programa de shader
-    bool createShaderProgram();
+    // Acima disso o shader usa as listas por cluster em vez do array de uniforms
+    static const int MAX_UNIFORM_LIGHTS = 8;
+
+    // Enviar luzes habilitadas para o programa ativo
+    void uploadLights();
+
+    // Reatribuir as luzes habilitadas aos clusters com a câmera atual
+    void buildClusters();
 
 public:
     Lighting();
     ~Lighting();
     
     bool initialize();
+    // Compilar de uma vez (em paralelo no driver) as variantes usadas quando
+    // iluminação e/ou texturas forem ligadas; as já compiladas são puladas
+    void prepareVariants(bool lightingEnabled, bool textureEnabled);
     void addOmnidirectionalLight(glm::vec3 position, glm::vec3 color, float intensity);
     void addSpotLight(glm::vec3 position, glm::vec3 color, float intensity, float radius);
     void setViewPosition(glm::vec3 viewPos);
-    void useShader();
+    
+    // Câmera e viewport usados na divisão em clusters (reatribui só quando mudam)
+    void setCamera(const glm::mat4& view, float fovY, float aspect, float nearPlane, float farPlane);
+    void setViewport(int width, int height);
+    
+    // Substituir as luzes por "count" luzes pontuais aleatórias (semente fixa), com
+    // raio decrescente para manter o número de luzes por fragmento aproximadamente constante
+    void generateLights(int count);
+    
+    // Forçar o caminho por clusters mesmo com poucas luzes
+    void setClusteredShading(bool force) { forceClustered = force; }
+    bool isClusteredShading() const { return forceClustered || getEnabledLightCount() > MAX_UNIFORM_LIGHTS; }
+    
+    // Ativar a variante de shader especializada para o modo pedido. perVertex
+    // avalia as luzes nos vértices (Gouraud); ignorado no caminho por clusters.
+    // animation escolhe de onde o vertex shader tira a matriz de cada triângulo e
+    // pulledVertices lê os vértices do registro por triângulo em vez dos atributos.
+    // Variante que não compila cai para a básica do mesmo caminho de geometria;
+    // se nem essa existir, getShaderProgram() fica 0 e o desenho deve ser pulado
+    void useVariant(bool lightingEnabled, bool textureEnabled, bool textureArray = false, bool perVertex = false,
+                    AnimationPath animation = AnimationPath::CPU, bool pulledVertices = false);
+    
+    // Ligar as listas por cluster em outro programa (passada de luzes do caminho adiado)
+    void bindClusters(GLuint program);
     void cleanup();
     
-    GLuint getShaderProgram() const { return shaderProgram; }
+    GLuint getShaderProgram() const { return activeProgram; }
+    // Variante realmente usada no último desenho ("-" se ele foi pulado)
+    std::string getActiveVariantName() const { return activeProgram ? activeKey.name() : "-"; }
     int getLightCount() const { return lights.size(); }
+    // Número de luzes habilitadas (vira o NUM_LIGHTS da variante)
+    int getEnabledLightCount() const;
+    double getClusterBuildMs() const { return clusters ? clusters->getLastBuildMs() : 0.0; }
 };
 
 #endif
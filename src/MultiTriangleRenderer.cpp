@@ -1,9 +1,14 @@
 #include "MultiTriangleRenderer.h"
+#include "ProgramCache.h"
+#include "AssetCache.h"
+#include "GLStateCache.h"
+#include "GLProfiler.h"
+#include "StartupProfile.h"
 #include <iostream>
 #include <cmath>
 #include <algorithm>
 
-MultiTriangleRenderer::MultiTriangleRenderer() : VAO(0), VBO(0), shaderProgram(0), rng(std::random_device{}()) {
+MultiTriangleRenderer::MultiTriangleRenderer() : VAO(0), VBO(0), shaderProgram(0), rng(SCENE_SEED) {
 }
 
 MultiTriangleRenderer::~MultiTriangleRenderer() {
@@ -11,6 +16,7 @@ MultiTriangleRenderer::~MultiTriangleRenderer() {
 }
 
 bool MultiTriangleRenderer::initialize() {
+    StartupProfile::Scope phase("Renderer");
     // Criar programa de shader
     if (!createShaderProgram()) {
         return false;
@@ -21,11 +27,11 @@ bool MultiTriangleRenderer::initialize() {
 
     // Gerar e vincular VAO
     glGenVertexArrays(1, &VAO);
-    glBindVertexArray(VAO);
+    GLStateCache::bindVertexArray(VAO);
 
     // Gerar e vincular VBO
     glGenBuffers(1, &VBO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    GLStateCache::bindBuffer(GL_ARRAY_BUFFER, VBO);
 
     // Configurar atributos de vértice
     // Atributo de posição (location = 0)
@@ -37,19 +43,26 @@ bool MultiTriangleRenderer::initialize() {
     glEnableVertexAttribArray(1);
 
     // Desvincular VAO
-    glBindVertexArray(0);
+    GLStateCache::bindVertexArray(0);
 
     std::cout << "MultiTriangleRenderer inicializado com sucesso!" << std::endl;
     return true;
 }
 
-void MultiTriangleRenderer::setTriangleCount(int count) {
+void MultiTriangleRenderer::setTriangleCount(int64_t count) {
     if (count <= 0) return;
-    
-    generateTriangles(count);
+    StartupProfile::Scope phase("Cena");
     
     // Atualizar buffer de vértices
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    GLStateCache::bindBuffer(GL_ARRAY_BUFFER, VBO);
+    
+    // Conjuntos já gerados em execuções anteriores vêm do cache, sem gerar nem montar vértices
+    if (loadCachedTriangles(count)) {
+        std::cout << "Triângulos configurados: " << count << " (cache)" << std::endl;
+        return;
+    }
+    
+    generateTriangles(count);
     
     // Criar dados de vértices para todos os triângulos
     std::vector<float> vertices;
@@ -82,13 +95,55 @@ void MultiTriangleRenderer::setTriangleCount(int count) {
     }
     
     glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_DYNAMIC_DRAW);
+    storeCachedTriangles(vertices);
     
     std::cout << "Triângulos configurados: " << count << std::endl;
 }
 
+bool MultiTriangleRenderer::loadCachedTriangles(size_t count) {
+    MappedAsset asset;
+    if (!AssetCache::open("triangles_basic_seed" + std::to_string(SCENE_SEED), ASSET_TRIANGLES, asset)) {
+        if (AssetCache::isEnabled()) {
+            AssetCache::recordMiss();
+        }
+        return false;
+    }
+    
+    // Entrada menor que o pedido ou gravada com outro layout: gerar e substituir
+    const AssetHeader& header = asset.getHeader();
+    if (header.params[0] < count || header.params[1] != SCENE_SEED ||
+        header.params[2] != sizeof(Triangle) || header.params[3] != 18 || asset.getChunkCount() != 2 ||
+        asset.getChunk(0).size < count * sizeof(Triangle) ||
+        asset.getChunk(1).size < count * 18 * sizeof(float)) {
+        AssetCache::recordMiss();
+        return false;
+    }
+    
+    const Triangle* cached = static_cast<const Triangle*>(asset.getChunkData(0));
+    triangles.assign(cached, cached + count);
+    glBufferData(GL_ARRAY_BUFFER, count * 18 * sizeof(float), asset.getChunkData(1), GL_DYNAMIC_DRAW);
+    AssetCache::recordHit();
+    return true;
+}
+
+void MultiTriangleRenderer::storeCachedTriangles(const std::vector<float>& vertices) {
+    if (!AssetCache::isEnabled()) {
+        return;
+    }
+    
+    uint32_t params[8] = {(uint32_t)triangles.size(), SCENE_SEED, sizeof(Triangle), 18};
+    AssetWriter writer;
+    if (writer.begin(AssetCache::pathFor("triangles_basic_seed" + std::to_string(SCENE_SEED)),
+                     ASSET_TRIANGLES, params)) {
+        writer.addChunk(triangles.data(), triangles.size() * sizeof(Triangle));
+        writer.addChunk(vertices.data(), vertices.size() * sizeof(float));
+        writer.finish();
+    }
+}
+
 void MultiTriangleRenderer::render(float deltaTime) {
-    glUseProgram(shaderProgram);
-    glBindVertexArray(VAO);
+    GLStateCache::useProgram(shaderProgram);
+    GLStateCache::bindVertexArray(VAO);
     
     // Renderizar cada triângulo com sua própria rotação
     for (size_t i = 0; i < triangles.size(); ++i) {
@@ -118,19 +173,18 @@ void MultiTriangleRenderer::render(float deltaTime) {
         // Desenhar triângulo
         glDrawArrays(GL_TRIANGLES, i * 3, 3);
     }
-    
-    glBindVertexArray(0);
 }
 
-void MultiTriangleRenderer::generateTriangles(int count) {
+void MultiTriangleRenderer::generateTriangles(size_t count) {
     triangles.clear();
     triangles.reserve(count);
+    rng.seed(SCENE_SEED);
     
     std::uniform_real_distribution<float> posDist(-0.8f, 0.8f);
     std::uniform_real_distribution<float> colorDist(0.5f, 1.0f);
     std::uniform_real_distribution<float> speedDist(0.5f, 2.0f);
     
-    for (int i = 0; i < count; ++i) {
+    for (size_t i = 0; i < count; ++i) {
         Triangle triangle;
         triangle.x = posDist(rng);
         triangle.y = posDist(rng);
@@ -147,15 +201,15 @@ void MultiTriangleRenderer::generateTriangles(int count) {
 
 void MultiTriangleRenderer::cleanup() {
     if (VAO) {
-        glDeleteVertexArrays(1, &VAO);
+        GLStateCache::deleteVertexArrays(1, &VAO);
         VAO = 0;
     }
     if (VBO) {
-        glDeleteBuffers(1, &VBO);
+        GLStateCache::deleteBuffers(1, &VBO);
         VBO = 0;
     }
     if (shaderProgram) {
-        glDeleteProgram(shaderProgram);
+        GLStateCache::deleteProgram(shaderProgram);
         shaderProgram = 0;
     }
 }
@@ -180,6 +234,12 @@ GLuint MultiTriangleRenderer::compileShader(GLenum type, const char* source) {
 }
 
 bool MultiTriangleRenderer::createShaderProgram() {
+    // Reaproveitar o binário salvo na execução anterior, se houver
+    shaderProgram = ProgramCache::load(vertexShaderSource, fragmentShaderSource);
+    if (shaderProgram) {
+        return true;
+    }
+
     // Compilar shaders
     GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertexShaderSource);
     GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentShaderSource);
@@ -192,6 +252,7 @@ bool MultiTriangleRenderer::createShaderProgram() {
     shaderProgram = glCreateProgram();
     glAttachShader(shaderProgram, vertexShader);
     glAttachShader(shaderProgram, fragmentShader);
+    ProgramCache::prepareForLink(shaderProgram);
     glLinkProgram(shaderProgram);
 
     // Verificar erros de linking
@@ -211,5 +272,7 @@ bool MultiTriangleRenderer::createShaderProgram() {
     glDeleteShader(vertexShader);
     glDeleteShader(fragmentShader);
 
+    ProgramCache::store(shaderProgram, vertexShaderSource, fragmentShaderSource);
+
     return true;
 }
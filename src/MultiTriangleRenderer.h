@@ -5,6 +5,7 @@
 #include <vector>
 #include <string>
 #include <random>
+#include <cstdint>
 
 struct Triangle {
     float x, y, z;
@@ -52,19 +53,27 @@ private:
     // Criar programa de shader
     bool createShaderProgram();
     
+    // Semente fixa: o conjunto de N triângulos é prefixo do conjunto de M > N,
+    // então uma única entrada no cache de assets atende qualquer contagem menor
+    static const uint32_t SCENE_SEED = 1337;
+
     // Gerar triângulos aleatórios
-    void generateTriangles(int count);
+    void generateTriangles(size_t count);
+
+    // Mapear o maior conjunto salvo e enviar o prefixo pedido direto ao VBO
+    bool loadCachedTriangles(size_t count);
+    void storeCachedTriangles(const std::vector<float>& vertices);
 
 public:
     MultiTriangleRenderer();
     ~MultiTriangleRenderer();
     
     bool initialize();
-    void setTriangleCount(int count);
+    void setTriangleCount(int64_t count);
     void render(float deltaTime);
     void cleanup();
     
-    int getTriangleCount() const { return triangles.size(); }
+    int64_t getTriangleCount() const { return triangles.size(); }
 };
 
 #endif
@@ -0,0 +1,179 @@
+#include "OverdrawAnalyzer.h"
+#include "GLStateCache.h"
+#include "GLProfiler.h"
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <cstdlib>
+
+OverdrawAnalyzer::OverdrawAnalyzer() : framebuffer(0), countTexture(0), width(0), height(0), frameCounter(0),
+                                       previousFramebuffer(0), previousDepthTest(true), previousBlend(false),
+                                       previousBlendFunc{GL_ONE, GL_ZERO, GL_ONE, GL_ZERO},
+                                       averageOverdraw(0.0), maxOverdraw(0.0), variants(nullptr) {
+}
+
+OverdrawAnalyzer::~OverdrawAnalyzer() {
+    cleanup();
+}
+
+bool OverdrawAnalyzer::isRequested() {
+    const char* env = std::getenv("GLPERF_OVERDRAW");
+    return env && std::string(env) == "1";
+}
+
+bool OverdrawAnalyzer::initialize() {
+    variants = new ShaderVariantCache(vertexShaderSource, fragmentShaderSource, "overdraw");
+    if (!variants->build({ShaderVariantKey()})) {
+        std::cerr << "Erro ao criar shader de contagem de overdraw" << std::endl;
+        return false;
+    }
+
+    glGenFramebuffers(1, &framebuffer);
+    std::cout << "Instrumentação de overdraw inicializada (medição a cada "
+              << SAMPLE_INTERVAL << " frames)" << std::endl;
+    return framebuffer != 0;
+}
+
+bool OverdrawAnalyzer::resize(int newWidth, int newHeight) {
+    destroyTarget();
+    width = newWidth;
+    height = newHeight;
+
+    glGenTextures(1, &countTexture);
+    GLStateCache::bindTexture(GL_TEXTURE_2D, countTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, width, height, 0, GL_RED, GL_FLOAT, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    GLStateCache::bindTexture(GL_TEXTURE_2D, 0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, countTexture, 0);
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, previousFramebuffer);
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "Alvo de overdraw R32F incompleto (status 0x" << std::hex << status << std::dec << ")" << std::endl;
+        destroyTarget();
+        return false;
+    }
+
+    counts.resize((size_t)width * height);
+    return true;
+}
+
+bool OverdrawAnalyzer::shouldSample() {
+    return frameCounter++ % SAMPLE_INTERVAL == 0;
+}
+
+GLuint OverdrawAnalyzer::begin(int viewportWidth, int viewportHeight, AnimationPath animation,
+                               bool pulledVertices) {
+    GLuint program = variants->get(ShaderVariantKey(false, false, 0, false, false, false, animation, pulledVertices));
+    if (!program) {
+        return 0;
+    }
+
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousFramebuffer);
+    if ((viewportWidth != width || viewportHeight != height || !countTexture) &&
+        !resize(viewportWidth, viewportHeight)) {
+        return 0;
+    }
+
+    previousDepthTest = GLStateCache::isDepthTestEnabled();
+    previousBlend = GLStateCache::isBlendEnabled();
+    GLStateCache::getBlendFunc(previousBlendFunc);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    GLfloat clearColor[4];
+    glGetFloatv(GL_COLOR_CLEAR_VALUE, clearColor);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    glClearColor(clearColor[0], clearColor[1], clearColor[2], clearColor[3]);
+
+    // Todo fragmento rasterizado conta, inclusive os que o teste de profundidade descartaria
+    GLStateCache::setDepthTest(false);
+    GLStateCache::setBlend(true);
+    GLStateCache::blendFunc(GL_ONE, GL_ONE);
+
+    GLStateCache::useProgram(program);
+    return program;
+}
+
+void OverdrawAnalyzer::end() {
+    glReadPixels(0, 0, width, height, GL_RED, GL_FLOAT, counts.data());
+    glBindFramebuffer(GL_FRAMEBUFFER, previousFramebuffer);
+    GLStateCache::setDepthTest(previousDepthTest);
+    GLStateCache::setBlend(previousBlend);
+    GLStateCache::blendFuncSeparate(previousBlendFunc[0], previousBlendFunc[1], previousBlendFunc[2], previousBlendFunc[3]);
+
+    double total = 0.0;
+    float maximum = 0.0f;
+    for (float count : counts) {
+        total += count;
+        maximum = std::max(maximum, count);
+    }
+    averageOverdraw = counts.empty() ? 0.0 : total / counts.size();
+    maxOverdraw = maximum;
+}
+
+bool OverdrawAnalyzer::writeHeatmap(const std::string& path) const {
+    if (counts.empty()) {
+        std::cerr << "Nenhuma medição de overdraw para gravar" << std::endl;
+        return false;
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Erro ao criar mapa de overdraw: " << path << std::endl;
+        return false;
+    }
+
+    file << "P6\n" << width << " " << height << "\n255\n";
+    std::vector<unsigned char> row(width * 3);
+    float scale = maxOverdraw > 0 ? 1.0f / maxOverdraw : 0.0f;
+
+    // PPM começa pela linha de cima; o GL pela de baixo
+    for (int y = height - 1; y >= 0; --y) {
+        for (int x = 0; x < width; ++x) {
+            float t = counts[(size_t)y * width + x] * scale;
+            float r, g, b;
+            if (t <= 0.0f) {
+                r = g = b = 0.0f;
+            } else if (t < 0.25f) {
+                r = 0.0f; g = 0.0f; b = t * 4.0f;
+            } else if (t < 0.5f) {
+                r = 0.0f; g = (t - 0.25f) * 4.0f; b = 1.0f - (t - 0.25f) * 4.0f;
+            } else if (t < 0.75f) {
+                r = (t - 0.5f) * 4.0f; g = 1.0f; b = 0.0f;
+            } else {
+                r = 1.0f; g = 1.0f - (t - 0.75f) * 4.0f; b = 0.0f;
+            }
+            row[x * 3 + 0] = (unsigned char)(std::min(r, 1.0f) * 255.0f);
+            row[x * 3 + 1] = (unsigned char)(std::min(g, 1.0f) * 255.0f);
+            row[x * 3 + 2] = (unsigned char)(std::min(b, 1.0f) * 255.0f);
+        }
+        file.write(reinterpret_cast<const char*>(row.data()), row.size());
+    }
+
+    std::cout << "Mapa de overdraw gravado: " << path << " (médio " << averageOverdraw
+              << ", máximo " << maxOverdraw << ")" << std::endl;
+    return true;
+}
+
+void OverdrawAnalyzer::destroyTarget() {
+    if (countTexture) {
+        GLStateCache::deleteTextures(1, &countTexture);
+        countTexture = 0;
+    }
+    width = height = 0;
+}
+
+void OverdrawAnalyzer::cleanup() {
+    destroyTarget();
+    if (framebuffer) {
+        glDeleteFramebuffers(1, &framebuffer);
+        framebuffer = 0;
+    }
+    if (variants) {
+        delete variants;
+        variants = nullptr;
+    }
+}
@@ -0,0 +1,85 @@
+#ifndef OVERDRAWANALYZER_H
+#define OVERDRAWANALYZER_H
+
+#include <GL/glew.h>
+#include <string>
+#include <vector>
+#include "ShaderVariants.h"
+
+// Instrumentação de overdraw: a cena é desenhada de novo em um alvo R32F com
+// blending aditivo (GL_ONE, GL_ONE) e sem teste de profundidade, então cada
+// pixel acumula quantos fragmentos foram rasterizados sobre ele. O alvo é lido
+// na CPU para calcular overdraw médio e máximo e gerar o mapa de calor (PPM).
+//
+// A passada extra e o glReadPixels custam caro; por isso a medição roda a cada
+// SAMPLE_INTERVAL frames. Ligar com GLPERF_OVERDRAW=1 ou setOverdrawAnalysis().
+class OverdrawAnalyzer {
+public:
+    static const int SAMPLE_INTERVAL = 30;
+
+private:
+    GLuint framebuffer, countTexture;
+    int width, height;
+    int frameCounter;
+
+    // Estado restaurado em end()
+    GLint previousFramebuffer;
+    bool previousDepthTest, previousBlend;
+    GLenum previousBlendFunc[4];   // src/dst RGB, src/dst alfa
+
+    std::vector<float> counts;   // Última leitura (linhas de baixo para cima, como no GL)
+    double averageOverdraw;
+    double maxOverdraw;
+
+    ShaderVariantCache* variants;
+
+    const char* vertexShaderSource = R"(
+        uniform mat4 view;
+        uniform mat4 projection;   // aPos e "transform" vêm de ShaderVariantCache (VertexPulling, TriangleAnimation)
+
+        invariant gl_Position;
+
+        void main() {
+            gl_Position = projection * view * transform * vec4(aPos, 1.0);
+        }
+    )";
+
+    const char* fragmentShaderSource = R"(
+        out float FragCount;
+
+        void main() {
+            FragCount = 1.0;
+        }
+    )";
+
+    bool resize(int newWidth, int newHeight);
+    void destroyTarget();
+
+public:
+    OverdrawAnalyzer();
+    ~OverdrawAnalyzer();
+
+    bool initialize();
+
+    // true quando este frame deve ser medido (a cada SAMPLE_INTERVAL chamadas)
+    bool shouldSample();
+
+    // Ligar o alvo de contagem e o programa; retorna o programa (0 em caso de erro)
+    GLuint begin(int viewportWidth, int viewportHeight, AnimationPath animation = AnimationPath::CPU,
+                 bool pulledVertices = false);
+
+    // Ler o alvo, atualizar médio/máximo e restaurar o estado anterior
+    void end();
+
+    // Mapa de calor (preto -> azul -> verde -> amarelo -> vermelho) normalizado pelo máximo
+    bool writeHeatmap(const std::string& path) const;
+    void cleanup();
+
+    double getAverageOverdraw() const { return averageOverdraw; }
+    double getMaxOverdraw() const { return maxOverdraw; }
+
+    // GLPERF_OVERDRAW=1 liga a instrumentação desde o início
+    static bool isRequested();
+};
+
+#endif
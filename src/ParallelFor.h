@@ -0,0 +1,44 @@
+#ifndef PARALLELFOR_H
+#define PARALLELFOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// Divide o intervalo [begin, end) em blocos contíguos, um por núcleo, e
+// executa fn(blockBegin, blockEnd) em cada bloco. Intervalos menores que
+// minPerThread rodam na thread atual.
+template <typename Fn>
+void parallelFor(size_t begin, size_t end, Fn fn, size_t minPerThread = 1) {
+    if (end <= begin) return;
+
+    size_t count = end - begin;
+    size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    size_t threadCount = std::min(hardware, std::max<size_t>(1, count / std::max<size_t>(1, minPerThread)));
+
+    if (threadCount <= 1) {
+        fn(begin, end);
+        return;
+    }
+
+    size_t blockSize = (count + threadCount - 1) / threadCount;
+    std::vector<std::thread> workers;
+    workers.reserve(threadCount - 1);
+
+    for (size_t t = 1; t < threadCount; ++t) {
+        size_t blockBegin = begin + t * blockSize;
+        size_t blockEnd = std::min(end, blockBegin + blockSize);
+        if (blockBegin >= blockEnd) break;
+        workers.emplace_back(fn, blockBegin, blockEnd);
+    }
+
+    // O primeiro bloco roda na thread chamadora
+    fn(begin, std::min(end, begin + blockSize));
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+#endif
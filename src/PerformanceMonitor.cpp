@@ -1,35 +1,181 @@
 #include "PerformanceMonitor.h"
+#include "GLStateCache.h"
+#include "ProgramCache.h"
+#include "AssetCache.h"
+#include "GLProfiler.h"
+#include "FrameArena.h"
+#include "StagingPool.h"
+#include "StartupProfile.h"
 #include <iostream>
 #include <fstream>
+#include <algorithm>
+#include <map>
+#include <set>
 #include <sstream>
+#include <cstdio>
+#include <cstring>
 #include <sys/stat.h>
 #include <unistd.h>
 
-PerformanceMonitor::PerformanceMonitor() {
+namespace {
+
+// Ordem das colunas Vertices_Submitted ... FS_Invocations
+const GLenum PIPELINE_TARGETS[] = {
+    GL_VERTICES_SUBMITTED_ARB,
+    GL_PRIMITIVES_SUBMITTED_ARB,
+    GL_VERTEX_SHADER_INVOCATIONS_ARB,
+    GL_CLIPPING_INPUT_PRIMITIVES_ARB,
+    GL_CLIPPING_OUTPUT_PRIMITIVES_ARB,
+    GL_FRAGMENT_SHADER_INVOCATIONS_ARB
+};
+
+}
+
+PerformanceMonitor::PerformanceMonitor() : cpuCores(0), systemInfoPrinted(false), timeToFirstFrame(-1.0), currentPhase("-"),
+                                           pipelineStatsAvailable(false), pipelineQueries{},
+                                           pipelineQueryPending{}, pipelineQuerySet(0),
+                                           pipelineQueryActive(false), pipelineTotals{}, pipelineFrames(0),
+                                           lastIssued(0), lastElided(0), lastCacheFrames(0),
+                                           lastProfiledCalls(0), lastProfiledBytes(0), lastProfiledNs(0),
+                                           lastProfiledFrames(0), sharedTelemetry(nullptr), sharedFrame{},
+                                           frameIssued(0), frameElided(0) {
     startTime = std::chrono::high_resolution_clock::now();
+    sharedFrame.cpuUsage = sharedFrame.gpuUsage = -1.0;
+    std::strncpy(sharedFrame.phase, currentPhase.c_str(), sizeof(sharedFrame.phase) - 1);
 }
 
 PerformanceMonitor::~PerformanceMonitor() {
+    waitSystemInfo();
+    delete sharedTelemetry;
+    if (pipelineStatsAvailable) {
+        glDeleteQueries(PIPELINE_QUERY_SETS * PIPELINE_COUNTERS, &pipelineQueries[0][0]);
+    }
+}
+
+void PerformanceMonitor::querySystemInfo() {
+    if (systemInfoThread.joinable() || !cpuInfo.empty()) {
+        return;
+    }
+    systemInfoThread = std::thread([this]() {
+        StartupProfile::Scope phase("Informações do sistema (lspci)");
+        cpuInfo = getCPUInfo();
+        gpuInfo = getGPUInfo();
+        cpuCores = getCPUCoreCount();
+    });
+}
+
+void PerformanceMonitor::waitSystemInfo() {
+    if (systemInfoThread.joinable()) {
+        systemInfoThread.join();
+    }
 }
 
 void PerformanceMonitor::initialize() {
-    cpuInfo = getCPUInfo();
-    gpuInfo = getGPUInfo();
-    cpuCores = getCPUCoreCount();
-    
-    std::cout << "\n=== Informações do Sistema ===" << std::endl;
-    std::cout << "CPU: " << cpuInfo << std::endl;
-    std::cout << "GPU: " << gpuInfo << std::endl;
-    std::cout << "Núcleos CPU: " << cpuCores << std::endl;
+    StartupProfile::Scope phase("Monitor");
+    
+    // CPU e GPU são impressas no primeiro frame, quando a thread de fundo já terminou
+    querySystemInfo();
+    
+    std::cout << "\n=== Monitor de Performance ===" << std::endl;
+    
+    // Requer contexto GL atual (initialize() é chamado depois da janela)
+    pipelineStatsAvailable = GLEW_ARB_pipeline_statistics_query;
+    if (pipelineStatsAvailable) {
+        glGenQueries(PIPELINE_QUERY_SETS * PIPELINE_COUNTERS, &pipelineQueries[0][0]);
+    }
+    std::cout << "Estatísticas do pipeline: "
+              << (pipelineStatsAvailable ? "disponíveis" : "indisponíveis (sem GL_ARB_pipeline_statistics_query)")
+              << std::endl;
+    
+    if (SharedTelemetry::isRequested()) {
+        sharedTelemetry = new SharedTelemetry();
+        if (!sharedTelemetry->initialize()) {
+            delete sharedTelemetry;
+            sharedTelemetry = nullptr;
+        }
+    }
     std::cout << "===============================" << std::endl;
 }
 
+void PerformanceMonitor::beginPipelineQueries() {
+    if (!pipelineStatsAvailable || pipelineQueryActive) {
+        return;
+    }
+    
+    // O conjunto que vai ser reutilizado foi emitido PIPELINE_QUERY_SETS frames atrás
+    collectPipelineQueries(pipelineQuerySet);
+    for (int i = 0; i < PIPELINE_COUNTERS; ++i) {
+        glBeginQuery(PIPELINE_TARGETS[i], pipelineQueries[pipelineQuerySet][i]);
+    }
+    pipelineQueryActive = true;
+}
+
+void PerformanceMonitor::endPipelineQueries() {
+    if (!pipelineQueryActive) {
+        return;
+    }
+    
+    for (int i = 0; i < PIPELINE_COUNTERS; ++i) {
+        glEndQuery(PIPELINE_TARGETS[i]);
+    }
+    pipelineQueryPending[pipelineQuerySet] = true;
+    pipelineQuerySet = (pipelineQuerySet + 1) % PIPELINE_QUERY_SETS;
+    pipelineQueryActive = false;
+}
+
+void PerformanceMonitor::collectPipelineQueries(int set) {
+    if (!pipelineQueryPending[set]) {
+        return;
+    }
+    pipelineQueryPending[set] = false;
+    
+    // Frames cujo resultado ainda não chegou são descartados (a média usa só os lidos)
+    for (int i = 0; i < PIPELINE_COUNTERS; ++i) {
+        GLuint available = 0;
+        glGetQueryObjectuiv(pipelineQueries[set][i], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) {
+            return;
+        }
+    }
+    for (int i = 0; i < PIPELINE_COUNTERS; ++i) {
+        GLuint64 value = 0;
+        glGetQueryObjectui64v(pipelineQueries[set][i], GL_QUERY_RESULT, &value);
+        pipelineTotals[i] += value;
+    }
+    pipelineFrames++;
+}
+
 void PerformanceMonitor::update() {
-    // Esta função será chamada a cada frame para monitoramento contínuo
-    // Por enquanto, apenas registra o timestamp
+    GLStateCache::endFrame();
+    GLProfiler::endFrame();
+    
+    if (!sharedTelemetry) {
+        return;
+    }
+    
+    // steady_clock vem do vDSO: o frame publicado não custa nenhuma syscall
+    auto now = std::chrono::steady_clock::now();
+    if (sharedFrame.frame > 0) {
+        sharedFrame.frameMs = std::chrono::duration<double, std::milli>(now - lastUpdate).count();
+    }
+    lastUpdate = now;
+    sharedFrame.frame++;
+    sharedFrame.timestamp = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - startTime).count();
+    sharedFrame.glCallsIssued = (double)(GLStateCache::getIssued() - frameIssued);
+    sharedFrame.glCallsElided = (double)(GLStateCache::getElided() - frameElided);
+    frameIssued = GLStateCache::getIssued();
+    frameElided = GLStateCache::getElided();
+    sharedTelemetry->publish(sharedFrame);
 }
 
-void PerformanceMonitor::addDataPoint(double fps, int triangleCount, bool hasLighting, bool hasTextures) {
+void PerformanceMonitor::setPhase(const std::string& name) {
+    currentPhase = name;
+    std::memset(sharedFrame.phase, 0, sizeof(sharedFrame.phase));
+    std::strncpy(sharedFrame.phase, name.c_str(), sizeof(sharedFrame.phase) - 1);
+}
+
+void PerformanceMonitor::addDataPoint(double fps, int64_t triangleCount, bool hasLighting, bool hasTextures,
+                                      const RenderStats& stats) {
     auto now = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(now - startTime);
     
@@ -41,13 +187,122 @@ void PerformanceMonitor::addDataPoint(double fps, int triangleCount, bool hasLig
     data.triangleCount = triangleCount;
     data.hasLighting = hasLighting;
     data.hasTextures = hasTextures;
+    data.stats = stats;
+    data.phase = currentPhase;
+    
+    // Média por frame desde a medição anterior
+    if (pipelineFrames > 0) {
+        data.pipeline.verticesSubmitted = (double)pipelineTotals[0] / pipelineFrames;
+        data.pipeline.primitivesSubmitted = (double)pipelineTotals[1] / pipelineFrames;
+        data.pipeline.vertexShaderInvocations = (double)pipelineTotals[2] / pipelineFrames;
+        data.pipeline.clippingInputPrimitives = (double)pipelineTotals[3] / pipelineFrames;
+        data.pipeline.clippingOutputPrimitives = (double)pipelineTotals[4] / pipelineFrames;
+        data.pipeline.fragmentShaderInvocations = (double)pipelineTotals[5] / pipelineFrames;
+        data.pipeline.frames = pipelineFrames;
+    }
+    std::fill(pipelineTotals, pipelineTotals + PIPELINE_COUNTERS, 0);
+    pipelineFrames = 0;
+    
+    uint64_t cacheFrames = GLStateCache::getFrames() - lastCacheFrames;
+    data.glCallsIssued = cacheFrames ? (double)(GLStateCache::getIssued() - lastIssued) / cacheFrames : 0.0;
+    data.glCallsElided = cacheFrames ? (double)(GLStateCache::getElided() - lastElided) / cacheFrames : 0.0;
+    lastIssued = GLStateCache::getIssued();
+    lastElided = GLStateCache::getElided();
+    lastCacheFrames = GLStateCache::getFrames();
+    
+    GLProfiler::Totals profiled = GLProfiler::getTotals();
+    uint64_t profiledFrames = GLProfiler::getFrames() - lastProfiledFrames;
+    data.glProfiledCalls = data.glUploadBytes = data.glDriverMs = 0.0;
+    if (profiledFrames > 0) {
+        data.glProfiledCalls = (double)(profiled.calls - lastProfiledCalls) / profiledFrames;
+        data.glUploadBytes = (double)(profiled.bytes - lastProfiledBytes) / profiledFrames;
+        data.glDriverMs = (profiled.nanoseconds - lastProfiledNs) / 1e6 / profiledFrames;
+    }
+    lastProfiledCalls = profiled.calls;
+    lastProfiledBytes = profiled.bytes;
+    lastProfiledNs = profiled.nanoseconds;
+    lastProfiledFrames = GLProfiler::getFrames();
     
     dataPoints.push_back(data);
     
+    // Os próximos frames publicados carregam esta medição
+    sharedFrame.dataPoints = dataPoints.size();
+    sharedFrame.fps = fps;
+    sharedFrame.cpuUsage = data.cpuUsage;
+    sharedFrame.gpuUsage = data.gpuUsage;
+    sharedFrame.gpuFrameMs = stats.gpuFrameMs;
+    sharedFrame.triangleCount = triangleCount;
+    
     std::cout << "Dados registrados - FPS: " << fps 
               << ", Triângulos: " << triangleCount
               << ", CPU: " << data.cpuUsage << "%"
-              << ", GPU: " << data.gpuUsage << "%" << std::endl;
+              << ", GPU: " << data.gpuUsage << "%"
+              << ", Shader: " << stats.shaderVariant;
+    if (stats.overdrawAverage > 0) {
+        std::cout << ", Overdraw: " << stats.overdrawAverage << " (máx " << stats.overdrawMax << ")";
+    }
+    if (stats.gpuFrameMs > 0) {
+        std::cout << ", Escala: " << stats.resolutionScale << ", Erro: " << stats.frameTimeErrorMs << " ms";
+    }
+    std::cout << std::endl;
+}
+
+void PerformanceMonitor::recordFirstFrame(const std::string& programName) {
+    if (timeToFirstFrame >= 0) {
+        return;
+    }
+    double milliseconds = StartupProfile::elapsedMs();
+    timeToFirstFrame = milliseconds;
+    
+    waitSystemInfo();
+    if (!systemInfoPrinted) {
+        std::cout << "\n=== Informações do Sistema ===" << std::endl;
+        std::cout << getSystemInfo();
+        systemInfoPrinted = true;
+    }
+    StartupProfile::report(programName, milliseconds);
+    
+    bool cacheEnabled = ProgramCache::isEnabled();
+    bool assetCacheEnabled = AssetCache::isEnabled();
+    std::cout << "Tempo até o primeiro frame: " << milliseconds << " ms"
+              << " (cache de shaders: " << (cacheEnabled ? "ligado" : "desligado")
+              << ", acertos: " << ProgramCache::getHits()
+              << ", faltas: " << ProgramCache::getMisses()
+              << "; cache de assets: " << (assetCacheEnabled ? "ligado" : "desligado")
+              << ", acertos: " << AssetCache::getHits()
+              << ", faltas: " << AssetCache::getMisses() << ")" << std::endl;
+    
+    mkdir("data", 0755);
+    const std::string filename = "data/startup_times.csv";
+    const std::string header = "Program,Shader_Cache,Cache_Hits,Cache_Misses,"
+                               "Asset_Cache,Asset_Hits,Asset_Misses,Time_To_First_Frame_ms";
+    
+    // Arquivos com colunas antigas são preservados ao lado, não misturados
+    std::string existingHeader;
+    std::ifstream existing(filename);
+    bool newFile = !std::getline(existing, existingHeader);
+    existing.close();
+    if (!newFile && existingHeader != header) {
+        std::rename(filename.c_str(), (filename + ".old").c_str());
+        newFile = true;
+    }
+    
+    std::ofstream file(filename, std::ios::app);
+    if (!file.is_open()) {
+        std::cerr << "Erro ao gravar " << filename << std::endl;
+        return;
+    }
+    if (newFile) {
+        file << header << "\n";
+    }
+    file << programName << ","
+         << (cacheEnabled ? "true" : "false") << ","
+         << ProgramCache::getHits() << ","
+         << ProgramCache::getMisses() << ","
+         << (assetCacheEnabled ? "true" : "false") << ","
+         << AssetCache::getHits() << ","
+         << AssetCache::getMisses() << ","
+         << milliseconds << "\n";
 }
 
 std::string PerformanceMonitor::getCPUInfo() {
@@ -193,6 +448,7 @@ double PerformanceMonitor::getGPUUsage() {
 }
 
 std::string PerformanceMonitor::getSystemInfo() {
+    waitSystemInfo();
     std::ostringstream oss;
     oss << "CPU: " << cpuInfo << "\n";
     oss << "GPU: " << gpuInfo << "\n";
@@ -208,7 +464,7 @@ void PerformanceMonitor::generateCSVReport(const std::string& filename) {
     }
     
     // Cabeçalho
-    file << "Timestamp,FPS,CPU_Usage,GPU_Usage,Triangle_Count,Has_Lighting,Has_Textures\n";
+    file << "Timestamp,FPS,CPU_Usage,GPU_Usage,Triangle_Count,Has_Lighting,Has_Textures,Shader_Variant,Texture_Format,Texture_Bytes,Light_Count,Cluster_Build_ms,Lighting_Path,Shading_Tier,GBuffer_Bytes,Depth_Prepass,Front_To_Back,Sort_Scope,Depth_Spread,Fragments_Per_Pixel,Overdraw_Avg,Overdraw_Max,Resolution_Scale,GPU_Frame_ms,Frame_Time_Error_ms,Simulation_Hz,Sim_Step_ms,Vertices_Submitted,Primitives_Submitted,VS_Invocations,Clipping_Input,Clipping_Output,FS_Invocations,GL_Calls_Issued,GL_Calls_Elided,GL_Profiled_Calls,GL_Upload_Bytes,GL_Driver_ms,Arena_Allocs,Arena_Bytes,Staging_Bytes,Geometry_Bytes,Geometry_Chunks,Animation_Path,Vertex_Pulling,Stream_Textures_s,Stream_MBps,Stream_Latency_ms,Stream_CPU_ms,Texture_Size,Min_Filter,Mag_Filter,Anisotropy,UV_Scale,Shaded_Fragments,Texture_Samples_s,Texel_Rate,Phase\n";
     
     // Dados
     for (const auto& data : dataPoints) {
@@ -218,7 +474,58 @@ void PerformanceMonitor::generateCSVReport(const std::string& filename) {
              << data.gpuUsage << ","
              << data.triangleCount << ","
              << (data.hasLighting ? "true" : "false") << ","
-             << (data.hasTextures ? "true" : "false") << "\n";
+             << (data.hasTextures ? "true" : "false") << ","
+             << data.stats.shaderVariant << ","
+             << data.stats.textureFormat << ","
+             << data.stats.textureBytes << ","
+             << data.stats.lightCount << ","
+             << data.stats.clusterBuildMs << ","
+             << data.stats.lightingPath << ","
+             << data.stats.shadingTier << ","
+             << data.stats.gBufferBytes << ","
+             << (data.stats.depthPrepass ? "true" : "false") << ","
+             << (data.stats.frontToBack ? "true" : "false") << ","
+             << data.stats.sortScope << ","
+             << data.stats.depthSpread << ","
+             << data.stats.shadedFragmentsPerPixel << ","
+             << data.stats.overdrawAverage << ","
+             << data.stats.overdrawMax << ","
+             << data.stats.resolutionScale << ","
+             << data.stats.gpuFrameMs << ","
+             << data.stats.frameTimeErrorMs << ","
+             << data.stats.simulationHz << ","
+             << data.stats.simulationStepMs << ","
+             << data.pipeline.verticesSubmitted << ","
+             << data.pipeline.primitivesSubmitted << ","
+             << data.pipeline.vertexShaderInvocations << ","
+             << data.pipeline.clippingInputPrimitives << ","
+             << data.pipeline.clippingOutputPrimitives << ","
+             << data.pipeline.fragmentShaderInvocations << ","
+             << data.glCallsIssued << ","
+             << data.glCallsElided << ","
+             << data.glProfiledCalls << ","
+             << data.glUploadBytes << ","
+             << data.glDriverMs << ","
+             << data.stats.arenaAllocations << ","
+             << data.stats.arenaBytes << ","
+             << data.stats.stagingBytes << ","
+             << data.stats.geometryBytes << ","
+             << data.stats.geometryChunks << ","
+             << data.stats.animationPath << ","
+             << (data.stats.vertexPulling ? "true" : "false") << ","
+             << data.stats.streamTexturesPerSecond << ","
+             << data.stats.streamUploadMBps << ","
+             << data.stats.streamLatencyMs << ","
+             << data.stats.streamRenderThreadMs << ","
+             << data.stats.textureSize << ","
+             << data.stats.minFilter << ","
+             << data.stats.magFilter << ","
+             << data.stats.anisotropy << ","
+             << data.stats.uvScale << ","
+             << data.stats.shadedFragments << ","
+             << data.stats.textureSamplesPerSecond << ","
+             << data.stats.texelsPerSecond << ","
+             << data.phase << "\n";
     }
     
     file.close();
@@ -238,6 +545,15 @@ void PerformanceMonitor::generatePerformanceReport(const std::string& filename)
     file << "=== CONFIGURAÇÃO DO HARDWARE ===\n";
     file << getSystemInfo() << "\n";
     
+    if (timeToFirstFrame >= 0) {
+        file << "=== INICIALIZAÇÃO ===\n";
+        file << "Tempo até o primeiro frame: " << timeToFirstFrame << " ms\n";
+        file << "Cache de shaders: " << (ProgramCache::isEnabled() ? "ligado" : "desligado")
+             << " (acertos: " << ProgramCache::getHits() << ", faltas: " << ProgramCache::getMisses() << ")\n";
+        file << "Cache de assets: " << (AssetCache::isEnabled() ? "ligado" : "desligado")
+             << " (acertos: " << AssetCache::getHits() << ", faltas: " << AssetCache::getMisses() << ")\n\n";
+    }
+    
     file << "=== METODOLOGIA DOS EXPERIMENTOS ===\n";
     file << "Este relatório apresenta os resultados dos testes de desempenho realizados\n";
     file << "com diferentes configurações de renderização OpenGL.\n\n";
@@ -278,6 +594,497 @@ void PerformanceMonitor::generatePerformanceReport(const std::string& filename)
         file << "FPS - Média: " << avgFPS << ", Máximo: " << maxFPS << ", Mínimo: " << minFPS << "\n";
         file << "CPU - Média: " << avgCPU << "%, Máximo: " << maxCPU << "%, Mínimo: " << minCPU << "%\n";
         file << "GPU - Média: " << avgGPU << "%, Máximo: " << maxGPU << "%, Mínimo: " << minGPU << "%\n\n";
+        
+        // Variante de shader usada em cada medição
+        file << "=== VARIANTES DE SHADER ===\n";
+        for (const auto& data : dataPoints) {
+            file << "t=" << data.timestamp << "s, " << data.triangleCount << " triângulos, "
+                 << data.fps << " FPS: " << data.stats.shaderVariant << "\n";
+        }
+        file << "\n";
+        
+        // Custo de amostragem e memória por formato de textura
+        std::map<std::string, std::pair<double, int>> fpsByFormat;
+        std::map<std::string, size_t> bytesByFormat;
+        for (const auto& data : dataPoints) {
+            if (data.stats.textureFormat == "-") continue;
+            auto& entry = fpsByFormat[data.stats.textureFormat];
+            entry.first += data.fps;
+            entry.second++;
+            bytesByFormat[data.stats.textureFormat] = data.stats.textureBytes;
+        }
+        // Custo por número de luzes (varredura do teste extremo): só as fases em
+        // que o número de luzes variou, as demais fixam as luzes e variam triângulos
+        std::map<std::string, std::set<int>> lightCountsByPhase;
+        for (const auto& data : dataPoints) {
+            if (data.stats.lightCount > 0) {
+                lightCountsByPhase[data.phase].insert(data.stats.lightCount);
+            }
+        }
+        std::map<int, std::pair<double, int>> fpsByLights;
+        std::map<int, double> buildByLights;
+        for (const auto& data : dataPoints) {
+            if (data.stats.lightCount == 0 || lightCountsByPhase[data.phase].size() < 2) continue;
+            auto& entry = fpsByLights[data.stats.lightCount];
+            entry.first += data.fps;
+            entry.second++;
+            buildByLights[data.stats.lightCount] = data.stats.clusterBuildMs;
+        }
+        if (fpsByLights.size() > 1) {
+            file << "=== NÚMERO DE LUZES ===\n";
+            for (const auto& entry : fpsByLights) {
+                file << entry.first << " luzes - FPS médio: " << entry.second.first / entry.second.second
+                     << ", atribuição aos clusters: " << buildByLights[entry.first] << " ms\n";
+            }
+            file << "\n";
+        }
+        
+        // Overdraw efetivo: fragmentos sombreados por pixel em cada configuração de profundidade
+        std::map<std::string, std::pair<double, double>> fragmentsByDepthMode;   // (soma frag/pixel, soma FPS)
+        std::map<std::string, int> samplesByDepthMode;
+        for (const auto& data : dataPoints) {
+            if (data.stats.shadedFragmentsPerPixel <= 0) continue;
+            std::string mode = data.stats.depthPrepass ? "com pré-passada" : "sem pré-passada";
+            if (data.stats.depthSpread > 0) {
+                if (!data.stats.frontToBack) {
+                    mode += ", ordem de geração";
+                } else {
+                    mode += data.stats.sortScope == "chunk" ? ", frente para trás por bloco" : ", frente para trás";
+                }
+            } else {
+                mode += ", triângulos coplanares";
+            }
+            fragmentsByDepthMode[mode].first += data.stats.shadedFragmentsPerPixel;
+            fragmentsByDepthMode[mode].second += data.fps;
+            samplesByDepthMode[mode]++;
+        }
+        if (!fragmentsByDepthMode.empty()) {
+            file << "=== FRAGMENTOS SOMBREADOS POR PIXEL ===\n";
+            for (const auto& entry : fragmentsByDepthMode) {
+                int samples = samplesByDepthMode[entry.first];
+                file << entry.first << " - fragmentos/pixel médio: " << entry.second.first / samples
+                     << ", FPS médio: " << entry.second.second / samples
+                     << " (" << samples << " medições)\n";
+            }
+            file << "\n";
+        }
+        
+        // Custo de cada nível de shading na mesma cena (mesmo número de triângulos e luzes)
+        std::map<int64_t, std::map<std::string, std::pair<double, int>>> fpsByTier;
+        std::set<std::string> tiersSeen;
+        for (const auto& data : dataPoints) {
+            if (data.stats.shadingTier == "-") continue;
+            auto& entry = fpsByTier[data.triangleCount][data.stats.shadingTier];
+            entry.first += data.fps;
+            entry.second++;
+            tiersSeen.insert(data.stats.shadingTier);
+        }
+        if (tiersSeen.size() > 1) {
+            file << "=== NÍVEIS DE SHADING (FPS médio) ===\n";
+            for (const auto& byCount : fpsByTier) {
+                file << byCount.first << " triângulos -";
+                for (const auto& byTier : byCount.second) {
+                    file << " " << byTier.first << ": " << byTier.second.first / byTier.second.second
+                         << " (" << byTier.second.second << " medições)";
+                }
+                file << "\n";
+            }
+            file << "\n";
+        }
+        
+        // Ritmos separados: FPS é o render, Hz é a simulação na outra thread
+        std::map<int64_t, double> renderFpsByCount, simHzByCount, simStepByCount;
+        std::map<int64_t, int> simulationSamples;
+        for (const auto& data : dataPoints) {
+            if (data.stats.simulationHz <= 0) continue;
+            renderFpsByCount[data.triangleCount] += data.fps;
+            simHzByCount[data.triangleCount] += data.stats.simulationHz;
+            simStepByCount[data.triangleCount] += data.stats.simulationStepMs;
+            simulationSamples[data.triangleCount]++;
+        }
+        if (!simulationSamples.empty()) {
+            file << "=== SIMULAÇÃO x RENDER (threads separadas) ===\n";
+            for (const auto& entry : simulationSamples) {
+                int64_t count = entry.first;
+                double renderFps = renderFpsByCount[count] / entry.second;
+                double simHz = simHzByCount[count] / entry.second;
+                file << count << " triângulos - render: " << renderFps << " FPS, simulação: " << simHz
+                     << " Hz (passo " << simStepByCount[count] / entry.second << " ms), gargalo: "
+                     << (renderFps < simHz ? "render" : "simulação") << "\n";
+            }
+            file << "\n";
+        }
+        
+        // Resolução dinâmica: escala e erro de tempo médios por número de triângulos
+        std::map<int64_t, double> scaleByCount, errorByCount, gpuMsByCount;
+        std::map<int64_t, int> resolutionSamples;
+        for (const auto& data : dataPoints) {
+            if (data.stats.gpuFrameMs <= 0) continue;
+            scaleByCount[data.triangleCount] += data.stats.resolutionScale;
+            errorByCount[data.triangleCount] += data.stats.frameTimeErrorMs;
+            gpuMsByCount[data.triangleCount] += data.stats.gpuFrameMs;
+            resolutionSamples[data.triangleCount]++;
+        }
+        if (!resolutionSamples.empty()) {
+            file << "=== RESOLUÇÃO DINÂMICA ===\n";
+            int64_t fullResolutionMax = 0, withinBudgetMax = 0;
+            for (const auto& entry : resolutionSamples) {
+                int64_t count = entry.first;
+                double scale = scaleByCount[count] / entry.second;
+                double error = errorByCount[count] / entry.second;
+                file << count << " triângulos - escala média: " << scale
+                     << ", GPU: " << gpuMsByCount[count] / entry.second
+                     << " ms, erro: " << error << " ms\n";
+                if (error <= 0) {
+                    withinBudgetMax = std::max(withinBudgetMax, count);
+                    if (scale >= 1.0) fullResolutionMax = std::max(fullResolutionMax, count);
+                }
+            }
+            file << "Maior carga no orçamento em resolução cheia: " << fullResolutionMax << " triângulos\n";
+            file << "Maior carga no orçamento com resolução reduzida: " << withinBudgetMax << " triângulos\n\n";
+        }
+        
+        // Trabalho real por frame e vazão (invocações/s = por frame x FPS), comparável entre máquinas
+        std::vector<std::string> pipelinePhases;
+        std::map<std::string, PipelineStatistics> pipelineByPhase;
+        std::map<std::string, double> fsPerSecond, vsPerSecond;
+        std::map<std::string, int> pipelineSamples;
+        for (const auto& data : dataPoints) {
+            if (data.pipeline.frames == 0) continue;
+            if (pipelineSamples[data.phase]++ == 0) {
+                pipelinePhases.push_back(data.phase);
+            }
+            PipelineStatistics& sum = pipelineByPhase[data.phase];
+            sum.verticesSubmitted += data.pipeline.verticesSubmitted;
+            sum.primitivesSubmitted += data.pipeline.primitivesSubmitted;
+            sum.vertexShaderInvocations += data.pipeline.vertexShaderInvocations;
+            sum.clippingInputPrimitives += data.pipeline.clippingInputPrimitives;
+            sum.clippingOutputPrimitives += data.pipeline.clippingOutputPrimitives;
+            sum.fragmentShaderInvocations += data.pipeline.fragmentShaderInvocations;
+            fsPerSecond[data.phase] += data.pipeline.fragmentShaderInvocations * data.fps;
+            vsPerSecond[data.phase] += data.pipeline.vertexShaderInvocations * data.fps;
+        }
+        if (!pipelinePhases.empty()) {
+            file << "=== ESTATÍSTICAS DO PIPELINE (média por frame) ===\n";
+            for (const auto& phase : pipelinePhases) {
+                int samples = pipelineSamples[phase];
+                const PipelineStatistics& sum = pipelineByPhase[phase];
+                file << "Fase " << phase << " - vértices: " << sum.verticesSubmitted / samples
+                     << ", primitivas: " << sum.primitivesSubmitted / samples
+                     << ", VS: " << sum.vertexShaderInvocations / samples
+                     << ", clipping (entrada/saída): " << sum.clippingInputPrimitives / samples
+                     << "/" << sum.clippingOutputPrimitives / samples
+                     << ", FS: " << sum.fragmentShaderInvocations / samples << "\n";
+                file << "  Vazão - VS: " << vsPerSecond[phase] / samples / 1e6 << " M/s, FS: "
+                     << fsPerSecond[phase] / samples / 1e6 << " M/s\n";
+            }
+            file << "\n";
+        }
+        
+        // Trocas de estado por frame: emitidas ao driver x evitadas pelo GLStateCache
+        std::vector<std::string> cachePhases;
+        std::map<std::string, double> issuedSum, elidedSum;
+        std::map<std::string, int> cacheSamples;
+        for (const auto& data : dataPoints) {
+            if (data.glCallsIssued + data.glCallsElided <= 0) continue;
+            if (cacheSamples[data.phase]++ == 0) {
+                cachePhases.push_back(data.phase);
+            }
+            issuedSum[data.phase] += data.glCallsIssued;
+            elidedSum[data.phase] += data.glCallsElided;
+        }
+        if (!cachePhases.empty()) {
+            file << "=== CACHE DE ESTADO GL ===\n";
+            for (const auto& phase : cachePhases) {
+                double issued = issuedSum[phase] / cacheSamples[phase];
+                double elided = elidedSum[phase] / cacheSamples[phase];
+                file << "Fase " << phase << " - chamadas/frame: " << issued
+                     << " emitidas, " << elided << " evitadas ("
+                     << 100.0 * elided / (issued + elided) << "% evitadas)\n";
+            }
+            file << "\n";
+        }
+        
+        // Dados transitórios: FrameArena por frame e buffers de staging reaproveitados
+        std::vector<std::string> arenaPhases;
+        std::map<std::string, double> arenaAllocSum, arenaBytesSum;
+        std::map<std::string, size_t> stagingPeak;
+        std::map<std::string, int> arenaSamples;
+        for (const auto& data : dataPoints) {
+            if (data.stats.arenaAllocations == 0 && data.stats.stagingBytes == 0) continue;
+            if (arenaSamples[data.phase]++ == 0) {
+                arenaPhases.push_back(data.phase);
+            }
+            arenaAllocSum[data.phase] += data.stats.arenaAllocations;
+            arenaBytesSum[data.phase] += data.stats.arenaBytes;
+            stagingPeak[data.phase] = std::max(stagingPeak[data.phase], data.stats.stagingBytes);
+        }
+        if (!arenaPhases.empty()) {
+            file << "=== MEMÓRIA TRANSITÓRIA ===\n";
+            for (const auto& phase : arenaPhases) {
+                int samples = arenaSamples[phase];
+                file << "Fase " << phase << " - arena: " << arenaAllocSum[phase] / samples << " alocações/frame, "
+                     << arenaBytesSum[phase] / samples / 1024.0 << " KB/frame; staging: "
+                     << stagingPeak[phase] / (1024.0 * 1024.0) << " MB\n";
+            }
+            file << "Staging: " << StagingPool::getMapCount() << " buffers mapeados, "
+                 << StagingPool::getReuseCount() << " pedidos atendidos por reuso, pico de "
+                 << StagingPool::getPeakReservedBytes() / (1024.0 * 1024.0) << " MB; maior frame na arena: "
+                 << FrameArena::getPeakFrameBytes() / 1024.0 << " KB\n\n";
+        }
+        
+        // Maior cena de cada fase: blocos de geometria e memória de vértices na GPU
+        std::vector<std::string> geometryPhases;
+        std::map<std::string, const PerformanceData*> largestScene;
+        for (const auto& data : dataPoints) {
+            if (data.stats.geometryChunks == 0) continue;
+            const PerformanceData*& largest = largestScene[data.phase];
+            if (!largest) {
+                geometryPhases.push_back(data.phase);
+            }
+            if (!largest || data.triangleCount > largest->triangleCount) {
+                largest = &data;
+            }
+        }
+        if (!geometryPhases.empty()) {
+            file << "=== GEOMETRIA ===\n";
+            for (const auto& phase : geometryPhases) {
+                const PerformanceData& data = *largestScene[phase];
+                file << "Fase " << phase << " - maior cena: " << data.triangleCount << " triângulos em "
+                     << data.stats.geometryChunks << " bloco(s), "
+                     << data.stats.geometryBytes / (1024.0 * 1024.0) << " MB de vértices, " << data.fps << " FPS\n";
+            }
+            file << "\n";
+        }
+        
+        // Mesma cena sem iluminação/texturas com a rotação na CPU, no vertex shader e no
+        // compute shader, com atributos de vértice ou busca programável ("+pulled")
+        std::vector<std::string> animationPaths;
+        std::map<int64_t, std::map<std::string, double>> animationFpsSum;
+        std::map<int64_t, std::map<std::string, int>> animationSamples;
+        for (const auto& data : dataPoints) {
+            if (data.hasLighting || data.hasTextures || data.fps <= 0) continue;
+            std::string path = data.stats.animationPath + (data.stats.vertexPulling ? "+pulled" : "");
+            if (std::find(animationPaths.begin(), animationPaths.end(), path) == animationPaths.end()) {
+                animationPaths.push_back(path);
+            }
+            animationFpsSum[data.triangleCount][path] += data.fps;
+            animationSamples[data.triangleCount][path]++;
+        }
+        if (animationPaths.size() > 1) {
+            file << "=== ANIMAÇÃO E BUSCA DE VÉRTICES (FPS médio) ===\n";
+            for (const auto& entry : animationSamples) {
+                file << entry.first << " triângulos:";
+                for (const auto& path : animationPaths) {
+                    auto found = entry.second.find(path);
+                    if (found == entry.second.end()) continue;
+                    file << " " << path << " " << animationFpsSum[entry.first][path] / found->second;
+                }
+                file << "\n";
+            }
+            file << "\n";
+        }
+        
+        // Streaming de texturas por PBO: banda, latência e custo na thread de render,
+        // e o tempo de frame comparado à mesma cena com a textura fixa
+        std::vector<std::string> streamPhases;
+        std::map<std::string, double> streamRateSum, streamBandwidthSum, streamLatencySum, streamCpuSum;
+        std::map<std::string, int> streamSamples;
+        std::map<int64_t, double> streamFrameSum, staticFrameSum;
+        std::map<int64_t, int> streamFrameCount, staticFrameCount;
+        for (const auto& data : dataPoints) {
+            if (!data.hasTextures || data.hasLighting || data.fps <= 0) continue;
+            if (data.stats.streamTexturesPerSecond > 0) {
+                if (streamSamples[data.phase]++ == 0) {
+                    streamPhases.push_back(data.phase);
+                }
+                streamRateSum[data.phase] += data.stats.streamTexturesPerSecond;
+                streamBandwidthSum[data.phase] += data.stats.streamUploadMBps;
+                streamLatencySum[data.phase] += data.stats.streamLatencyMs;
+                streamCpuSum[data.phase] += data.stats.streamRenderThreadMs;
+                streamFrameSum[data.triangleCount] += 1000.0 / data.fps;
+                streamFrameCount[data.triangleCount]++;
+            } else if (data.stats.textureFormat == "RGBA8") {
+                staticFrameSum[data.triangleCount] += 1000.0 / data.fps;
+                staticFrameCount[data.triangleCount]++;
+            }
+        }
+        if (!streamPhases.empty()) {
+            file << "=== STREAMING DE TEXTURAS (PBO) ===\n";
+            for (const auto& phase : streamPhases) {
+                int samples = streamSamples[phase];
+                file << "Fase " << phase << " - " << streamRateSum[phase] / samples << " texturas/s, "
+                     << streamBandwidthSum[phase] / samples << " MB/s, latência "
+                     << streamLatencySum[phase] / samples << " ms, thread de render "
+                     << streamCpuSum[phase] / samples << " ms/frame\n";
+            }
+            // Só contagens medidas com e sem streaming
+            double deltaSum = 0.0;
+            int matched = 0;
+            for (const auto& entry : streamFrameSum) {
+                auto found = staticFrameCount.find(entry.first);
+                if (found == staticFrameCount.end()) continue;
+                deltaSum += entry.second / streamFrameCount[entry.first] - staticFrameSum[entry.first] / found->second;
+                matched++;
+            }
+            if (matched > 0) {
+                file << "Tempo de frame com streaming: " << (deltaSum >= 0 ? "+" : "") << deltaSum / matched
+                     << " ms em relação à textura fixa (" << matched << " contagens de triângulos)\n";
+            }
+            file << "\n";
+        }
+        
+        // Quanto do frame é gasto dentro do driver (build com ENABLE_GL_PROFILER)
+        if (GLProfiler::isEnabled() && GLProfiler::getFrames() > 0) {
+            std::vector<std::string> profilerPhases;
+            std::map<std::string, double> callsSum, bytesSum, driverSum, frameSum;
+            std::map<std::string, int> profilerSamples;
+            for (const auto& data : dataPoints) {
+                if (data.glProfiledCalls <= 0 || data.fps <= 0) continue;
+                if (profilerSamples[data.phase]++ == 0) {
+                    profilerPhases.push_back(data.phase);
+                }
+                callsSum[data.phase] += data.glProfiledCalls;
+                bytesSum[data.phase] += data.glUploadBytes;
+                driverSum[data.phase] += data.glDriverMs;
+                frameSum[data.phase] += 1000.0 / data.fps;
+            }
+            
+            file << "=== CHAMADAS AO DRIVER (ENABLE_GL_PROFILER) ===\n";
+            for (const auto& phase : profilerPhases) {
+                int samples = profilerSamples[phase];
+                file << "Fase " << phase << " - chamadas/frame: " << callsSum[phase] / samples
+                     << ", enviado: " << bytesSum[phase] / samples / 1024.0 << " KB/frame"
+                     << ", no driver: " << driverSum[phase] / samples << " ms/frame ("
+                     << 100.0 * driverSum[phase] / frameSum[phase] << "% do frame)\n";
+            }
+            
+            // Funções que mais consomem tempo no driver, na execução inteira
+            std::vector<int> byTime;
+            for (int i = 0; i < GLProfiler::CALL_COUNT; ++i) {
+                if (GLProfiler::getCalls((GLProfiler::Call)i) > 0) byTime.push_back(i);
+            }
+            std::sort(byTime.begin(), byTime.end(), [](int a, int b) {
+                return GLProfiler::getNanoseconds((GLProfiler::Call)a) > GLProfiler::getNanoseconds((GLProfiler::Call)b);
+            });
+            if (byTime.size() > 10) byTime.resize(10);
+            double frames = (double)GLProfiler::getFrames();
+            file << "Funções com mais tempo no driver (média por frame):\n";
+            for (int i : byTime) {
+                GLProfiler::Call call = (GLProfiler::Call)i;
+                file << "  " << GLProfiler::callName(call) << ": " << GLProfiler::getCalls(call) / frames
+                     << " chamadas, " << GLProfiler::getNanoseconds(call) / 1e6 / frames << " ms";
+                if (GLProfiler::getBytes(call) > 0) {
+                    file << ", " << GLProfiler::getBytes(call) / frames / 1024.0 << " KB";
+                }
+                file << "\n";
+            }
+            file << "\n";
+        }
+        
+        // Overdraw medido pela instrumentação (GLPERF_OVERDRAW=1), por fase do teste
+        std::vector<std::string> overdrawPhases;
+        std::map<std::string, double> overdrawSum, overdrawPeak, overdrawFPS;
+        std::map<std::string, int> overdrawSamples;
+        for (const auto& data : dataPoints) {
+            if (data.stats.overdrawAverage <= 0) continue;
+            if (overdrawSamples[data.phase]++ == 0) {
+                overdrawPhases.push_back(data.phase);
+            }
+            overdrawSum[data.phase] += data.stats.overdrawAverage;
+            overdrawPeak[data.phase] = std::max(overdrawPeak[data.phase], data.stats.overdrawMax);
+            overdrawFPS[data.phase] += data.fps;
+        }
+        if (!overdrawPhases.empty()) {
+            file << "=== OVERDRAW ===\n";
+            for (const auto& phase : overdrawPhases) {
+                int samples = overdrawSamples[phase];
+                file << "Fase " << phase << " - overdraw médio: " << overdrawSum[phase] / samples
+                     << ", máximo: " << overdrawPeak[phase]
+                     << ", FPS médio: " << overdrawFPS[phase] / samples << "\n";
+            }
+            file << "\n";
+        }
+        
+        // Forward vs deferred com as mesmas luzes e triângulos
+        std::map<int, std::map<int64_t, std::pair<double, double>>> fpsByPath;   // luzes -> triângulos -> (forward, deferred)
+        for (const auto& data : dataPoints) {
+            if (data.stats.lightingPath == "deferred") {
+                fpsByPath[data.stats.lightCount][data.triangleCount].second = data.fps;
+            }
+        }
+        for (const auto& data : dataPoints) {
+            if (data.stats.lightingPath != "forward" || data.hasTextures) continue;
+            auto lights = fpsByPath.find(data.stats.lightCount);
+            if (lights == fpsByPath.end()) continue;
+            auto entry = lights->second.find(data.triangleCount);
+            if (entry != lights->second.end()) {
+                entry->second.first = data.fps;
+            }
+        }
+        if (!fpsByPath.empty()) {
+            file << "=== FORWARD vs DEFERRED ===\n";
+            for (const auto& lights : fpsByPath) {
+                int64_t crossover = -1;
+                for (const auto& entry : lights.second) {
+                    double forwardFPS = entry.second.first;
+                    double deferredFPS = entry.second.second;
+                    if (forwardFPS <= 0) continue;
+                    file << lights.first << " luzes, " << entry.first << " triângulos - forward: "
+                         << forwardFPS << " FPS, deferred: " << deferredFPS << " FPS\n";
+                    if (crossover < 0 && deferredFPS > forwardFPS) {
+                        crossover = entry.first;
+                    }
+                }
+                if (crossover >= 0) {
+                    file << "Com " << lights.first << " luzes o deferred passa a ser mais rápido a partir de "
+                         << crossover << " triângulos\n";
+                } else {
+                    file << "Com " << lights.first << " luzes o forward foi mais rápido em todas as medições\n";
+                }
+            }
+            file << "\n";
+        }
+        
+        // Matriz do TextureBenchmark: uma fase por configuração (formato, tamanho, filtro, escala de UV)
+        std::vector<std::string> samplingPhases;
+        std::map<std::string, const PerformanceData*> samplingByPhase;
+        std::map<std::string, std::pair<double, int>> texelRateByFormat;
+        for (const auto& data : dataPoints) {
+            if (data.stats.textureSamplesPerSecond <= 0) continue;
+            if (!samplingByPhase.count(data.phase)) {
+                samplingPhases.push_back(data.phase);
+            }
+            samplingByPhase[data.phase] = &data;
+            auto& entry = texelRateByFormat[data.stats.textureFormat];
+            entry.first += data.stats.texelsPerSecond;
+            entry.second++;
+        }
+        if (!samplingPhases.empty()) {
+            file << "=== AMOSTRAGEM DE TEXTURAS ===\n";
+            for (const auto& phase : samplingPhases) {
+                const PerformanceData& data = *samplingByPhase[phase];
+                file << phase << " - " << data.stats.textureSamplesPerSecond / 1e9 << " Gamostras/s, "
+                     << data.stats.texelsPerSecond / 1e9 << " Gtexels/s (estimado), GPU "
+                     << data.stats.gpuFrameMs << " ms/frame, " << data.stats.textureBytes / 1024.0 << " KB\n";
+            }
+            file << "Média por formato (texels/s estimados pelo filtro):\n";
+            for (const auto& entry : texelRateByFormat) {
+                file << entry.first << " - " << entry.second.first / entry.second.second / 1e9 << " Gtexels/s ("
+                     << entry.second.second << " configurações)\n";
+            }
+            file << "\n";
+        }
+        
+        if (!fpsByFormat.empty()) {
+            file << "=== TEXTURAS ===\n";
+            for (const auto& entry : fpsByFormat) {
+                file << entry.first << " - FPS médio: " << entry.second.first / entry.second.second
+                     << ", memória: " << bytesByFormat[entry.first] / 1024.0 << " KB"
+                     << " (" << entry.second.second << " medições)\n";
+            }
+            file << "\n";
+        }
     }
     
     file << "=== ANÁLISE DOS RESULTADOS ===\n";
@@ -1,19 +1,49 @@
 #ifndef PERFORMANCEMONITOR_H
 #define PERFORMANCEMONITOR_H
 
+#include <GL/glew.h>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <fstream>
 #include <chrono>
+#include <thread>
+#include "RenderStats.h"
+#include "SharedTelemetry.h"
+
+// Carga real do pipeline (GL_ARB_pipeline_statistics_query), média por frame
+struct PipelineStatistics {
+    double verticesSubmitted;
+    double primitivesSubmitted;
+    double vertexShaderInvocations;
+    double clippingInputPrimitives;
+    double clippingOutputPrimitives;
+    double fragmentShaderInvocations;
+    int frames;   // Frames cujas consultas foram lidas (0 = sem dados)
+    
+    PipelineStatistics() : verticesSubmitted(0), primitivesSubmitted(0), vertexShaderInvocations(0),
+                           clippingInputPrimitives(0), clippingOutputPrimitives(0),
+                           fragmentShaderInvocations(0), frames(0) {}
+};
 
 struct PerformanceData {
     double timestamp;
     double fps;
     double cpuUsage;
     double gpuUsage;
-    int triangleCount;
+    int64_t triangleCount;
     bool hasLighting;
     bool hasTextures;
+    RenderStats stats;
+    std::string phase;   // Fase do teste em que a medição foi feita ("-" fora de testes por fases)
+    PipelineStatistics pipeline;
+    // Chamadas de estado GL por frame que foram ao driver / evitadas pelo GLStateCache
+    double glCallsIssued;
+    double glCallsElided;
+    // GLProfiler (só com ENABLE_GL_PROFILER): chamadas, bytes enviados e tempo no driver por frame
+    double glProfiledCalls;
+    double glUploadBytes;
+    double glDriverMs;
 };
 
 class PerformanceMonitor {
@@ -25,6 +55,42 @@ private:
     std::string cpuInfo;
     std::string gpuInfo;
     int cpuCores;
+    // lspci e /proc/cpuinfo lidos em segundo plano durante a inicialização;
+    // os campos acima só são lidos depois de waitSystemInfo()
+    std::thread systemInfoThread;
+    bool systemInfoPrinted;
+    void waitSystemInfo();
+    
+    // Tempo de inicialização até o primeiro frame (ms, -1 se não medido)
+    double timeToFirstFrame;
+    
+    std::string currentPhase;
+    
+    // Consultas de estatísticas do pipeline: um conjunto por frame em anel, lido
+    // quando o resultado fica pronto (sem travar a CPU esperando a GPU)
+    static const int PIPELINE_QUERY_SETS = 3;
+    static const int PIPELINE_COUNTERS = 6;
+    bool pipelineStatsAvailable;
+    GLuint pipelineQueries[PIPELINE_QUERY_SETS][PIPELINE_COUNTERS];
+    bool pipelineQueryPending[PIPELINE_QUERY_SETS];
+    int pipelineQuerySet;
+    bool pipelineQueryActive;
+    uint64_t pipelineTotals[PIPELINE_COUNTERS];   // Somas desde a última medição
+    int pipelineFrames;
+    
+    // Contadores do GLStateCache na medição anterior (para a média por frame)
+    uint64_t lastIssued, lastElided, lastCacheFrames;
+    
+    // Totais do GLProfiler na medição anterior
+    uint64_t lastProfiledCalls, lastProfiledBytes, lastProfiledNs, lastProfiledFrames;
+    
+    // Bloco em memória compartilhada publicado a cada update() (GLPERF_SHM=1)
+    SharedTelemetry* sharedTelemetry;
+    SharedTelemetryFrame sharedFrame;
+    std::chrono::steady_clock::time_point lastUpdate;
+    uint64_t frameIssued, frameElided;   // Contadores do GLStateCache no update() anterior
+    
+    void collectPipelineQueries(int set);
     
     // Métodos para obter informações do sistema
     std::string getCPUInfo();
@@ -37,9 +103,31 @@ public:
     PerformanceMonitor();
     ~PerformanceMonitor();
     
+    // Iniciar a leitura das informações do sistema numa thread de fundo; chamar
+    // no início do main sobrepõe o lspci à criação do contexto e dos shaders
+    // (initialize() a inicia se ainda não foi iniciada)
+    void querySystemInfo();
     void initialize();
+    // Uma vez por frame: fecha o frame do GLStateCache e do GLProfiler
     void update();
-    void addDataPoint(double fps, int triangleCount, bool hasLighting = false, bool hasTextures = false);
+    void addDataPoint(double fps, int64_t triangleCount, bool hasLighting = false, bool hasTextures = false,
+                      const RenderStats& stats = RenderStats());
+    
+    // Marcar as próximas medições com o nome da fase do teste
+    void setPhase(const std::string& name);
+    
+    // Envolver o render de cada frame; os contadores acumulados vão para o
+    // próximo addDataPoint como média por frame (sem efeito se a extensão faltar)
+    void beginPipelineQueries();
+    void endPipelineQueries();
+    bool isPipelineStatisticsAvailable() const { return pipelineStatsAvailable; }
+    
+    // Registrar o tempo do início do programa (StartupProfile::start) até o
+    // primeiro frame apresentado; chamar após cada glfwSwapBuffers, só a
+    // primeira chamada conta. Cada execução é acrescentada a
+    // data/startup_times.csv junto com o estado do cache de shaders,
+    // permitindo comparar execuções com e sem cache.
+    void recordFirstFrame(const std::string& programName);
     
     // Geração de relatórios
     void generateCSVReport(const std::string& filename);
@@ -48,6 +136,9 @@ public:
     // Getters para informações do sistema
     std::string getSystemInfo();
     std::vector<PerformanceData> getDataPoints() const { return dataPoints; }
+    // Última medição sem copiar o vetor (nullptr antes da primeira)
+    const PerformanceData* getLastDataPoint() const { return dataPoints.empty() ? nullptr : &dataPoints.back(); }
+    size_t getDataPointCount() const { return dataPoints.size(); }
 };
 
 #endif
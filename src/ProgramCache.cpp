@@ -0,0 +1,188 @@
+#include "ProgramCache.h"
+#include "GLProfiler.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+#include <sys/stat.h>
+#include <unistd.h>
+
+std::string ProgramCache::directory = "cache/shaders";
+int ProgramCache::hits = 0;
+int ProgramCache::misses = 0;
+
+namespace {
+
+const uint32_t CACHE_MAGIC = 0x42504C47; // "GLPB"
+const uint32_t CACHE_VERSION = 2;         // Layout do cabeçalho (1 não tinha o campo de versão)
+const size_t HEADER_SIZE = 4 * sizeof(uint32_t);
+
+// FNV-1a 64 bits
+uint64_t hashString(uint64_t hash, const std::string& text) {
+    for (unsigned char c : text) {
+        hash ^= c;
+        hash *= 0x100000001b3ULL;
+    }
+    // Separador para que ("ab","c") e ("a","bc") gerem chaves diferentes
+    hash ^= 0xff;
+    hash *= 0x100000001b3ULL;
+    return hash;
+}
+
+std::string glString(GLenum name) {
+    const GLubyte* value = glGetString(name);
+    return value ? reinterpret_cast<const char*>(value) : "";
+}
+
+}
+
+bool ProgramCache::isEnabled() {
+    static int enabled = -1;
+    if (enabled == -1) {
+        const char* env = std::getenv("GLPERF_SHADER_CACHE");
+        bool disabledByUser = env && std::string(env) == "0";
+
+        GLint formats = 0;
+        if (GLEW_ARB_get_program_binary) {
+            glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+        }
+
+        enabled = (!disabledByUser && formats > 0) ? 1 : 0;
+        std::cout << "Cache de binários de shader: "
+                  << (enabled ? "habilitado (" + directory + ")" :
+                      disabledByUser ? std::string("desabilitado (GLPERF_SHADER_CACHE=0)") :
+                                       std::string("indisponível no driver"))
+                  << std::endl;
+    }
+    return enabled == 1;
+}
+
+std::string ProgramCache::makeKey(const std::string& vertexSource, const std::string& fragmentSource) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    hash = hashString(hash, vertexSource);
+    hash = hashString(hash, fragmentSource);
+    hash = hashString(hash, glString(GL_RENDERER));
+    hash = hashString(hash, glString(GL_VERSION));
+
+    std::ostringstream oss;
+    oss << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return oss.str();
+}
+
+std::string ProgramCache::pathFor(const std::string& key) {
+    return directory + "/" + key + ".bin";
+}
+
+GLuint ProgramCache::load(const std::string& vertexSource, const std::string& fragmentSource) {
+    if (!isEnabled()) {
+        return 0;
+    }
+
+    std::string path = pathFor(makeKey(vertexSource, fragmentSource));
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        misses++;
+        return 0;
+    }
+
+    file.seekg(0, std::ios::end);
+    std::streamoff fileSize = file.tellg();
+    file.seekg(0, std::ios::beg);
+
+    uint32_t magic = 0, version = 0, format = 0, length = 0;
+    file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+    file.read(reinterpret_cast<char*>(&version), sizeof(version));
+    file.read(reinterpret_cast<char*>(&format), sizeof(format));
+    file.read(reinterpret_cast<char*>(&length), sizeof(length));
+
+    // Validar o cabeçalho contra o tamanho real antes de alocar: um arquivo
+    // truncado ou corrompido não pode pedir gigabytes
+    bool valid = file && magic == CACHE_MAGIC && version == CACHE_VERSION && length > 0 &&
+                 HEADER_SIZE + (uint64_t)length <= (uint64_t)fileSize;
+    std::vector<char> binary;
+    if (valid) {
+        binary.resize(length);
+        file.read(binary.data(), length);
+    }
+    if (!valid || !file) {
+        std::cerr << "Entrada de cache de shader corrompida, recompilando: " << path << std::endl;
+        std::remove(path.c_str());
+        misses++;
+        return 0;
+    }
+
+    GLuint program = glCreateProgram();
+    glProgramBinary(program, format, binary.data(), length);
+
+    // O driver pode rejeitar binários de outra versão mesmo com a chave igual
+    GLint success;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        std::cerr << "Binário de shader rejeitado pelo driver, recompilando: " << path << std::endl;
+        glDeleteProgram(program);
+        std::remove(path.c_str());
+        misses++;
+        return 0;
+    }
+
+    hits++;
+    return program;
+}
+
+void ProgramCache::prepareForLink(GLuint program) {
+    if (isEnabled()) {
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+}
+
+void ProgramCache::store(GLuint program, const std::string& vertexSource, const std::string& fragmentSource) {
+    if (!isEnabled()) {
+        return;
+    }
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        return;
+    }
+
+    std::vector<char> binary(length);
+    GLenum format = 0;
+    glGetProgramBinary(program, length, nullptr, &format, binary.data());
+
+    // Criar diretório (cache/shaders) se necessário
+    std::string partial;
+    std::istringstream parts(directory);
+    std::string part;
+    while (std::getline(parts, part, '/')) {
+        partial += part + "/";
+        mkdir(partial.c_str(), 0755);
+    }
+
+    // Escrever em arquivo temporário e renomear: processos concorrentes nunca
+    // leem uma entrada pela metade
+    std::string path = pathFor(makeKey(vertexSource, fragmentSource));
+    std::string tempPath = path + ".tmp" + std::to_string(getpid());
+    std::ofstream file(tempPath, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Erro ao gravar cache de shader: " << tempPath << std::endl;
+        return;
+    }
+
+    uint32_t magic = CACHE_MAGIC;
+    uint32_t version = CACHE_VERSION;
+    uint32_t format32 = format;
+    uint32_t length32 = length;
+    file.write(reinterpret_cast<const char*>(&magic), sizeof(magic));
+    file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    file.write(reinterpret_cast<const char*>(&format32), sizeof(format32));
+    file.write(reinterpret_cast<const char*>(&length32), sizeof(length32));
+    file.write(binary.data(), length);
+    file.close();
+
+    std::rename(tempPath.c_str(), path.c_str());
+}
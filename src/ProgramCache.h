@@ -0,0 +1,39 @@
+#ifndef PROGRAMCACHE_H
+#define PROGRAMCACHE_H
+
+#include <GL/glew.h>
+#include <string>
+
+// Cache em disco de programas linkados (glGetProgramBinary / glProgramBinary).
+// A chave é um hash do código-fonte dos shaders mais GL_RENDERER e GL_VERSION,
+// então trocar de driver ou editar um shader invalida a entrada automaticamente.
+// Desabilitar com a variável de ambiente GLPERF_SHADER_CACHE=0.
+class ProgramCache {
+private:
+    static std::string directory;
+    static int hits;
+    static int misses;
+
+    static std::string makeKey(const std::string& vertexSource, const std::string& fragmentSource);
+    static std::string pathFor(const std::string& key);
+
+public:
+    // Disponível se o driver suporta binários e o cache não foi desabilitado
+    static bool isEnabled();
+
+    // Tenta criar o programa a partir do binário salvo; retorna 0 em caso de
+    // ausência ou se o driver rejeitar o binário (o chamador compila normalmente)
+    static GLuint load(const std::string& vertexSource, const std::string& fragmentSource);
+
+    // Chamar antes de glLinkProgram para permitir a leitura do binário depois
+    static void prepareForLink(GLuint program);
+
+    // Salvar o binário de um programa recém-linkado
+    static void store(GLuint program, const std::string& vertexSource, const std::string& fragmentSource);
+
+    static void setDirectory(const std::string& path) { directory = path; }
+    static int getHits() { return hits; }
+    static int getMisses() { return misses; }
+};
+
+#endif
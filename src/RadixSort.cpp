@@ -0,0 +1,85 @@
+#include "RadixSort.h"
+#include "ParallelFor.h"
+#include "StagingPool.h"
+#include <algorithm>
+#include <vector>
+#include <thread>
+
+namespace {
+
+const int RADIX_BITS = 8;
+const int RADIX_SIZE = 1 << RADIX_BITS;
+const size_t MIN_PER_BLOCK = 16384;   // Abaixo disso o custo das threads domina
+
+}
+
+void parallelRadixSort(uint32_t* keys, uint32_t* values, size_t count) {
+    if (count < 2) return;
+    uint32_t* const keysIn = keys;
+    uint32_t* const valuesIn = values;
+
+    // Blocos fixos: a contagem e o scatter precisam ver a mesma divisão
+    size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    size_t blockCount = std::max<size_t>(1, std::min(hardware, count / MIN_PER_BLOCK));
+    size_t blockSize = (count + blockCount - 1) / blockCount;
+
+    StagingBuffer keyBuffer(count * sizeof(uint32_t));
+    StagingBuffer valueBuffer(count * sizeof(uint32_t));
+    uint32_t* keysOut = keyBuffer.as<uint32_t>();
+    uint32_t* valuesOut = valueBuffer.as<uint32_t>();
+    std::vector<size_t> histogramBuffer(blockCount * RADIX_SIZE);
+    size_t* histograms = histogramBuffer.data();
+
+    for (int shift = 0; shift < 32; shift += RADIX_BITS) {
+        std::fill(histograms, histograms + blockCount * RADIX_SIZE, 0);
+
+        parallelFor(0, blockCount, [&](size_t firstBlock, size_t lastBlock) {
+            for (size_t block = firstBlock; block < lastBlock; ++block) {
+                size_t* histogram = &histograms[block * RADIX_SIZE];
+                size_t end = std::min(count, (block + 1) * blockSize);
+                for (size_t i = block * blockSize; i < end; ++i) {
+                    histogram[(keys[i] >> shift) & (RADIX_SIZE - 1)]++;
+                }
+            }
+        });
+
+        // Prefixo na ordem (dígito, bloco) mantém a ordenação estável; se todas
+        // as chaves têm o mesmo dígito a passada não muda nada
+        size_t offset = 0;
+        bool trivial = false;
+        for (int digit = 0; digit < RADIX_SIZE; ++digit) {
+            size_t digitTotal = 0;
+            for (size_t block = 0; block < blockCount; ++block) {
+                size_t n = histograms[block * RADIX_SIZE + digit];
+                histograms[block * RADIX_SIZE + digit] = offset;
+                offset += n;
+                digitTotal += n;
+            }
+            if (digitTotal == count) {
+                trivial = true;
+            }
+        }
+        if (trivial) continue;
+
+        parallelFor(0, blockCount, [&](size_t firstBlock, size_t lastBlock) {
+            for (size_t block = firstBlock; block < lastBlock; ++block) {
+                size_t* destination = &histograms[block * RADIX_SIZE];
+                size_t end = std::min(count, (block + 1) * blockSize);
+                for (size_t i = block * blockSize; i < end; ++i) {
+                    size_t position = destination[(keys[i] >> shift) & (RADIX_SIZE - 1)]++;
+                    keysOut[position] = keys[i];
+                    valuesOut[position] = values[i];
+                }
+            }
+        });
+
+        std::swap(keys, keysOut);
+        std::swap(values, valuesOut);
+    }
+
+    // Número ímpar de passadas efetivas: o resultado ficou no buffer temporário
+    if (keys != keysIn) {
+        std::memcpy(keysIn, keys, count * sizeof(uint32_t));
+        std::memcpy(valuesIn, values, count * sizeof(uint32_t));
+    }
+}
@@ -0,0 +1,21 @@
+#ifndef RADIXSORT_H
+#define RADIXSORT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Chave de 32 bits que preserva a ordem de floats (negativos incluídos)
+inline uint32_t floatSortKey(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+// Ordenação radix LSD estável (4 passadas de 8 bits) de "values" pelas "keys",
+// em ordem crescente. Em cada passada as threads contam dígitos nos seus blocos,
+// um prefixo global dá o destino de cada bloco e o scatter roda em paralelo.
+// Os buffers temporários vêm do StagingPool (a ordenação roda fora do frame).
+void parallelRadixSort(uint32_t* keys, uint32_t* values, size_t count);
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef RENDERSTATS_H
+#define RENDERSTATS_H
+
+#include <cstddef>
+#include <string>
+
+// Estado do renderer associado a cada medição de performance
+struct RenderStats {
+    std::string shaderVariant;   // Variante de shader usada no desenho (ex: "LIGHTING+NUM_LIGHTS=2")
+    std::string textureFormat;   // "RGBA8", "RGB8", "RGBA16F", "BC1", "BC3" ou "BC1-decoded" (sem S3TC); "-" sem texturas
+    size_t textureBytes;         // Memória de textura na GPU (todos os níveis)
+    int textureSize;             // Largura do nível 0 (0 sem texturas)
+    std::string minFilter;       // Filtros de amostragem (Texture::filterName); "-" sem texturas
+    std::string magFilter;
+    float anisotropy;
+    float uvScale;               // Repetições da textura por triângulo
+    double shadedFragments;      // Fragmentos que passaram no teste de profundidade, por frame
+    double textureSamplesPerSecond;  // shadedFragments / tempo de GPU (benchmark de texturas; 0 fora dele)
+    double texelsPerSecond;      // Amostras/s x texels lidos por amostra (estimado pelo filtro)
+    int lightCount;              // Luzes avaliadas com iluminação ligada (0 sem iluminação)
+    double clusterBuildMs;       // Última atribuição de luzes aos clusters na CPU (0 fora do modo clustered)
+    std::string lightingPath;    // "forward" ou "deferred"; "-" sem iluminação
+    std::string shadingTier;     // "per-fragment", "per-vertex" ou "unlit" no caminho forward; "-" fora dele
+    size_t gBufferBytes;         // Memória do G-buffer no caminho adiado
+    bool depthPrepass;           // Pré-passada de profundidade + shading com GL_EQUAL
+    bool frontToBack;            // Triângulos desenhados de frente para trás (só no caminho da CPU)
+    std::string sortScope;       // Alcance da ordenação: "scene", "chunk" (só dentro de cada bloco) ou "-"
+    float depthSpread;           // z dos triângulos em [-depthSpread, depthSpread]
+    double shadedFragmentsPerPixel;  // Fragmentos que passaram no teste de profundidade / pixels do viewport
+    double overdrawAverage;      // Fragmentos rasterizados por pixel (OverdrawAnalyzer; 0 se desligado)
+    double overdrawMax;          // Maior contagem em um único pixel
+    double resolutionScale;      // Escala linear da resolução dinâmica (1 = resolução da janela)
+    double gpuFrameMs;           // Tempo de GPU da cena (GL_TIME_ELAPSED; 0 se não medido)
+    double frameTimeErrorMs;     // gpuFrameMs - orçamento (positivo = acima do orçamento)
+    double simulationHz;         // Passos/s da thread de simulação (0 = simulação na thread de render)
+    double simulationStepMs;     // Tempo de CPU de um passo da simulação
+    size_t arenaAllocations;     // Alocações na FrameArena no último frame
+    size_t arenaBytes;           // Bytes alocados na FrameArena no último frame
+    size_t stagingBytes;         // Memória mapeada pelo StagingPool (em uso + livre)
+    size_t geometryBytes;        // Vértices dos triângulos na GPU (soma dos blocos)
+    size_t geometryChunks;       // Blocos de geometria (um VBO + VAO cada)
+    std::string animationPath;   // Onde a rotação é calculada: "cpu", "vertex" ou "compute"
+    bool vertexPulling;          // Vértices remontados no shader a partir de um registro por triângulo
+    double streamTexturesPerSecond;  // Texturas novas enviadas por PBO (TextureStreamer; 0 se desligado)
+    double streamUploadMBps;     // Banda de upload do streaming
+    double streamLatencyMs;      // Do pedido até a fence do upload sinalizar
+    double streamRenderThreadMs; // CPU da thread de render no streaming, por frame
+
+    RenderStats() : shaderVariant("-"), textureFormat("-"), textureBytes(0), textureSize(0), minFilter("-"),
+                    magFilter("-"), anisotropy(1.0f), uvScale(1.0f), shadedFragments(0.0),
+                    textureSamplesPerSecond(0.0), texelsPerSecond(0.0), lightCount(0), clusterBuildMs(0.0),
+                    lightingPath("-"), shadingTier("-"), gBufferBytes(0), depthPrepass(false), frontToBack(false),
+                    sortScope("-"), depthSpread(0.0f), shadedFragmentsPerPixel(0.0),
+                    overdrawAverage(0.0), overdrawMax(0.0),
+                    resolutionScale(1.0), gpuFrameMs(0.0), frameTimeErrorMs(0.0),
+                    simulationHz(0.0), simulationStepMs(0.0),
+                    arenaAllocations(0), arenaBytes(0), stagingBytes(0),
+                    geometryBytes(0), geometryChunks(0), animationPath("cpu"), vertexPulling(false),
+                    streamTexturesPerSecond(0.0), streamUploadMBps(0.0), streamLatencyMs(0.0),
+                    streamRenderThreadMs(0.0) {}
+};
+
+#endif
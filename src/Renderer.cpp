@@ -1,4 +1,8 @@
 #include "Renderer.h"
+#include "ProgramCache.h"
+#include "GLStateCache.h"
+#include "GLProfiler.h"
+#include "StartupProfile.h"
 #include <iostream>
 #include <cmath>
 
@@ -10,6 +14,7 @@ Renderer::~Renderer() {
 }
 
 bool Renderer::initialize() {
+    StartupProfile::Scope phase("Renderer");
     // Criar programa de shader
     if (!createShaderProgram()) {
         return false;
@@ -17,11 +22,11 @@ bool Renderer::initialize() {
 
     // Gerar e vincular VAO
     glGenVertexArrays(1, &VAO);
-    glBindVertexArray(VAO);
+    GLStateCache::bindVertexArray(VAO);
 
     // Gerar e vincular VBO
     glGenBuffers(1, &VBO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    GLStateCache::bindBuffer(GL_ARRAY_BUFFER, VBO);
     glBufferData(GL_ARRAY_BUFFER, sizeof(triangleVertices), triangleVertices, GL_STATIC_DRAW);
 
     // Configurar atributos de vértice
@@ -34,7 +39,7 @@ bool Renderer::initialize() {
     glEnableVertexAttribArray(1);
 
     // Desvincular VAO
-    glBindVertexArray(0);
+    GLStateCache::bindVertexArray(0);
 
     std::cout << "Renderer inicializado com sucesso!" << std::endl;
     return true;
@@ -42,7 +47,7 @@ bool Renderer::initialize() {
 
 void Renderer::renderTriangle(float rotationAngle) {
     // Usar programa de shader
-    glUseProgram(shaderProgram);
+    GLStateCache::useProgram(shaderProgram);
 
     // Criar matriz de transformação (rotação)
     float cosA = cos(rotationAngle);
@@ -60,22 +65,21 @@ void Renderer::renderTriangle(float rotationAngle) {
     glUniformMatrix4fv(transformLoc, 1, GL_FALSE, transformMatrix);
 
     // Vincular VAO e desenhar
-    glBindVertexArray(VAO);
+    GLStateCache::bindVertexArray(VAO);
     glDrawArrays(GL_TRIANGLES, 0, 3);
-    glBindVertexArray(0);
 }
 
 void Renderer::cleanup() {
     if (VAO) {
-        glDeleteVertexArrays(1, &VAO);
+        GLStateCache::deleteVertexArrays(1, &VAO);
         VAO = 0;
     }
     if (VBO) {
-        glDeleteBuffers(1, &VBO);
+        GLStateCache::deleteBuffers(1, &VBO);
         VBO = 0;
     }
     if (shaderProgram) {
-        glDeleteProgram(shaderProgram);
+        GLStateCache::deleteProgram(shaderProgram);
         shaderProgram = 0;
     }
 }
@@ -100,6 +104,12 @@ GLuint Renderer::compileShader(GLenum type, const char* source) {
 }
 
 bool Renderer::createShaderProgram() {
+    // Reaproveitar o binário salvo na execução anterior, se houver
+    shaderProgram = ProgramCache::load(vertexShaderSource, fragmentShaderSource);
+    if (shaderProgram) {
+        return true;
+    }
+
     // Compilar shaders
     GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertexShaderSource);
     GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentShaderSource);
@@ -112,6 +122,7 @@ bool Renderer::createShaderProgram() {
     shaderProgram = glCreateProgram();
     glAttachShader(shaderProgram, vertexShader);
     glAttachShader(shaderProgram, fragmentShader);
+    ProgramCache::prepareForLink(shaderProgram);
     glLinkProgram(shaderProgram);
 
     // Verificar erros de linking
@@ -131,6 +142,8 @@ bool Renderer::createShaderProgram() {
     glDeleteShader(vertexShader);
     glDeleteShader(fragmentShader);
 
+    ProgramCache::store(shaderProgram, vertexShaderSource, fragmentShaderSource);
+
     std::cout << "Programa de shader criado com sucesso!" << std::endl;
     return true;
 }
@@ -0,0 +1,274 @@
+#include "ShaderVariants.h"
+#include "ProgramCache.h"
+#include "GLStateCache.h"
+#include "GLProfiler.h"
+#include <iostream>
+#include <chrono>
+#include <thread>
+
+ShaderVariantKey::ShaderVariantKey(bool lighting, bool texture, int numLights, bool textureArray, bool clustered,
+                                   bool gouraud, AnimationPath animation, bool pulled)
+    : lighting(lighting), texture(texture), textureArray(texture && textureArray),
+      clustered(lighting && clustered), gouraud(lighting && !clustered && gouraud),
+      numLights(lighting && !clustered ? numLights : 0), animation(animation), pulled(pulled) {
+}
+
+bool ShaderVariantKey::operator<(const ShaderVariantKey& other) const {
+    if (lighting != other.lighting) return lighting < other.lighting;
+    if (texture != other.texture) return texture < other.texture;
+    if (textureArray != other.textureArray) return textureArray < other.textureArray;
+    if (clustered != other.clustered) return clustered < other.clustered;
+    if (gouraud != other.gouraud) return gouraud < other.gouraud;
+    if (animation != other.animation) return animation < other.animation;
+    if (pulled != other.pulled) return pulled < other.pulled;
+    return numLights < other.numLights;
+}
+
+std::string ShaderVariantKey::name() const {
+    std::string result;
+    if (lighting) {
+        result += "LIGHTING+";
+    }
+    if (gouraud) {
+        result += "GOURAUD+";
+    }
+    if (texture) {
+        result += textureArray ? "TEXTURE_ARRAY+" : "TEXTURE+";
+    }
+    if (clustered) {
+        result += "CLUSTERED+";
+    } else if (lighting) {
+        result += "NUM_LIGHTS=" + std::to_string(numLights) + "+";
+    }
+    if (animation == AnimationPath::VertexShader) {
+        result += "VERTEX_ANIMATION+";
+    } else if (animation == AnimationPath::Compute) {
+        result += "COMPUTE_ANIMATION+";
+    }
+    if (pulled) {
+        result += "PULLED";
+    }
+    if (result.empty()) {
+        return "BASE";
+    }
+    if (result.back() == '+') {
+        result.pop_back();
+    }
+    return result;
+}
+
+std::string ShaderVariantKey::defines() const {
+    std::string result;
+    if (lighting) {
+        result += "#define LIGHTING\n";
+    }
+    if (gouraud) {
+        result += "#define GOURAUD\n";
+    }
+    if (clustered) {
+        result += "#define CLUSTERED\n";
+    } else if (lighting) {
+        result += "#define NUM_LIGHTS " + std::to_string(numLights) + "\n";
+    }
+    if (texture) {
+        result += "#define TEXTURE\n";
+    }
+    if (textureArray) {
+        result += "#define TEXTURE_ARRAY\n";
+    }
+    if (animation == AnimationPath::VertexShader) {
+        result += "#define VERTEX_ANIMATION\n";
+    } else if (animation == AnimationPath::Compute) {
+        result += "#define COMPUTE_ANIMATION\n";
+    }
+    if (pulled) {
+        result += "#define PULLED_VERTICES\n";
+    }
+    return result;
+}
+
+ShaderVariantCache::ShaderVariantCache(const char* vertexTemplate, const char* fragmentTemplate,
+                                       const std::string& label)
+    : vertexTemplate(vertexTemplate), fragmentTemplate(fragmentTemplate), label(label) {
+}
+
+ShaderVariantCache::~ShaderVariantCache() {
+    cleanup();
+}
+
+bool ShaderVariantCache::isParallelCompileAvailable() {
+    return GLEW_KHR_parallel_shader_compile || GLEW_ARB_parallel_shader_compile;
+}
+
+std::string ShaderVariantCache::buildSource(const std::string& body, const ShaderVariantKey& key,
+                                            bool vertexStage) const {
+    // O #version precisa ser a primeira linha, então os modelos não o incluem.
+    // SSBO no vertex shader (matrizes do compute shader) exige GLSL 4.30
+    std::string source = key.animation == AnimationPath::Compute ? "#version 430 core\n" : "#version 330 core\n";
+    source += key.defines();
+    if (vertexStage) {
+        source += VertexPulling::VERTEX_INPUT_SOURCE;
+        source += TriangleAnimation::TRANSFORM_SOURCE;
+    }
+    return source + body;
+}
+
+ShaderVariantCache::PendingProgram ShaderVariantCache::submit(const ShaderVariantKey& key) {
+    PendingProgram pending;
+    pending.key = key;
+    pending.vertexSource = buildSource(vertexTemplate, key, true);
+    pending.fragmentSource = buildSource(fragmentTemplate, key, false);
+    pending.vertexShader = 0;
+    pending.fragmentShader = 0;
+
+    pending.program = ProgramCache::load(pending.vertexSource, pending.fragmentSource);
+    pending.fromCache = pending.program != 0;
+    if (pending.fromCache) {
+        return pending;
+    }
+
+    const char* vertexPtr = pending.vertexSource.c_str();
+    const char* fragmentPtr = pending.fragmentSource.c_str();
+
+    pending.vertexShader = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(pending.vertexShader, 1, &vertexPtr, nullptr);
+    glCompileShader(pending.vertexShader);
+
+    pending.fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(pending.fragmentShader, 1, &fragmentPtr, nullptr);
+    glCompileShader(pending.fragmentShader);
+
+    pending.program = glCreateProgram();
+    glAttachShader(pending.program, pending.vertexShader);
+    glAttachShader(pending.program, pending.fragmentShader);
+    ProgramCache::prepareForLink(pending.program);
+    glLinkProgram(pending.program);
+
+    return pending;
+}
+
+bool ShaderVariantCache::finish(PendingProgram& pending) {
+    if (pending.fromCache) {
+        programs[pending.key] = pending.program;
+        return true;
+    }
+
+    GLint success;
+    glGetProgramiv(pending.program, GL_LINK_STATUS, &success);
+    if (!success) {
+        GLchar infoLog[512];
+        GLuint shaders[] = {pending.vertexShader, pending.fragmentShader};
+        for (GLuint shader : shaders) {
+            glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+            if (!success) {
+                glGetShaderInfoLog(shader, 512, nullptr, infoLog);
+                std::cerr << "Erro ao compilar variante " << pending.key.name()
+                          << " (" << label << "): " << infoLog << std::endl;
+            }
+        }
+        glGetProgramInfoLog(pending.program, 512, nullptr, infoLog);
+        std::cerr << "Erro ao linkar variante " << pending.key.name()
+                  << " (" << label << "): " << infoLog << std::endl;
+
+        glDeleteShader(pending.vertexShader);
+        glDeleteShader(pending.fragmentShader);
+        GLStateCache::deleteProgram(pending.program);
+        // Programa 0 marca a falha: as fontes não mudam, então recompilar a
+        // cada frame só repetiria o erro
+        programs[pending.key] = 0;
+        return false;
+    }
+
+    glDeleteShader(pending.vertexShader);
+    glDeleteShader(pending.fragmentShader);
+
+    ProgramCache::store(pending.program, pending.vertexSource, pending.fragmentSource);
+    programs[pending.key] = pending.program;
+    return true;
+}
+
+bool ShaderVariantCache::build(const std::vector<ShaderVariantKey>& keys) {
+    auto start = std::chrono::high_resolution_clock::now();
+    bool parallel = isParallelCompileAvailable();
+
+    if (GLEW_KHR_parallel_shader_compile) {
+        glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+    } else if (GLEW_ARB_parallel_shader_compile) {
+        glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+    }
+
+    // Submeter todas as variantes antes de consultar qualquer status
+    std::vector<PendingProgram> pending;
+    bool failedBefore = false;
+    for (const auto& key : keys) {
+        auto it = programs.find(key);
+        if (it != programs.end()) {
+            failedBefore = failedBefore || it->second == 0;
+            continue;
+        }
+        pending.push_back(submit(key));
+    }
+    if (pending.empty()) {
+        return !failedBefore;
+    }
+
+    // Com compilação paralela, aguardar todas sem bloquear em uma só
+    if (parallel) {
+        bool allDone = false;
+        while (!allDone) {
+            allDone = true;
+            for (const auto& p : pending) {
+                GLint done = GL_FALSE;
+                glGetProgramiv(p.program, GL_COMPLETION_STATUS_KHR, &done);
+                if (!done) {
+                    allDone = false;
+                    break;
+                }
+            }
+            if (!allDone) {
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
+        }
+    }
+
+    bool ok = !failedBefore;
+    for (auto& p : pending) {
+        if (!finish(p)) {
+            ok = false;
+        }
+    }
+
+    auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start);
+    std::cout << "Variantes de shader (" << label << "): " << pending.size() << " prontas em "
+              << elapsed.count() << " ms" << (parallel ? " (compilação paralela)" : "") << std::endl;
+    for (const auto& p : pending) {
+        std::cout << "  - " << p.key.name() << (p.fromCache ? " (cache)" : "") << std::endl;
+    }
+
+    return ok;
+}
+
+GLuint ShaderVariantCache::get(const ShaderVariantKey& key) {
+    // Inclui as variantes que já falharam (programa 0)
+    auto it = programs.find(key);
+    if (it != programs.end()) {
+        return it->second;
+    }
+
+    // Variante não pré-compilada (ex: número de luzes mudou)
+    PendingProgram pending = submit(key);
+    if (!finish(pending)) {
+        return 0;
+    }
+    std::cout << "Variante de shader compilada sob demanda: " << key.name() << std::endl;
+    return programs[key];
+}
+
+void ShaderVariantCache::cleanup() {
+    for (auto& entry : programs) {
+        if (entry.second) {
+            GLStateCache::deleteProgram(entry.second);
+        }
+    }
+    programs.clear();
+}
@@ -0,0 +1,85 @@
+#ifndef SHADERVARIANTS_H
+#define SHADERVARIANTS_H
+
+#include <GL/glew.h>
+#include <map>
+#include <string>
+#include <vector>
+#include "TriangleAnimation.h"
+#include "VertexPulling.h"
+
+// Chave de uma permutação de #defines do shader
+struct ShaderVariantKey {
+    bool lighting;
+    bool texture;
+    bool textureArray;   // Amostrar GL_TEXTURE_2D_ARRAY (camada escolhida por triângulo)
+    bool clustered;      // Luzes lidas das listas por cluster (LightClusters) em vez de NUM_LIGHTS uniforms
+    bool gouraud;        // Luzes avaliadas por vértice (só com NUM_LIGHTS uniforms)
+    int numLights;
+    AnimationPath animation;   // De onde vem a matriz "transform" de cada triângulo
+    bool pulled;               // Vértices remontados do registro por triângulo (VertexPulling)
+
+    ShaderVariantKey(bool lighting = false, bool texture = false, int numLights = 0, bool textureArray = false,
+                     bool clustered = false, bool gouraud = false, AnimationPath animation = AnimationPath::CPU,
+                     bool pulled = false);
+
+    bool operator<(const ShaderVariantKey& other) const;
+
+    // Nome legível da variante (ex: "LIGHTING+TEXTURE+NUM_LIGHTS=2", "LIGHTING+GOURAUD+NUM_LIGHTS=2",
+    // "LIGHTING+CLUSTERED", "COMPUTE_ANIMATION+PULLED", "BASE")
+    std::string name() const;
+
+    // Bloco de #defines inserido logo após o #version
+    std::string defines() const;
+};
+
+// Gera, compila e guarda programas especializados a partir de um par de
+// shaders-modelo com blocos #ifdef. Cada modo de renderização usa um programa
+// sem branches mortos em vez de testar uniforms em tempo de execução.
+class ShaderVariantCache {
+private:
+    std::string vertexTemplate;
+    std::string fragmentTemplate;
+    std::string label;
+    std::map<ShaderVariantKey, GLuint> programs;
+
+    struct PendingProgram {
+        ShaderVariantKey key;
+        GLuint program;
+        GLuint vertexShader;
+        GLuint fragmentShader;
+        bool fromCache;
+        std::string vertexSource;
+        std::string fragmentSource;
+    };
+
+    // Nos vertex shaders entram também as entradas de vértice (VertexPulling::VERTEX_INPUT_SOURCE)
+    // e a declaração de "transform" (TriangleAnimation::TRANSFORM_SOURCE)
+    std::string buildSource(const std::string& body, const ShaderVariantKey& key, bool vertexStage) const;
+
+    // Carrega do cache de binários ou dispara compilação e link sem consultar
+    // o status (permite paralelismo no driver)
+    PendingProgram submit(const ShaderVariantKey& key);
+
+    // Verifica o resultado do link e guarda o programa no cache
+    bool finish(PendingProgram& pending);
+
+public:
+    ShaderVariantCache(const char* vertexTemplate, const char* fragmentTemplate, const std::string& label);
+    ~ShaderVariantCache();
+
+    // Compila todas as variantes pedidas de uma vez (em paralelo quando
+    // GL_KHR_parallel_shader_compile estiver disponível)
+    bool build(const std::vector<ShaderVariantKey>& keys);
+
+    // Retorna o programa da variante, compilando sob demanda se ainda não existir.
+    // Uma variante que falhou fica registrada e retorna 0 sem nova tentativa
+    GLuint get(const ShaderVariantKey& key);
+
+    size_t size() const { return programs.size(); }
+    void cleanup();
+
+    static bool isParallelCompileAvailable();
+};
+
+#endif
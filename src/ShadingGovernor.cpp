@@ -0,0 +1,124 @@
+#include "ShadingGovernor.h"
+#include <iostream>
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+
+ShadingGovernor::ShadingGovernor(double targetFrameMs)
+    : targetFrameMs(targetFrameMs), window(WINDOW_FRAMES, 0.0), windowCount(0), windowIndex(0),
+      windowSum(0.0), tier(ShadingTier::PerFragment), automatic(true), tierSeconds{0.0, 0.0, 0.0},
+      tierChanges(0), goodWindows(0), requiredGoodWindows(1), justSteppedUp(false) {
+}
+
+bool ShadingGovernor::isRequested() {
+    const char* env = std::getenv("GLPERF_SHADING_LOD");
+    return env && std::string(env) == "1";
+}
+
+const char* ShadingGovernor::tierName(ShadingTier t) {
+    switch (t) {
+        case ShadingTier::PerFragment: return "per-fragment";
+        case ShadingTier::PerVertex:   return "per-vertex";
+        case ShadingTier::Unlit:       return "unlit";
+    }
+    return "?";
+}
+
+void ShadingGovernor::resetWindow() {
+    windowCount = 0;
+    windowIndex = 0;
+    windowSum = 0.0;
+}
+
+void ShadingGovernor::changeTier(ShadingTier newTier, double averageMs) {
+    std::cout << "[LOD] Shading " << tierName(tier) << " -> " << tierName(newTier)
+              << " (média " << averageMs << " ms em " << WINDOW_FRAMES << " frames, orçamento "
+              << targetFrameMs << " ms, " << tierSeconds[(int)tier] << " s acumulados no nível anterior)" << std::endl;
+    tier = newTier;
+    tierChanges++;
+    resetWindow();
+}
+
+bool ShadingGovernor::update(double frameSeconds, bool perVertexAvailable) {
+    tierSeconds[(int)tier] += frameSeconds;
+    if (!automatic || frameSeconds <= 0.0) {
+        return false;
+    }
+
+    double frameMs = frameSeconds * 1000.0;
+    if (windowCount == WINDOW_FRAMES) {
+        windowSum -= window[windowIndex];
+    } else {
+        windowCount++;
+    }
+    window[windowIndex] = frameMs;
+    windowSum += frameMs;
+    windowIndex = (windowIndex + 1) % WINDOW_FRAMES;
+    if (windowCount < WINDOW_FRAMES) {
+        return false;
+    }
+
+    double averageMs = windowSum / WINDOW_FRAMES;
+    if (averageMs > targetFrameMs * 1.1 && tier != ShadingTier::Unlit) {
+        // Subida desfeita na primeira janela: exigir mais folga na próxima
+        if (justSteppedUp) {
+            requiredGoodWindows = std::min(requiredGoodWindows * 2, 16);
+        }
+        justSteppedUp = false;
+        goodWindows = 0;
+        ShadingTier lower = (tier == ShadingTier::PerFragment && perVertexAvailable)
+                                ? ShadingTier::PerVertex : ShadingTier::Unlit;
+        changeTier(lower, averageMs);
+        return true;
+    }
+
+    if (averageMs < targetFrameMs * 0.6 && tier != ShadingTier::PerFragment) {
+        // Janelas consecutivas, sem sobreposição
+        resetWindow();
+        if (++goodWindows < requiredGoodWindows) {
+            return false;
+        }
+        goodWindows = 0;
+        justSteppedUp = true;
+        ShadingTier higher = (tier == ShadingTier::Unlit && perVertexAvailable)
+                                 ? ShadingTier::PerVertex : ShadingTier::PerFragment;
+        changeTier(higher, averageMs);
+        return true;
+    }
+
+    // Uma janela inteira dentro do orçamento confirma a última subida
+    if (justSteppedUp) {
+        justSteppedUp = false;
+        requiredGoodWindows = 1;
+    }
+    return false;
+}
+
+void ShadingGovernor::setTier(ShadingTier newTier) {
+    automatic = false;
+    if (newTier != tier) {
+        std::cout << "[LOD] Shading fixado em " << tierName(newTier) << std::endl;
+        tier = newTier;
+        tierChanges++;
+    }
+    resetWindow();
+}
+
+void ShadingGovernor::setAutomatic(bool enabled) {
+    automatic = enabled;
+    goodWindows = 0;
+    requiredGoodWindows = 1;
+    justSteppedUp = false;
+    resetWindow();
+    std::cout << "[LOD] Seleção automática de shading " << (enabled ? "ligada" : "desligada")
+              << " (orçamento " << targetFrameMs << " ms)" << std::endl;
+}
+
+void ShadingGovernor::logSummary() const {
+    std::cout << "[LOD] Tempo por nível de shading (" << tierChanges << " trocas):";
+    for (int t = 0; t < 3; ++t) {
+        std::cout << " " << tierName((ShadingTier)t) << " " << tierSeconds[t] << " s";
+        if (t < 2) std::cout << ",";
+    }
+    std::cout << std::endl;
+}
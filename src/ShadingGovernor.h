@@ -0,0 +1,65 @@
+#ifndef SHADINGGOVERNOR_H
+#define SHADINGGOVERNOR_H
+
+#include <vector>
+
+// Níveis de qualidade da iluminação, do mais caro ao mais barato
+enum class ShadingTier {
+    PerFragment,   // Laço de luzes no fragment shader
+    PerVertex,     // Gouraud: luzes nos vértices, cor interpolada
+    Unlit          // Só cor do vértice e textura
+};
+
+// Escolhe o nível de shading pela média do tempo de frame em uma janela
+// deslizante de WINDOW_FRAMES frames: acima do orçamento (+10%) desce um nível,
+// com folga (abaixo de 60% do orçamento) sobe um. A janela é reiniciada a cada
+// troca para medir só o nível novo; uma subida desfeita logo em seguida dobra o
+// número de janelas com folga exigidas para a próxima subida (até 16).
+//
+// Trocas e tempo acumulado em cada nível são registrados no console.
+class ShadingGovernor {
+public:
+    static const int WINDOW_FRAMES = 60;
+
+private:
+    double targetFrameMs;
+    std::vector<double> window;   // Tempos de frame em ms (anel)
+    int windowCount, windowIndex;
+    double windowSum;
+
+    ShadingTier tier;
+    bool automatic;
+    double tierSeconds[3];
+    int tierChanges;
+
+    int goodWindows;              // Janelas seguidas com folga
+    int requiredGoodWindows;      // Necessárias para subir um nível
+    bool justSteppedUp;
+
+    void changeTier(ShadingTier newTier, double averageMs);
+    void resetWindow();
+
+public:
+    explicit ShadingGovernor(double targetFrameMs);
+
+    // Registrar o tempo do último frame; retorna true quando o nível mudou.
+    // perVertexAvailable = false pula o nível Gouraud (caminho por clusters)
+    bool update(double frameSeconds, bool perVertexAvailable);
+
+    // Fixar o nível manualmente (desliga a seleção automática)
+    void setTier(ShadingTier newTier);
+    void setAutomatic(bool enabled);
+    bool isAutomatic() const { return automatic; }
+
+    ShadingTier getTier() const { return tier; }
+    double getTierSeconds(ShadingTier t) const { return tierSeconds[(int)t]; }
+    void logSummary() const;
+
+    static const char* tierName(ShadingTier t);
+
+    // GLPERF_SHADING_LOD=1 liga a seleção automática; o orçamento vem de
+    // FrameBudget::requestedTargetMs() (GLPERF_TARGET_FRAME_MS)
+    static bool isRequested();
+};
+
+#endif
@@ -0,0 +1,91 @@
+#include "SharedTelemetry.h"
+#include <iostream>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// O contador é lido por outro processo: precisa ser um atômico sem trava
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "seqlock requer atômico de 32 bits sem trava");
+
+SharedTelemetry::SharedTelemetry() : block(nullptr) {
+}
+
+SharedTelemetry::~SharedTelemetry() {
+    cleanup();
+}
+
+bool SharedTelemetry::isRequested() {
+    const char* env = std::getenv("GLPERF_SHM");
+    return env && std::string(env) == "1";
+}
+
+bool SharedTelemetry::initialize() {
+    name = "/" + std::string(NAME_PREFIX) + std::to_string(getpid());
+    int fd = shm_open(name.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+    if (fd < 0) {
+        std::cerr << "Telemetria compartilhada: erro em shm_open(" << name << "): " << std::strerror(errno)
+                  << std::endl;
+        return false;
+    }
+    void* memory = MAP_FAILED;
+    if (ftruncate(fd, sizeof(SharedTelemetryBlock)) == 0) {
+        memory = mmap(nullptr, sizeof(SharedTelemetryBlock), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (memory == MAP_FAILED) {
+        std::cerr << "Telemetria compartilhada: erro ao mapear " << name << ": " << std::strerror(errno) << std::endl;
+        shm_unlink(name.c_str());
+        return false;
+    }
+
+    // Páginas novas vêm zeradas; magic é escrito por último para o leitor ignorar blocos incompletos
+    block = new (memory) SharedTelemetryBlock();
+    block->version = VERSION;
+    block->pid = getpid();
+    std::strncpy(block->program, program_invocation_short_name, sizeof(block->program) - 1);
+    std::atomic_thread_fence(std::memory_order_release);
+    block->magic = MAGIC;
+
+    std::cout << "Telemetria compartilhada em /dev/shm" << name << " (leitor: telemetry_tail)" << std::endl;
+    return true;
+}
+
+void SharedTelemetry::cleanup() {
+    if (block) {
+        munmap(block, sizeof(SharedTelemetryBlock));
+        shm_unlink(name.c_str());
+        block = nullptr;
+    }
+}
+
+void SharedTelemetry::publish(const SharedTelemetryFrame& frame) {
+    if (!block) {
+        return;
+    }
+    // Só a thread de render escreve: o contador pode ser lido sem atômico de leitura-escrita
+    uint32_t sequence = block->sequence.load(std::memory_order_relaxed);
+    block->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(&block->data, &frame, sizeof(frame));
+    block->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+bool SharedTelemetry::read(const SharedTelemetryBlock* block, SharedTelemetryFrame& frame) {
+    // Poucas tentativas bastam: uma escrita é uma cópia de ~130 bytes
+    for (int attempt = 0; attempt < 1000; ++attempt) {
+        uint32_t before = block->sequence.load(std::memory_order_acquire);
+        if (before & 1) {
+            continue;
+        }
+        std::memcpy(&frame, &block->data, sizeof(frame));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (block->sequence.load(std::memory_order_relaxed) == before) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,69 @@
+#ifndef SHAREDTELEMETRY_H
+#define SHAREDTELEMETRY_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Métricas de um frame no segmento compartilhado. Só tipos de tamanho fixo:
+// o layout precisa ser o mesmo no processo medido e no leitor.
+struct SharedTelemetryFrame {
+    uint64_t frame;            // Frames concluídos (update() do PerformanceMonitor)
+    double timestamp;          // Segundos desde o início do monitor
+    double frameMs;            // Intervalo entre os dois últimos update()
+    double glCallsIssued;      // Chamadas de estado GL do último frame que foram ao driver
+    double glCallsElided;      // ... e evitadas pelo GLStateCache
+    // Última medição registrada (addDataPoint)
+    uint64_t dataPoints;
+    double fps;
+    double cpuUsage;
+    double gpuUsage;
+    double gpuFrameMs;
+    int64_t triangleCount;
+    char phase[32];
+};
+
+struct SharedTelemetryBlock {
+    uint32_t magic;                    // SharedTelemetry::MAGIC depois de inicializado
+    uint32_t version;
+    int32_t pid;
+    char program[32];
+    std::atomic<uint32_t> sequence;    // Seqlock: ímpar enquanto data está sendo escrito
+    SharedTelemetryFrame data;
+};
+
+// Bloco de telemetria em memória compartilhada POSIX (/dev/shm/glperf.<pid>),
+// escrito pela thread de render a cada frame com um seqlock: a escrita é uma
+// cópia entre dois incrementos do contador, sem syscall nem trava, e o leitor
+// (telemetry_tail) repete a leitura se o contador mudou ou estava ímpar no meio.
+// Vários processos de benchmark no mesmo host podem ser acompanhados sem saída
+// no terminal nem E/S no laço medido. Ativar com GLPERF_SHM=1.
+class SharedTelemetry {
+public:
+    static const uint32_t MAGIC = 0x46504c47;   // "GLPF"
+    static const uint32_t VERSION = 1;
+    static constexpr const char* NAME_PREFIX = "glperf.";
+
+private:
+    SharedTelemetryBlock* block;
+    std::string name;
+
+public:
+    SharedTelemetry();
+    ~SharedTelemetry();
+
+    // Criar /dev/shm/glperf.<pid>; false se shm_open ou mmap falharem
+    bool initialize();
+    void cleanup();
+
+    // Thread de render: publicar o frame (só escritas em memória)
+    void publish(const SharedTelemetryFrame& frame);
+
+    // Cópia consistente do frame publicado; false se o escritor não liberou o bloco a tempo
+    static bool read(const SharedTelemetryBlock* block, SharedTelemetryFrame& frame);
+
+    static bool isRequested();
+};
+
+#endif
@@ -0,0 +1,97 @@
+#include "SimulationThread.h"
+#include "AdvancedRenderer.h"
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <glm/gtc/matrix_transform.hpp>
+
+SimulationThread::SimulationThread(int rateHz)
+    : running(false), triangles(nullptr), rateHz(rateHz > 0 ? rateHz : DEFAULT_RATE_HZ),
+      measuredHz(0.0), stepMs(0.0) {
+}
+
+SimulationThread::~SimulationThread() {
+    stop();
+}
+
+bool SimulationThread::isRequested() {
+    const char* env = std::getenv("GLPERF_SIM_THREAD");
+    return env && std::string(env) == "1";
+}
+
+void SimulationThread::start(std::vector<AdvancedTriangle>& sceneTriangles, const std::vector<uint32_t>& order) {
+    stop();
+    triangles = &sceneTriangles;
+    drawOrder = order;
+    snapshots.reset();
+    measuredHz = 0.0;
+    stepMs = 0.0;
+
+    // Primeiro snapshot publicado aqui: o próximo frame já tem matrizes e a
+    // thread de render nunca precisa ler currentRotation enquanto a simulação roda
+    step(snapshots.writeBuffer(), 0.0f, 0);
+    snapshots.publish();
+
+    running = true;
+    worker = std::thread(&SimulationThread::run, this);
+}
+
+void SimulationThread::stop() {
+    running = false;
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+void SimulationThread::run() {
+    using clock = std::chrono::steady_clock;
+    const auto period = std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(1.0 / rateHz));
+    const float deltaTime = 1.0f / rateHz;
+
+    uint64_t tick = 0;
+    int windowTicks = 0;
+    auto windowStart = clock::now();
+    auto next = windowStart;
+
+    while (running.load(std::memory_order_relaxed)) {
+        auto stepBegin = clock::now();
+        step(snapshots.writeBuffer(), deltaTime, ++tick);
+        snapshots.publish();
+        auto stepEnd = clock::now();
+        stepMs = std::chrono::duration<double, std::milli>(stepEnd - stepBegin).count();
+
+        windowTicks++;
+        double windowSeconds = std::chrono::duration<double>(stepEnd - windowStart).count();
+        if (windowSeconds >= 1.0) {
+            measuredHz = windowTicks / windowSeconds;
+            windowTicks = 0;
+            windowStart = stepEnd;
+        }
+
+        // Passo fixo; atrasada, a simulação segue do instante atual sem acumular passos
+        next += period;
+        if (next < stepEnd) {
+            next = stepEnd;
+        }
+        std::this_thread::sleep_until(next);
+    }
+}
+
+void SimulationThread::step(SimulationSnapshot& snapshot, float deltaTime, uint64_t tick) {
+    // Os slots só crescem: depois dos três primeiros passos não há mais alocação
+    snapshot.transforms.resize(drawOrder.size());
+    snapshot.tick = tick;
+
+    for (size_t n = 0; n < drawOrder.size(); ++n) {
+        AdvancedTriangle& triangle = (*triangles)[drawOrder[n]];
+        triangle.currentRotation += triangle.rotationSpeed * deltaTime;
+        if (triangle.currentRotation > 2 * M_PI) {
+            triangle.currentRotation = 0.0f;
+        }
+
+        glm::mat4 transform = glm::translate(glm::mat4(1.0f), glm::vec3(triangle.x, triangle.y, triangle.z));
+        snapshot.transforms[n] = glm::rotate(transform, triangle.currentRotation, glm::vec3(0.0f, 0.0f, 1.0f));
+    }
+}
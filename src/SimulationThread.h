@@ -0,0 +1,72 @@
+#ifndef SIMULATIONTHREAD_H
+#define SIMULATIONTHREAD_H
+
+#include <glm/glm.hpp>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "TripleBuffer.h"
+
+struct AdvancedTriangle;
+
+// Estado dos triângulos pronto para desenhar, na ordem de desenho
+struct SimulationSnapshot {
+    std::vector<glm::mat4> transforms;
+    uint64_t tick;
+
+    SimulationSnapshot() : tick(0) {}
+};
+
+// Thread de simulação: avança a rotação dos triângulos em passo fixo
+// (DEFAULT_RATE_HZ) e publica as matrizes de cada passo por um TripleBuffer.
+// A thread de render só adquire o snapshot mais recente, sem travas nem cópias,
+// e segue no seu próprio ritmo; se a simulação não alcança a taxa pedida, os
+// frames reusam o último snapshot.
+//
+// Durante a execução a simulação é a única a escrever currentRotation; quem
+// muda os triângulos (contagem, profundidade, ordem) precisa chamar stop() antes.
+class SimulationThread {
+public:
+    static const int DEFAULT_RATE_HZ = 120;
+
+private:
+    std::thread worker;
+    std::atomic<bool> running;
+    TripleBuffer<SimulationSnapshot> snapshots;
+
+    std::vector<AdvancedTriangle>* triangles;
+    std::vector<uint32_t> drawOrder;
+    int rateHz;
+
+    // Medições publicadas pela thread de simulação
+    std::atomic<double> measuredHz;
+    std::atomic<double> stepMs;
+
+    void run();
+    void step(SimulationSnapshot& snapshot, float deltaTime, uint64_t tick);
+
+public:
+    explicit SimulationThread(int rateHz = DEFAULT_RATE_HZ);
+    ~SimulationThread();
+
+    // Começar a simular os triângulos dados (o vetor precisa continuar vivo até stop())
+    void start(std::vector<AdvancedTriangle>& sceneTriangles, const std::vector<uint32_t>& order);
+    void stop();
+    bool isRunning() const { return running.load(); }
+
+    // Trazer o snapshot mais recente; false se nada novo foi publicado desde a última chamada
+    bool acquire() { return snapshots.acquire(); }
+    const SimulationSnapshot& getSnapshot() const { return snapshots.readBuffer(); }
+
+    int getRateHz() const { return rateHz; }
+    // Passos por segundo realmente executados (medido a cada segundo)
+    double getMeasuredHz() const { return measuredHz.load(); }
+    // Tempo de CPU do último passo
+    double getStepMs() const { return stepMs.load(); }
+
+    // GLPERF_SIM_THREAD=1 liga a simulação em thread separada
+    static bool isRequested();
+};
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+
+// Fila circular sem travas para um produtor e um consumidor, com capacidade
+// fixa (potência de 2). Cada lado só escreve o seu índice; o outro o lê com
+// acquire para saber até onde os slots já foram escritos/consumidos.
+// push() falha com a fila cheia em vez de esperar.
+template <typename T, size_t CAPACITY>
+class SpscQueue {
+private:
+    static_assert(CAPACITY > 0 && (CAPACITY & (CAPACITY - 1)) == 0, "capacidade deve ser potência de 2");
+
+    T slots[CAPACITY];
+    // Índices em linhas de cache separadas: produtor e consumidor não disputam a mesma linha
+    alignas(64) std::atomic<size_t> head;   // Próximo a consumir (só o consumidor escreve)
+    alignas(64) std::atomic<size_t> tail;   // Próximo a produzir (só o produtor escreve)
+
+public:
+    SpscQueue() : head(0), tail(0) {}
+
+    // Produtor: false se a fila está cheia
+    bool push(const T& value) {
+        size_t position = tail.load(std::memory_order_relaxed);
+        if (position - head.load(std::memory_order_acquire) == CAPACITY) {
+            return false;
+        }
+        slots[position & (CAPACITY - 1)] = value;
+        tail.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumidor: false se não há nada na fila
+    bool pop(T& value) {
+        size_t position = head.load(std::memory_order_relaxed);
+        if (position == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        value = slots[position & (CAPACITY - 1)];
+        head.store(position + 1, std::memory_order_release);
+        return true;
+    }
+};
+
+#endif
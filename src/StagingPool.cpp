@@ -0,0 +1,104 @@
+#include "StagingPool.h"
+#include <iostream>
+#include <algorithm>
+#include <new>
+#include <sys/mman.h>
+
+std::mutex StagingPool::mutex;
+std::vector<StagingPool::Block> StagingPool::freeBlocks;
+size_t StagingPool::reservedBytes = 0;
+size_t StagingPool::peakReservedBytes = 0;
+uint64_t StagingPool::mapCount = 0;
+uint64_t StagingPool::reuseCount = 0;
+
+void* StagingPool::acquire(size_t bytes, size_t& capacity) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        // Menor bloco livre que comporta o pedido
+        auto best = freeBlocks.end();
+        for (auto it = freeBlocks.begin(); it != freeBlocks.end(); ++it) {
+            if (it->capacity >= bytes && (best == freeBlocks.end() || it->capacity < best->capacity)) {
+                best = it;
+            }
+        }
+        if (best != freeBlocks.end()) {
+            void* memory = best->memory;
+            capacity = best->capacity;
+            freeBlocks.erase(best);
+            reuseCount++;
+            return memory;
+        }
+    }
+
+    capacity = std::max<size_t>(1, (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE) * HUGE_PAGE_SIZE;
+    void* memory = mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        std::cerr << "Erro ao reservar " << capacity << " bytes de staging" << std::endl;
+        throw std::bad_alloc();
+    }
+#ifdef MADV_HUGEPAGE
+    // Só um pedido: sem THP no kernel as páginas continuam de 4 KB
+    madvise(memory, capacity, MADV_HUGEPAGE);
+#endif
+
+    std::lock_guard<std::mutex> lock(mutex);
+    reservedBytes += capacity;
+    peakReservedBytes = std::max(peakReservedBytes, reservedBytes);
+    mapCount++;
+    return memory;
+}
+
+void StagingPool::release(void* memory, size_t capacity) {
+    if (!memory) return;
+
+    Block evicted = {nullptr, 0};
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        freeBlocks.push_back({memory, capacity});
+        if (freeBlocks.size() > MAX_FREE_BLOCKS) {
+            auto smallest = std::min_element(freeBlocks.begin(), freeBlocks.end(),
+                                             [](const Block& a, const Block& b) { return a.capacity < b.capacity; });
+            evicted = *smallest;
+            freeBlocks.erase(smallest);
+            reservedBytes -= evicted.capacity;
+        }
+    }
+    if (evicted.memory) {
+        munmap(evicted.memory, evicted.capacity);
+    }
+}
+
+void StagingPool::trim() {
+    std::vector<Block> blocks;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        blocks.swap(freeBlocks);
+        for (const Block& block : blocks) {
+            reservedBytes -= block.capacity;
+        }
+    }
+    for (const Block& block : blocks) {
+        munmap(block.memory, block.capacity);
+    }
+}
+
+size_t StagingPool::getReservedBytes() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return reservedBytes;
+}
+
+size_t StagingPool::getPeakReservedBytes() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return peakReservedBytes;
+}
+
+uint64_t StagingPool::getMapCount() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return mapCount;
+}
+
+uint64_t StagingPool::getReuseCount() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return reuseCount;
+}
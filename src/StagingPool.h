@@ -0,0 +1,74 @@
+#ifndef STAGINGPOOL_H
+#define STAGINGPOOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// Pool de buffers grandes de staging (vértices montados antes do glBufferData,
+// blocos da FrameArena). A memória vem de mmap em múltiplos de 2 MB com
+// MADV_HUGEPAGE, então um buffer de vários MB ocupa poucas entradas de TLB, e
+// buffers devolvidos são reaproveitados pelo próximo pedido que caiba neles
+// (o passo seguinte de um teste não volta ao heap nem ao kernel).
+class StagingPool {
+public:
+    static const size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+    static const size_t MAX_FREE_BLOCKS = 4;   // Além disso o menor bloco livre é devolvido ao sistema
+
+private:
+    struct Block {
+        void* memory;
+        size_t capacity;
+    };
+
+    static std::mutex mutex;
+    static std::vector<Block> freeBlocks;
+    static size_t reservedBytes;    // Mapeado no momento (em uso + livre)
+    static size_t peakReservedBytes;
+    static uint64_t mapCount;       // Buffers criados com mmap
+    static uint64_t reuseCount;     // Pedidos atendidos por um buffer livre
+
+public:
+    // Buffer com pelo menos "bytes" bytes; capacity recebe o tamanho real
+    static void* acquire(size_t bytes, size_t& capacity);
+    static void release(void* memory, size_t capacity);
+    // Devolver ao sistema todos os buffers livres
+    static void trim();
+
+    static size_t getReservedBytes();
+    static size_t getPeakReservedBytes();
+    static uint64_t getMapCount();
+    static uint64_t getReuseCount();
+};
+
+// Buffer do pool com dono único; volta ao pool no destrutor
+class StagingBuffer {
+private:
+    void* memory;
+    size_t capacity;
+
+public:
+    StagingBuffer() : memory(nullptr), capacity(0) {}
+    explicit StagingBuffer(size_t bytes) : memory(nullptr), capacity(0) {
+        memory = StagingPool::acquire(bytes, capacity);
+    }
+    ~StagingBuffer() { reset(); }
+    StagingBuffer(const StagingBuffer&) = delete;
+    StagingBuffer& operator=(const StagingBuffer&) = delete;
+
+    void reset() {
+        if (memory) {
+            StagingPool::release(memory, capacity);
+            memory = nullptr;
+            capacity = 0;
+        }
+    }
+
+    void* data() const { return memory; }
+    size_t getCapacity() const { return capacity; }
+    template <typename T>
+    T* as() const { return static_cast<T*>(memory); }
+};
+
+#endif
@@ -0,0 +1,130 @@
+#include "StartupProfile.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <algorithm>
+#include <ctime>
+#include <sstream>
+#include <sys/stat.h>
+
+namespace {
+
+// Fases abertas na thread atual (para a indentação das aninhadas)
+thread_local int openScopes = 0;
+
+// Coluna com largura em caracteres, não em bytes (nomes das fases têm acentos)
+std::string pad(const std::string& text, size_t width, bool left) {
+    size_t characters = 0;
+    for (unsigned char c : text) {
+        if ((c & 0xC0) != 0x80) characters++;
+    }
+    std::string fill(characters < width ? width - characters : 1, ' ');
+    return left ? text + fill : fill + text;
+}
+
+std::string formatMs(double value) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1) << value;
+    return out.str();
+}
+
+}
+
+std::chrono::steady_clock::time_point StartupProfile::origin = std::chrono::steady_clock::now();
+std::thread::id StartupProfile::mainThread = std::this_thread::get_id();
+std::vector<StartupProfile::Phase> StartupProfile::phases;
+std::mutex StartupProfile::mutex;
+bool StartupProfile::finished = false;
+
+StartupProfile::Scope::Scope(const std::string& name) : name(name), begin(std::chrono::steady_clock::now()) {
+    openScopes++;
+}
+
+StartupProfile::Scope::~Scope() {
+    auto end = std::chrono::steady_clock::now();
+    openScopes--;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (finished) {
+        return;
+    }
+    Phase phase;
+    phase.name = name;
+    phase.startMs = toMs(begin);
+    phase.durationMs = std::chrono::duration<double, std::milli>(end - begin).count();
+    phase.depth = openScopes;
+    phase.background = std::this_thread::get_id() != mainThread;
+    phases.push_back(phase);
+}
+
+double StartupProfile::toMs(std::chrono::steady_clock::time_point time) {
+    return std::chrono::duration<double, std::milli>(time - origin).count();
+}
+
+void StartupProfile::start() {
+    std::lock_guard<std::mutex> lock(mutex);
+    origin = std::chrono::steady_clock::now();
+    mainThread = std::this_thread::get_id();
+}
+
+double StartupProfile::elapsedMs() {
+    return toMs(std::chrono::steady_clock::now());
+}
+
+void StartupProfile::report(const std::string& programName, double timeToFirstFrameMs) {
+    std::vector<Phase> recorded;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (finished) {
+            return;
+        }
+        finished = true;
+        recorded.swap(phases);
+    }
+    // Fases aninhadas terminam antes das externas: ordenar pelo início
+    std::stable_sort(recorded.begin(), recorded.end(),
+                     [](const Phase& a, const Phase& b) { return a.startMs < b.startMs; });
+
+    // O que sobra depois da última fase da thread principal é o primeiro frame (render + swap)
+    double mainEnd = 0.0;
+    for (const Phase& phase : recorded) {
+        if (!phase.background) {
+            mainEnd = std::max(mainEnd, phase.startMs + phase.durationMs);
+        }
+    }
+
+    std::cout << "\n=== Perfil de inicialização (" << programName << ") ===" << std::endl;
+    std::cout << pad("Fase", 42, true) << pad("Início (ms)", 12, false) << pad("Duração (ms)", 14, false)
+              << std::endl;
+    for (const Phase& phase : recorded) {
+        std::string label = std::string(phase.depth * 2, ' ') + phase.name + (phase.background ? " [fundo]" : "");
+        std::cout << pad(label, 42, true) << pad(formatMs(phase.startMs), 12, false)
+                  << pad(formatMs(phase.durationMs), 14, false) << std::endl;
+    }
+    std::cout << pad("Primeiro frame", 42, true) << pad(formatMs(mainEnd), 12, false)
+              << pad(formatMs(std::max(0.0, timeToFirstFrameMs - mainEnd)), 14, false) << std::endl;
+    std::cout << "Tempo até o primeiro frame: " << formatMs(timeToFirstFrameMs) << " ms" << std::endl;
+
+    mkdir("data", 0755);
+    const std::string filename = "data/startup_profile.csv";
+    std::ifstream existing(filename);
+    bool newFile = !existing.good() || existing.peek() == std::ifstream::traits_type::eof();
+    existing.close();
+
+    std::ofstream file(filename, std::ios::app);
+    if (!file.is_open()) {
+        std::cerr << "Erro ao gravar " << filename << std::endl;
+        return;
+    }
+    if (newFile) {
+        file << "Program,Run,Phase,Thread,Depth,Start_ms,Duration_ms\n";
+    }
+    // Run agrupa as fases de uma execução
+    long run = (long)std::time(nullptr);
+    for (const Phase& phase : recorded) {
+        file << programName << "," << run << "," << phase.name << "," << (phase.background ? "background" : "main")
+             << "," << phase.depth << "," << phase.startMs << "," << phase.durationMs << "\n";
+    }
+    file << programName << "," << run << ",Primeiro frame,main,0," << mainEnd << ","
+         << std::max(0.0, timeToFirstFrameMs - mainEnd) << "\n";
+}
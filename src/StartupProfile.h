@@ -0,0 +1,56 @@
+#ifndef STARTUPPROFILE_H
+#define STARTUPPROFILE_H
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Perfil da inicialização: cada fase (contexto GL, GLEW, shaders, textura,
+// cena, monitor...) é medida por um Scope e o conjunto é impresso e gravado em
+// data/startup_profile.csv junto com o tempo até o primeiro frame. Fases de
+// threads de fundo entram marcadas como tal (sobrepõem as da thread principal).
+// Depois de report() os Scopes não registram mais nada: o que é inicializado
+// sob demanda durante a execução não entra no perfil.
+class StartupProfile {
+public:
+    // Mede do construtor ao destrutor; fases aninhadas aparecem indentadas
+    class Scope {
+    private:
+        std::string name;
+        std::chrono::steady_clock::time_point begin;
+
+    public:
+        explicit Scope(const std::string& name);
+        ~Scope();
+    };
+
+private:
+    struct Phase {
+        std::string name;
+        double startMs;
+        double durationMs;
+        int depth;
+        bool background;
+    };
+
+    static std::chrono::steady_clock::time_point origin;
+    static std::thread::id mainThread;
+    static std::vector<Phase> phases;
+    static std::mutex mutex;
+    static bool finished;
+
+    static double toMs(std::chrono::steady_clock::time_point time);
+
+public:
+    // Instante zero do perfil e thread principal (início do main)
+    static void start();
+    // Tempo desde start() em ms
+    static double elapsedMs();
+
+    // Imprimir o perfil e acrescentá-lo ao CSV; chamado uma vez, no primeiro frame
+    static void report(const std::string& programName, double timeToFirstFrameMs);
+};
+
+#endif
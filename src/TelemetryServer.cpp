@@ -0,0 +1,320 @@
+#include "TelemetryServer.h"
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+const int TelemetrySnapshot::FRAME_WINDOW;
+const int TelemetryServer::PUBLISH_INTERVAL_MS;
+
+namespace {
+
+// Tamanho máximo de uma requisição (cabeçalhos + corpo): comandos são uma linha
+const size_t MAX_REQUEST_BYTES = 8192;
+
+void sendAll(int fd, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) continue;
+            return;
+        }
+        sent += n;
+    }
+}
+
+void sendResponse(int fd, int status, const char* reason, const char* contentType, const std::string& body) {
+    std::ostringstream response;
+    response << "HTTP/1.1 " << status << " " << reason << "\r\n"
+             << "Content-Type: " << contentType << "\r\n"
+             << "Content-Length: " << body.size() << "\r\n"
+             << "Connection: close\r\n\r\n"
+             << body;
+    sendAll(fd, response.str());
+}
+
+std::string trim(const std::string& text) {
+    size_t begin = text.find_first_not_of(" \t\r\n");
+    if (begin == std::string::npos) return "";
+    return text.substr(begin, text.find_last_not_of(" \t\r\n") - begin + 1);
+}
+
+const char* USAGE =
+    "GET  /metrics   estado do teste (formato texto do Prometheus)\n"
+    "POST /command   um comando por requisição:\n"
+    "  start               iniciar a varredura automática (ESPAÇO)\n"
+    "  stop                interromper a varredura\n"
+    "  triangles N         trocar a contagem de triângulos (1 até o máximo do teste)\n"
+    "  mode <N ou nome>    trocar o modo (1 a N ou o nome da fase)\n"
+    "  report              gravar CSV e relatório com as medições até agora\n";
+
+}
+
+TelemetryServer::TelemetryServer(const std::vector<std::string>& modeNames, int64_t maxTriangles)
+    : running(false), listenFd(-1), port(0), modeNames(modeNames), maxTriangles(maxTriangles),
+      rejectedCommands(0), frameSamples(0), frameNext(0), framesTotal(0), frameMsTotal(0.0) {
+}
+
+TelemetryServer::~TelemetryServer() {
+    stop();
+}
+
+int TelemetryServer::requestedPort() {
+    const char* env = std::getenv("GLPERF_TELEMETRY_PORT");
+    if (!env) return 0;
+    int value = std::atoi(env);
+    if (value == 1) return DEFAULT_PORT;
+    return (value > 0 && value < 65536) ? value : 0;
+}
+
+bool TelemetryServer::start(int requested) {
+    stop();
+
+    listenFd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listenFd < 0) {
+        std::cerr << "Telemetria: erro ao criar socket: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    int reuse = 1;
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    // Só localhost: os comandos mudam o teste e não há autenticação
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons((uint16_t)requested);
+    if (bind(listenFd, (sockaddr*)&address, sizeof(address)) < 0 || listen(listenFd, 8) < 0) {
+        std::cerr << "Telemetria: porta " << requested << " indisponível: " << std::strerror(errno) << std::endl;
+        close(listenFd);
+        listenFd = -1;
+        return false;
+    }
+
+    port = requested;
+    running = true;
+    worker = std::thread(&TelemetryServer::run, this);
+    std::cout << "Telemetria em http://127.0.0.1:" << port << "/metrics (comandos em POST /command)" << std::endl;
+    return true;
+}
+
+void TelemetryServer::stop() {
+    running = false;
+    if (worker.joinable()) {
+        worker.join();
+    }
+    if (listenFd >= 0) {
+        close(listenFd);
+        listenFd = -1;
+    }
+}
+
+void TelemetryServer::recordFrame(double frameMs) {
+    frameWindow[frameNext] = frameMs;
+    frameNext = (frameNext + 1) % TelemetrySnapshot::FRAME_WINDOW;
+    frameSamples = std::min(frameSamples + 1, TelemetrySnapshot::FRAME_WINDOW);
+    framesTotal++;
+    frameMsTotal += frameMs;
+}
+
+void TelemetryServer::publish(const TelemetryState& state) {
+    // Copiar a janela a cada frame seria desperdício: o Prometheus lê a cada poucos segundos
+    if (!isPublishDue()) {
+        return;
+    }
+    lastPublish = std::chrono::steady_clock::now();
+
+    TelemetrySnapshot& snapshot = snapshots.writeBuffer();
+    snapshot.state = state;
+    std::copy(frameWindow, frameWindow + frameSamples, snapshot.frameMs);
+    snapshot.frameSamples = frameSamples;
+    snapshot.framesTotal = framesTotal;
+    snapshot.frameMsTotal = frameMsTotal;
+    snapshots.publish();
+}
+
+void TelemetryServer::run() {
+    pollfd listener = {listenFd, POLLIN, 0};
+    while (running.load(std::memory_order_relaxed)) {
+        // Timeout curto só para perceber o stop()
+        if (poll(&listener, 1, 200) <= 0 || !(listener.revents & POLLIN)) {
+            continue;
+        }
+        int client = accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (client < 0) {
+            continue;
+        }
+        // Um cliente parado não pode segurar o servidor
+        timeval timeout = {1, 0};
+        setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        handleClient(client);
+        close(client);
+    }
+}
+
+void TelemetryServer::handleClient(int fd) {
+    // Ler cabeçalhos e o corpo indicado em Content-Length
+    std::string request;
+    size_t headerEnd = std::string::npos;
+    size_t contentLength = 0;
+    char buffer[2048];
+    while (request.size() < MAX_REQUEST_BYTES) {
+        ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        request.append(buffer, n);
+        if (headerEnd == std::string::npos) {
+            headerEnd = request.find("\r\n\r\n");
+            if (headerEnd != std::string::npos) {
+                std::string headers = request.substr(0, headerEnd);
+                std::transform(headers.begin(), headers.end(), headers.begin(), ::tolower);
+                size_t field = headers.find("\r\ncontent-length:");
+                if (field != std::string::npos) {
+                    contentLength = std::strtoul(headers.c_str() + field + 17, nullptr, 10);
+                }
+            }
+        }
+        if (headerEnd != std::string::npos && request.size() >= headerEnd + 4 + contentLength) {
+            break;
+        }
+    }
+    if (headerEnd == std::string::npos) {
+        sendResponse(fd, 400, "Bad Request", "text/plain; charset=utf-8", "Requisição incompleta\n");
+        return;
+    }
+
+    std::istringstream requestLine(request.substr(0, request.find("\r\n")));
+    std::string method, target;
+    requestLine >> method >> target;
+    std::string path = target.substr(0, target.find('?'));
+
+    if (method == "GET" && path == "/metrics") {
+        sendResponse(fd, 200, "OK", "text/plain; version=0.0.4; charset=utf-8", renderMetrics());
+    } else if (method == "POST" && path == "/command") {
+        TelemetryCommand command;
+        std::string body = request.substr(headerEnd + 4, contentLength);
+        if (!parseCommand(trim(body), command)) {
+            rejectedCommands++;
+            sendResponse(fd, 400, "Bad Request", "text/plain; charset=utf-8",
+                         "Comando inválido: " + trim(body) + "\n\n" + USAGE);
+        } else if (!commands.push(command)) {
+            // A thread de render não está esvaziando a fila (travada em um frame longo)
+            rejectedCommands++;
+            sendResponse(fd, 503, "Service Unavailable", "text/plain; charset=utf-8", "Fila de comandos cheia\n");
+        } else {
+            // Aplicado pela thread de render no início do próximo frame
+            sendResponse(fd, 202, "Accepted", "text/plain; charset=utf-8", "ok\n");
+        }
+    } else if (method == "GET" && path == "/") {
+        sendResponse(fd, 200, "OK", "text/plain; charset=utf-8", USAGE);
+    } else {
+        sendResponse(fd, 404, "Not Found", "text/plain; charset=utf-8", USAGE);
+    }
+}
+
+bool TelemetryServer::parseCommand(const std::string& text, TelemetryCommand& command) const {
+    size_t space = text.find(' ');
+    std::string name = text.substr(0, space);
+    std::string argument = space == std::string::npos ? "" : trim(text.substr(space + 1));
+
+    if (name == "start" && argument.empty()) {
+        command.type = TelemetryCommand::START_SWEEP;
+    } else if (name == "stop" && argument.empty()) {
+        command.type = TelemetryCommand::STOP_SWEEP;
+    } else if (name == "report" && argument.empty()) {
+        command.type = TelemetryCommand::DUMP_REPORT;
+    } else if (name == "triangles") {
+        char* end = nullptr;
+        long long count = std::strtoll(argument.c_str(), &end, 10);
+        if (argument.empty() || *end != '\0' || count <= 0 || count > maxTriangles) {
+            return false;
+        }
+        command.type = TelemetryCommand::SET_TRIANGLES;
+        command.value = count;
+    } else if (name == "mode") {
+        // Número do modo (como nas mensagens "Teste N/12") ou nome da fase
+        char* end = nullptr;
+        long number = std::strtol(argument.c_str(), &end, 10);
+        int index = -1;
+        if (!argument.empty() && *end == '\0') {
+            index = (int)number - 1;
+        } else {
+            for (size_t i = 0; i < modeNames.size(); ++i) {
+                if (modeNames[i] == argument) {
+                    index = (int)i;
+                }
+            }
+        }
+        if (index < 0 || index >= (int)modeNames.size()) {
+            return false;
+        }
+        command.type = TelemetryCommand::SET_MODE;
+        command.value = index;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+std::string TelemetryServer::renderMetrics() {
+    snapshots.acquire();
+    const TelemetrySnapshot& snapshot = snapshots.readBuffer();
+    const TelemetryState& state = snapshot.state;
+
+    // Percentis por posição na janela ordenada
+    std::vector<double> frames(snapshot.frameMs, snapshot.frameMs + snapshot.frameSamples);
+    std::sort(frames.begin(), frames.end());
+    auto percentile = [&frames](double q) {
+        if (frames.empty()) return 0.0;
+        return frames[std::min(frames.size() - 1, (size_t)(q * frames.size()))];
+    };
+
+    std::ostringstream out;
+    out.precision(10);
+    auto gauge = [&out](const char* name, const char* help, double value) {
+        out << "# HELP " << name << " " << help << "\n# TYPE " << name << " gauge\n" << name << " " << value << "\n";
+    };
+
+    gauge("glperf_fps", "FPS da última medição (janela de 2 s)", state.fps);
+
+    out << "# HELP glperf_frame_time_ms Tempo de CPU por frame nos últimos "
+        << TelemetrySnapshot::FRAME_WINDOW << " frames\n# TYPE glperf_frame_time_ms summary\n";
+    const double quantiles[] = {0.5, 0.9, 0.99};
+    for (double q : quantiles) {
+        out << "glperf_frame_time_ms{quantile=\"" << q << "\"} " << percentile(q) << "\n";
+    }
+    out << "glperf_frame_time_ms_sum " << snapshot.frameMsTotal << "\n"
+        << "glperf_frame_time_ms_count " << snapshot.framesTotal << "\n";
+
+    gauge("glperf_triangles", "Triângulos desenhados", (double)state.triangleCount);
+    gauge("glperf_lights", "Luzes habilitadas", state.lightCount);
+
+    out << "# HELP glperf_mode Modo atual do teste (1 na fase em andamento)\n# TYPE glperf_mode gauge\n";
+    if (state.mode >= 0 && state.mode < (int)modeNames.size()) {
+        out << "glperf_mode{index=\"" << state.mode + 1 << "\",name=\"" << modeNames[state.mode] << "\"} 1\n";
+    }
+    gauge("glperf_sweep_running", "Varredura automática em andamento", state.running ? 1.0 : 0.0);
+    gauge("glperf_sweep_complete", "Varredura automática concluída", state.complete ? 1.0 : 0.0);
+    gauge("glperf_data_points", "Medições registradas pelo PerformanceMonitor", (double)state.dataPoints);
+
+    // Amostras do PerformanceMonitor: só existem depois da primeira medição
+    if (state.cpuUsage >= 0.0) {
+        gauge("glperf_cpu_usage_percent", "Uso de CPU na última medição", state.cpuUsage);
+        gauge("glperf_gpu_usage_percent", "Uso de GPU na última medição", state.gpuUsage);
+    }
+    gauge("glperf_gpu_frame_ms", "Tempo de GPU da cena (GL_TIME_ELAPSED, 0 se não medido)", state.gpuFrameMs);
+
+    out << "# HELP glperf_commands_rejected_total Comandos recusados (inválidos ou fila cheia)\n"
+        << "# TYPE glperf_commands_rejected_total counter\n"
+        << "glperf_commands_rejected_total " << rejectedCommands << "\n";
+    return out.str();
+}
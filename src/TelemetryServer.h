@@ -0,0 +1,121 @@
+#ifndef TELEMETRYSERVER_H
+#define TELEMETRYSERVER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+#include "SpscQueue.h"
+#include "TripleBuffer.h"
+
+// Comando recebido pelo socket, aplicado pela thread de render entre frames
+struct TelemetryCommand {
+    enum Type { START_SWEEP, STOP_SWEEP, SET_TRIANGLES, SET_MODE, DUMP_REPORT };
+    Type type;
+    int64_t value;   // Triângulos (SET_TRIANGLES) ou índice do modo (SET_MODE)
+
+    TelemetryCommand() : type(START_SWEEP), value(0) {}
+};
+
+// Estado do teste informado pela thread de render
+struct TelemetryState {
+    double fps;              // Última medição (a cada 2 s)
+    int64_t triangleCount;
+    int mode;                // Índice em modeNames
+    bool running;
+    bool complete;
+    double cpuUsage;         // Última amostra do PerformanceMonitor (-1 sem medições)
+    double gpuUsage;
+    double gpuFrameMs;       // Tempo de GPU da cena (RenderStats)
+    int lightCount;
+    size_t dataPoints;       // Medições registradas até agora
+
+    TelemetryState() : fps(0.0), triangleCount(0), mode(0), running(false), complete(false),
+                       cpuUsage(-1.0), gpuUsage(-1.0), gpuFrameMs(0.0), lightCount(0), dataPoints(0) {}
+};
+
+// O que a thread do servidor lê: estado + janela dos últimos tempos de frame
+struct TelemetrySnapshot {
+    static const int FRAME_WINDOW = 512;
+
+    TelemetryState state;
+    double frameMs[FRAME_WINDOW];   // Sem ordem (só os percentis interessam)
+    int frameSamples;
+    uint64_t framesTotal;
+    double frameMsTotal;
+
+    TelemetrySnapshot() : frameSamples(0), framesTotal(0), frameMsTotal(0.0) {}
+};
+
+// Telemetria e controle de um teste em execução por HTTP em 127.0.0.1
+// (GLPERF_TELEMETRY_PORT=N). GET /metrics devolve o estado no formato texto
+// do Prometheus (FPS, percentis do tempo de frame, triângulos, modo, amostras
+// de CPU/GPU) e POST /command recebe os comandos que substituem o teclado:
+//   start | stop | triangles N | mode <número ou nome> | report
+// ("triangles" fora de 1..maxTriangles responde 400)
+//
+// O servidor roda em thread própria e nunca toca no GL nem espera a thread de
+// render: os comandos vão por uma SpscQueue que o laço de render esvazia entre
+// frames, e o estado volta por um TripleBuffer publicado no máximo a cada
+// PUBLISH_INTERVAL_MS. Do lado do render, cada frame custa uma escrita no anel
+// de tempos de frame.
+class TelemetryServer {
+public:
+    static const size_t COMMAND_CAPACITY = 64;
+    static const int PUBLISH_INTERVAL_MS = 100;
+    static const int DEFAULT_PORT = 9464;
+
+private:
+    std::thread worker;
+    std::atomic<bool> running;
+    int listenFd;
+    int port;
+    std::vector<std::string> modeNames;
+    int64_t maxTriangles;        // Limite de "triangles N" (o mesmo da varredura)
+
+    SpscQueue<TelemetryCommand, COMMAND_CAPACITY> commands;
+    TripleBuffer<TelemetrySnapshot> snapshots;
+    uint64_t rejectedCommands;   // Fila cheia ou comando inválido (só a thread do servidor)
+
+    // Só a thread de render
+    double frameWindow[TelemetrySnapshot::FRAME_WINDOW];
+    int frameSamples;
+    int frameNext;
+    uint64_t framesTotal;
+    double frameMsTotal;
+    std::chrono::steady_clock::time_point lastPublish;
+
+    void run();
+    void handleClient(int fd);
+    bool parseCommand(const std::string& text, TelemetryCommand& command) const;
+    std::string renderMetrics();
+
+public:
+    TelemetryServer(const std::vector<std::string>& modeNames, int64_t maxTriangles);
+    ~TelemetryServer();
+
+    // Escutar em 127.0.0.1:port e iniciar a thread; false se o bind falhar
+    bool start(int port);
+    void stop();
+
+    // Thread de render: tempo de CPU de cada frame e estado do teste
+    void recordFrame(double frameMs);
+    // Já passou PUBLISH_INTERVAL_MS desde a última publicação: consultar antes
+    // de montar o estado, para os frames intermediários não custarem nada
+    bool isPublishDue() const {
+        return std::chrono::steady_clock::now() - lastPublish >= std::chrono::milliseconds(PUBLISH_INTERVAL_MS);
+    }
+    void publish(const TelemetryState& state);
+    // Próximo comando pendente; false se a fila está vazia
+    bool pollCommand(TelemetryCommand& command) { return commands.pop(command); }
+
+    int getPort() const { return port; }
+
+    // Porta pedida em GLPERF_TELEMETRY_PORT (0 = desligado; "1" usa DEFAULT_PORT)
+    static int requestedPort();
+};
+
+#endif
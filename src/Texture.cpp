@@ -1,8 +1,50 @@
 #include "Texture.h"
+#include "ParallelFor.h"
+#include "AssetCache.h"
+#include "GLStateCache.h"
+#include "GLProfiler.h"
 #include <iostream>
 #include <cmath>
+#include <chrono>
+#include <cstdint>
+#include <algorithm>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
-Texture::Texture() : textureID(0), width(0), height(0), nrChannels(0) {
+namespace {
+
+size_t mipChainBytes(int width, int height, TextureFormat format) {
+    size_t total = 0;
+    while (true) {
+        total += TextureCompression::imageSize(width, height, format);
+        if (width == 1 && height == 1) break;
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+    }
+    return total;
+}
+
+int mipLevelCount(int width, int height) {
+    int levels = 1;
+    while (width > 1 || height > 1) {
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+        levels++;
+    }
+    return levels;
+}
+
+double millisecondsSince(std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+}
+
+Texture::Texture() : textureID(0), target(GL_TEXTURE_2D), width(0), height(0), nrChannels(0),
+                     layers(0), mipLevels(0), format(TextureFormat::RGBA8), compressedOnGPU(false),
+                     memoryBytes(0), minFilter(GL_LINEAR_MIPMAP_LINEAR), magFilter(GL_LINEAR),
+                     anisotropy(1.0f) {
 }
 
 Texture::~Texture() {
@@ -11,82 +53,477 @@ Texture::~Texture() {
 
 bool Texture::loadFromFile(const std::string& filePath) {
     path = filePath;
-    
-    // Por simplicidade, vamos gerar uma textura procedural
-    // Em um projeto real, você usaria stb_image.h para carregar arquivos
-    return generateProcedural();
+
+    MappedAsset asset;
+    if (!asset.open(filePath) || asset.getHeader().kind != ASSET_TEXTURE) {
+        std::cerr << "Erro ao carregar textura (esperado contêiner .glpa): " << filePath << std::endl;
+        return false;
+    }
+    return uploadFromAsset(asset);
 }
 
-bool Texture::generateProcedural(int width, int height) {
-    this->width = width;
-    this->height = height;
-    this->nrChannels = 3;
-    
-    GLubyte* data = generateProceduralTexture(width, height);
-    if (!data) {
+std::string Texture::cacheName(int width, int height, int layers, bool cpuMipmaps,
+                               TextureFormat format, bool compressedOnGPU) {
+    std::string name = "texture_" + std::to_string(width) + "x" + std::to_string(height) +
+                       "x" + std::to_string(layers) + "_" + TextureCompression::formatName(format);
+    if (TextureCompression::isCompressed(format) && !compressedOnGPU) {
+        name += "-decoded";
+    }
+    return name + (cpuMipmaps ? "_cpumips" : "_drivermips");
+}
+
+bool Texture::uploadFromAsset(const MappedAsset& asset) {
+    const AssetHeader& header = asset.getHeader();
+    int assetWidth = header.params[0];
+    int assetHeight = header.params[1];
+    int assetLayers = header.params[2];
+    TextureFormat assetFormat = static_cast<TextureFormat>(header.params[3]);
+    bool allLevels = header.params[4] != 0;
+    if (assetLayers < 1 || header.params[3] > (uint32_t)TextureFormat::BC3 ||
+        !checkLimits(assetWidth, assetHeight, assetLayers)) {
+        return false;
+    }
+
+    // Conferir cada bloco antes de entregar ponteiros do mapeamento ao driver
+    int levelCount = mipLevelCount(assetWidth, assetHeight);
+    for (uint32_t i = 0; i < asset.getChunkCount(); ++i) {
+        const AssetChunk& chunk = asset.getChunk(i);
+        int expectedWidth = std::max(1, assetWidth >> chunk.level);
+        int expectedHeight = std::max(1, assetHeight >> chunk.level);
+        TextureFormat chunkFormat = chunk.glFormat == GL_RGBA8 ? TextureFormat::RGBA8 : assetFormat;
+        if ((int)chunk.level >= levelCount || (int)chunk.layer >= assetLayers ||
+            (int)chunk.width != expectedWidth || (int)chunk.height != expectedHeight ||
+            chunk.glFormat != (GLuint)TextureCompression::internalFormat(chunkFormat) ||
+            (assetLayers > 1 && chunk.glFormat != GL_RGBA8) ||
+            chunk.size != TextureCompression::imageSize(expectedWidth, expectedHeight, chunkFormat)) {
+            std::cerr << "Bloco de textura inválido no cache: " << path << std::endl;
+            return false;
+        }
+    }
+
+    cleanup();
+    width = assetWidth;
+    height = assetHeight;
+    nrChannels = 4;
+    layers = assetLayers;
+    format = assetFormat;
+    mipLevels = levelCount;
+    compressedOnGPU = false;
+    memoryBytes = 0;
+
+    if (layers > 1) {
+        createTextureObject(GL_TEXTURE_2D_ARRAY);
+        for (int level = 0; level < mipLevels; ++level) {
+            glTexImage3D(GL_TEXTURE_2D_ARRAY, level, GL_RGBA8, std::max(1, width >> level),
+                         std::max(1, height >> level), layers, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        }
+    } else {
+        createTextureObject(GL_TEXTURE_2D);
+    }
+
+    // Upload direto das páginas mapeadas, sem cópia intermediária
+    for (uint32_t i = 0; i < asset.getChunkCount(); ++i) {
+        const AssetChunk& chunk = asset.getChunk(i);
+        const void* pixels = asset.getChunkData(i);
+        if (layers > 1) {
+            glTexSubImage3D(GL_TEXTURE_2D_ARRAY, chunk.level, 0, 0, chunk.layer, chunk.width, chunk.height, 1,
+                            GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+        } else if (chunk.glFormat == GL_RGBA8) {
+            glTexImage2D(GL_TEXTURE_2D, chunk.level, GL_RGBA8, chunk.width, chunk.height, 0,
+                         GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+        } else {
+            glCompressedTexImage2D(GL_TEXTURE_2D, chunk.level, chunk.glFormat, chunk.width, chunk.height, 0,
+                                   chunk.size, pixels);
+            compressedOnGPU = true;
+        }
+        memoryBytes += chunk.size;
+    }
+
+    if (!allLevels) {
+        glGenerateMipmap(target);
+        memoryBytes = mipChainBytes(width, height, TextureFormat::RGBA8) * layers;
+    }
+    return true;
+}
+
+bool Texture::checkLimits(int width, int height, int layers) {
+    GLint maxSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+    if (width <= 0 || height <= 0 || width > maxSize || height > maxSize) {
+        std::cerr << "Tamanho de textura não suportado: " << width << "x" << height
+                  << " (máximo do driver: " << maxSize << ")" << std::endl;
         return false;
     }
-    
+
+    if (layers > 1) {
+        GLint maxLayers = 0;
+        glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+        if (layers > maxLayers) {
+            std::cerr << "Número de camadas não suportado: " << layers
+                      << " (máximo do driver: " << maxLayers << ")" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+void Texture::createTextureObject(GLenum textureTarget) {
+    target = textureTarget;
     glGenTextures(1, &textureID);
-    glBindTexture(GL_TEXTURE_2D, textureID);
-    
+    GLStateCache::bindTexture(target, textureID);
+
     // Configurar parâmetros da textura
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    
-    // Carregar dados da textura
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
-    glGenerateMipmap(GL_TEXTURE_2D);
-    
-    delete[] data;
-    
-    std::cout << "Textura procedural gerada: " << width << "x" << height << std::endl;
+    glTexParameteri(target, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(target, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    applySampling();
+
+    // Linhas RGBA8 são sempre múltiplas de 4 bytes
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+}
+
+void Texture::applySampling() {
+    // Todos os caminhos de geração deixam a cadeia de mipmaps completa: o padrão é trilinear
+    glTexParameteri(target, GL_TEXTURE_MIN_FILTER, minFilter);
+    glTexParameteri(target, GL_TEXTURE_MAG_FILTER, magFilter);
+    if (GLEW_EXT_texture_filter_anisotropic) {
+        glTexParameterf(target, GL_TEXTURE_MAX_ANISOTROPY_EXT, anisotropy);
+    }
+}
+
+void Texture::setSampling(GLenum minFilter, GLenum magFilter, float anisotropy) {
+    this->minFilter = minFilter;
+    this->magFilter = magFilter;
+    this->anisotropy = std::min(std::max(1.0f, anisotropy), getMaxAnisotropy());
+    if (textureID) {
+        GLStateCache::bindTexture(target, textureID);
+        applySampling();
+    }
+}
+
+float Texture::getMaxAnisotropy() {
+    if (!GLEW_EXT_texture_filter_anisotropic) {
+        return 1.0f;
+    }
+    GLfloat maxAnisotropy = 1.0f;
+    glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &maxAnisotropy);
+    return maxAnisotropy;
+}
+
+const char* Texture::filterName(GLenum filter) {
+    switch (filter) {
+        case GL_NEAREST:                return "nearest";
+        case GL_LINEAR:                 return "linear";
+        case GL_NEAREST_MIPMAP_NEAREST: return "nearest-mip-nearest";
+        case GL_LINEAR_MIPMAP_NEAREST:  return "linear-mip-nearest";
+        case GL_NEAREST_MIPMAP_LINEAR:  return "nearest-mip-linear";
+        case GL_LINEAR_MIPMAP_LINEAR:   return "linear-mip-linear";
+    }
+    return "?";
+}
+
+bool Texture::generateProcedural(int width, int height, bool cpuMipmaps, TextureFormat format) {
+    if (!checkLimits(width, height, 1)) {
+        return false;
+    }
+    cleanup();
+
+    this->width = width;
+    this->height = height;
+    this->nrChannels = 4;
+    this->layers = 1;
+    this->format = format;
+
+    // Níveis comprimidos não podem ser gerados pelo driver (glGenerateMipmap)
+    bool compressed = TextureCompression::isCompressed(format);
+    if (compressed) {
+        cpuMipmaps = true;
+    }
+    compressedOnGPU = compressed && TextureCompression::isHardwareSupported();
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    // Execuções repetidas mapeiam o resultado salvo em vez de gerar de novo.
+    // RGB8/RGBA16F são convertidos pelo driver a partir de RGBA8 e não entram no cache
+    bool driverConverted = !compressed && format != TextureFormat::RGBA8;
+    bool useCache = AssetCache::isEnabled() && !driverConverted;
+    std::string name = cacheName(width, height, 1, cpuMipmaps, format, compressedOnGPU);
+    MappedAsset cached;
+    if (useCache && AssetCache::open(name, ASSET_TEXTURE, cached)) {
+        path = AssetCache::pathFor(name);
+        if (uploadFromAsset(cached)) {
+            AssetCache::recordHit();
+            std::cout << "Textura carregada do cache: " << path << " (" << memoryBytes / 1024.0
+                      << " KB, " << millisecondsSince(start) << " ms)" << std::endl;
+            return true;
+        }
+    }
+    if (useCache) {
+        AssetCache::recordMiss();
+    }
+
+    std::vector<std::vector<GLubyte>> levels(1);
+    levels[0].resize(static_cast<size_t>(width) * height * 4);
+    generateProceduralTexture(levels[0].data(), width, height, 0);
+    if (cpuMipmaps) {
+        buildMipChain(levels, width, height);
+    }
+    double generationMs = millisecondsSince(start);
+
+    createTextureObject(GL_TEXTURE_2D);
+
+    AssetWriter writer;
+    if (useCache) {
+        uint32_t params[8] = {(uint32_t)width, (uint32_t)height, 1, (uint32_t)format, cpuMipmaps ? 1u : 0u};
+        writer.begin(AssetCache::pathFor(name), ASSET_TEXTURE, params);
+    }
+
+    // Carregar dados da textura (todos os níveis quando gerados na CPU)
+    auto encodeStart = std::chrono::high_resolution_clock::now();
+    std::vector<GLubyte> blocks, decoded;
+    memoryBytes = 0;
+    int levelWidth = width, levelHeight = height;
+    for (size_t level = 0; level < levels.size(); ++level) {
+        const GLubyte* pixels = levels[level].data();
+        size_t pixelBytes = levels[level].size();
+        GLenum internalFormat = GL_RGBA8;
+        if (compressed) {
+            TextureCompression::encode(pixels, levelWidth, levelHeight, format, blocks);
+            if (compressedOnGPU) {
+                pixels = blocks.data();
+                pixelBytes = blocks.size();
+                internalFormat = TextureCompression::internalFormat(format);
+            } else {
+                // Caminho de software: mesma imagem (com artefatos BCn), sem compressão na GPU
+                TextureCompression::decode(blocks.data(), levelWidth, levelHeight, format, decoded);
+                pixels = decoded.data();
+                pixelBytes = decoded.size();
+            }
+        }
+
+        if (driverConverted) {
+            glTexImage2D(GL_TEXTURE_2D, level, TextureCompression::internalFormat(format), levelWidth, levelHeight,
+                         0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+            pixelBytes = TextureCompression::imageSize(levelWidth, levelHeight, format);
+        } else if (internalFormat == GL_RGBA8) {
+            glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA8, levelWidth, levelHeight, 0,
+                         GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+        } else {
+            glCompressedTexImage2D(GL_TEXTURE_2D, level, internalFormat, levelWidth, levelHeight, 0,
+                                   pixelBytes, pixels);
+        }
+        writer.addChunk(pixels, pixelBytes, levelWidth, levelHeight, level, 0, internalFormat);
+        memoryBytes += pixelBytes;
+
+        levelWidth = std::max(1, levelWidth / 2);
+        levelHeight = std::max(1, levelHeight / 2);
+    }
+    double encodeMs = millisecondsSince(encodeStart);
+    if (!cpuMipmaps) {
+        glGenerateMipmap(GL_TEXTURE_2D);
+        memoryBytes = mipChainBytes(width, height, format);
+    }
+    mipLevels = mipLevelCount(width, height);
+    writer.finish();
+
+    std::cout << "Textura procedural gerada: " << width << "x" << height
+              << " " << TextureCompression::formatName(format)
+              << (compressed && !compressedOnGPU ? " (decodificada para RGBA8: S3TC indisponível)" : "")
+              << ", " << mipLevels << " níveis de mipmap ("
+              << (cpuMipmaps ? "CPU" : "driver") << "), " << memoryBytes / 1024.0 << " KB"
+              << ", geração: " << generationMs << " ms";
+    if (compressed) {
+        std::cout << ", compressão: " << encodeMs << " ms";
+    }
+    std::cout << ", total: " << millisecondsSince(start) << " ms" << std::endl;
+    return true;
+}
+
+bool Texture::generateProceduralArray(int width, int height, int layers, bool cpuMipmaps) {
+    if (layers < 1 || !checkLimits(width, height, layers)) {
+        return false;
+    }
+    cleanup();
+
+    this->width = width;
+    this->height = height;
+    this->nrChannels = 4;
+    this->layers = layers;
+    this->format = TextureFormat::RGBA8;
+    compressedOnGPU = false;
+    mipLevels = mipLevelCount(width, height);
+    memoryBytes = mipChainBytes(width, height, format) * layers;
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    bool useCache = AssetCache::isEnabled();
+    std::string name = cacheName(width, height, layers, cpuMipmaps, format, false);
+    MappedAsset cached;
+    if (AssetCache::open(name, ASSET_TEXTURE, cached)) {
+        path = AssetCache::pathFor(name);
+        if (uploadFromAsset(cached)) {
+            AssetCache::recordHit();
+            std::cout << "Array de texturas carregado do cache: " << path << " (" << memoryBytes / 1024.0
+                      << " KB, " << millisecondsSince(start) << " ms)" << std::endl;
+            return true;
+        }
+    }
+    if (useCache) {
+        AssetCache::recordMiss();
+    }
+
+    createTextureObject(GL_TEXTURE_2D_ARRAY);
+
+    // Camadas são gravadas no cache à medida que são geradas
+    AssetWriter writer;
+    if (useCache) {
+        uint32_t params[8] = {(uint32_t)width, (uint32_t)height, (uint32_t)layers,
+                              (uint32_t)TextureFormat::RGBA8, cpuMipmaps ? 1u : 0u};
+        writer.begin(AssetCache::pathFor(name), ASSET_TEXTURE, params);
+    }
+
+    // Reservar todos os níveis antes de enviar as camadas
+    int levelWidth = width, levelHeight = height;
+    for (int level = 0; level < mipLevels; ++level) {
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, level, GL_RGBA8, levelWidth, levelHeight, layers, 0,
+                     GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        levelWidth = std::max(1, levelWidth / 2);
+        levelHeight = std::max(1, levelHeight / 2);
+    }
+
+    // Uma camada por vez para limitar o pico de memória com texturas grandes
+    double generationMs = 0.0;
+    for (int layer = 0; layer < layers; ++layer) {
+        auto layerStart = std::chrono::high_resolution_clock::now();
+        std::vector<std::vector<GLubyte>> levels(1);
+        levels[0].resize(static_cast<size_t>(width) * height * 4);
+        generateProceduralTexture(levels[0].data(), width, height, layer);
+        if (cpuMipmaps) {
+            buildMipChain(levels, width, height);
+        }
+        generationMs += millisecondsSince(layerStart);
+
+        levelWidth = width;
+        levelHeight = height;
+        for (size_t level = 0; level < levels.size(); ++level) {
+            glTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, 0, 0, layer, levelWidth, levelHeight, 1,
+                            GL_RGBA, GL_UNSIGNED_BYTE, levels[level].data());
+            writer.addChunk(levels[level].data(), levels[level].size(), levelWidth, levelHeight,
+                            level, layer, GL_RGBA8);
+            levelWidth = std::max(1, levelWidth / 2);
+            levelHeight = std::max(1, levelHeight / 2);
+        }
+    }
+    if (!cpuMipmaps) {
+        glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+    }
+    writer.finish();
+
+    std::cout << "Array de texturas procedurais gerado: " << width << "x" << height
+              << " x " << layers << " camadas RGBA8, " << mipLevels << " níveis de mipmap ("
+              << (cpuMipmaps ? "CPU" : "driver") << "), geração: " << generationMs
+              << " ms, total: " << millisecondsSince(start) << " ms" << std::endl;
     return true;
 }
 
-GLubyte* Texture::generateProceduralTexture(int width, int height) {
-    GLubyte* data = new GLubyte[width * height * 3];
-    
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            int index = (y * width + x) * 3;
-            
-            // Criar padrão de xadrez colorido
-            float u = (float)x / width;
+void Texture::generateProceduralTexture(GLubyte* data, int width, int height, int layer) {
+    const float pi = 3.14159f;
+    const float phase = 0.25f * layer;
+
+    // O padrão é separável: R depende só de u, G só de v, e
+    // B = sin((u + v) * pi) = sin(u*pi)cos(v*pi) + cos(u*pi)sin(v*pi).
+    // Com tabelas por coluna e por linha não há nenhuma chamada a sin por texel.
+    std::vector<float> sinU(width + 3), cosU(width + 3);
+    std::vector<uint32_t> columnRed(width + 3), columnEven(width + 3);
+    for (int x = 0; x < width; ++x) {
+        float u = (float)x / width;
+        sinU[x] = sin(u * pi);
+        cosU[x] = cos(u * pi);
+        columnRed[x] = (GLubyte)(255 * (0.5f + 0.5f * sin(u * pi)));
+        // Padrão de xadrez: máscara de colunas "pares"
+        columnEven[x] = ((int)(u * 8) % 2 == 0) ? 0xFFFFFFFFu : 0u;
+    }
+
+    parallelFor(0, height, [&](size_t rowBegin, size_t rowEnd) {
+        for (size_t y = rowBegin; y < rowEnd; ++y) {
             float v = (float)y / height;
-            
-            // Padrão de xadrez
-            int checkerX = (int)(u * 8) % 2;
-            int checkerY = (int)(v * 8) % 2;
-            bool isWhite = (checkerX + checkerY) % 2 == 0;
-            
-            if (isWhite) {
-                // Gradiente colorido
-                data[index] = (GLubyte)(255 * (0.5f + 0.5f * sin(u * 3.14159f)));     // R
-                data[index + 1] = (GLubyte)(255 * (0.5f + 0.5f * sin(v * 3.14159f))); // G
-                data[index + 2] = (GLubyte)(255 * (0.5f + 0.5f * sin((u + v) * 3.14159f))); // B
-            } else {
-                // Preto
-                data[index] = 0;
-                data[index + 1] = 0;
-                data[index + 2] = 0;
+            float sinV = sin((v + phase) * pi);
+            float cosV = cos((v + phase) * pi);
+            uint32_t green = (GLubyte)(255 * (0.5f + 0.5f * sin(v * pi)));
+            uint32_t rowBase = 0xFF000000u | (green << 8);
+            bool rowEven = (int)(v * 8) % 2 == 0;
+            uint32_t* row = reinterpret_cast<uint32_t*>(data + y * static_cast<size_t>(width) * 4);
+
+            int x = 0;
+#ifdef __SSE2__
+            const __m128 half = _mm_set1_ps(127.5f);
+            const __m128 vSin = _mm_set1_ps(sinV);
+            const __m128 vCos = _mm_set1_ps(cosV);
+            const __m128i vBase = _mm_set1_epi32(rowBase);
+            const __m128i alpha = _mm_set1_epi32(0xFF000000u);
+            const __m128i flip = _mm_set1_epi32(rowEven ? 0 : -1);
+            for (; x + 4 <= width; x += 4) {
+                // B = 127.5 + 127.5 * (sinU*cosV + cosU*sinV), truncado como no cast escalar
+                __m128 s = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&sinU[x]), vCos),
+                                      _mm_mul_ps(_mm_loadu_ps(&cosU[x]), vSin));
+                __m128i blue = _mm_cvttps_epi32(_mm_add_ps(half, _mm_mul_ps(half, s)));
+                __m128i red = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&columnRed[x]));
+                __m128i texel = _mm_or_si128(_mm_or_si128(red, vBase), _mm_slli_epi32(blue, 16));
+
+                // Quadrado branco quando a paridade da coluna e da linha coincidem
+                __m128i white = _mm_xor_si128(
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(&columnEven[x])), flip);
+                texel = _mm_or_si128(_mm_and_si128(texel, white), alpha);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(row + x), texel);
+            }
+#endif
+            for (; x < width; ++x) {
+                uint32_t blue = (GLubyte)(255 * (0.5f + 0.5f * (sinU[x] * cosV + cosU[x] * sinV)));
+                uint32_t white = rowEven ? columnEven[x] : ~columnEven[x];
+                row[x] = ((columnRed[x] | rowBase | (blue << 16)) & white) | 0xFF000000u;
             }
         }
+    }, 16);
+}
+
+void Texture::buildMipChain(std::vector<std::vector<GLubyte>>& levels, int width, int height) {
+    while (width > 1 || height > 1) {
+        int nextWidth = std::max(1, width / 2);
+        int nextHeight = std::max(1, height / 2);
+        const std::vector<GLubyte>& src = levels.back();
+        std::vector<GLubyte> dst(static_cast<size_t>(nextWidth) * nextHeight * 4);
+
+        parallelFor(0, nextHeight, [&](size_t rowBegin, size_t rowEnd) {
+            for (size_t y = rowBegin; y < rowEnd; ++y) {
+                size_t y0 = std::min<size_t>(2 * y, height - 1);
+                size_t y1 = std::min<size_t>(2 * y + 1, height - 1);
+                const GLubyte* row0 = &src[y0 * width * 4];
+                const GLubyte* row1 = &src[y1 * width * 4];
+                GLubyte* out = &dst[y * nextWidth * 4];
+
+                for (int x = 0; x < nextWidth; ++x) {
+                    int x0 = std::min(2 * x, width - 1) * 4;
+                    int x1 = std::min(2 * x + 1, width - 1) * 4;
+                    for (int c = 0; c < 4; ++c) {
+                        out[x * 4 + c] = (GLubyte)((row0[x0 + c] + row0[x1 + c] +
+                                                    row1[x0 + c] + row1[x1 + c] + 2) / 4);
+                    }
+                }
+            }
+        }, 16);
+
+        levels.push_back(std::move(dst));
+        width = nextWidth;
+        height = nextHeight;
     }
-    
-    return data;
 }
 
 void Texture::bind(GLenum textureUnit) {
-    glActiveTexture(textureUnit);
-    glBindTexture(GL_TEXTURE_2D, textureID);
+    GLStateCache::bindTextureUnit(textureUnit, target, textureID);
 }
 
 void Texture::cleanup() {
     if (textureID) {
-        glDeleteTextures(1, &textureID);
+        GLStateCache::deleteTextures(1, &textureID);
         textureID = 0;
     }
 }
@@ -3,28 +3,82 @@
 
 #include <GL/glew.h>
 #include <string>
+#include <vector>
+#include "TextureCompression.h"
+
+class MappedAsset;
 
 class Texture {
 private:
     GLuint textureID;
+    GLenum target;      // GL_TEXTURE_2D ou GL_TEXTURE_2D_ARRAY
     int width, height, nrChannels;
+    int layers;
+    int mipLevels;
+    TextureFormat format;
+    bool compressedOnGPU;   // false quando BCn foi decodificado para RGBA8 (sem S3TC no driver)
+    size_t memoryBytes;     // Memória ocupada na GPU por todos os níveis/camadas
     std::string path;
-    
-    // Gerar textura procedural
-    GLubyte* generateProceduralTexture(int width, int height);
+    // Amostragem; mantida quando a textura é regenerada
+    GLenum minFilter, magFilter;
+    float anisotropy;       // 1 = isotrópica
+
+    // Construir a cadeia de mipmaps na CPU (filtro de caixa 2x2, em paralelo)
+    static void buildMipChain(std::vector<std::vector<GLubyte>>& levels, int width, int height);
+
+    // Verificar limites do driver para o tamanho pedido
+    bool checkLimits(int width, int height, int layers);
+
+    // Criar o objeto de textura e configurar filtros/wrap
+    void createTextureObject(GLenum textureTarget);
+    // Aplicar minFilter/magFilter/anisotropy ao objeto ligado
+    void applySampling();
+
+    // Nome da entrada no cache de assets para os parâmetros do gerador
+    static std::string cacheName(int width, int height, int layers, bool cpuMipmaps,
+                                 TextureFormat format, bool compressedOnGPU);
+
+    // Enviar os níveis de um contêiner mapeado (ver AssetCache.h) direto ao driver
+    bool uploadFromAsset(const MappedAsset& asset);
 
 public:
     Texture();
     ~Texture();
-    
+
+    // Gerar textura procedural RGBA8 (linhas divididas entre threads, 4 texels por
+    // instrução SSE2). "layer" desloca o padrão para diferenciar camadas de um array.
+    // Não usa GL: o TextureStreamer chama de outra thread, direto num PBO mapeado.
+    static void generateProceduralTexture(GLubyte* data, int width, int height, int layer);
+
+    // Carregar um contêiner .glpa (gravado pelos geradores em cache/assets/)
     bool loadFromFile(const std::string& filePath);
-    bool generateProcedural(int width = 256, int height = 256);
+    // Formatos BC1/BC3 são codificados na CPU (com mipmaps da CPU) e enviados com
+    // glCompressedTexImage2D; sem GL_EXT_texture_compression_s3tc o resultado
+    // decodificado é enviado como RGBA8, preservando a aparência comprimida.
+    bool generateProcedural(int width = 256, int height = 256, bool cpuMipmaps = false,
+                            TextureFormat format = TextureFormat::RGBA8);
+    bool generateProceduralArray(int width, int height, int layers, bool cpuMipmaps = false);
     void bind(GLenum textureUnit = GL_TEXTURE0);
     void cleanup();
-    
+
+    // Filtros de minificação/magnificação e anisotropia (limitada ao máximo do
+    // driver; sem GL_EXT_texture_filter_anisotropic fica em 1)
+    void setSampling(GLenum minFilter, GLenum magFilter, float anisotropy = 1.0f);
+    GLenum getMinFilter() const { return minFilter; }
+    GLenum getMagFilter() const { return magFilter; }
+    float getAnisotropy() const { return anisotropy; }
+    static float getMaxAnisotropy();
+    static const char* filterName(GLenum filter);
+
     GLuint getID() const { return textureID; }
+    GLenum getTarget() const { return target; }
     int getWidth() const { return width; }
     int getHeight() const { return height; }
+    int getLayers() const { return layers; }
+    int getMipLevels() const { return mipLevels; }
+    TextureFormat getFormat() const { return format; }
+    bool isCompressedOnGPU() const { return compressedOnGPU; }
+    size_t getMemoryBytes() const { return memoryBytes; }
 };
 
 #endif
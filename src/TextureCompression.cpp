@@ -0,0 +1,306 @@
+#include "TextureCompression.h"
+#include "ParallelFor.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+namespace {
+
+uint16_t packRGB565(int r, int g, int b) {
+    return (uint16_t)(((r * 31 + 127) / 255) << 11 | ((g * 63 + 127) / 255) << 5 | ((b * 31 + 127) / 255));
+}
+
+void unpackRGB565(uint16_t c, int rgb[3]) {
+    int r = (c >> 11) & 31, g = (c >> 5) & 63, b = c & 31;
+    rgb[0] = (r << 3) | (r >> 2);
+    rgb[1] = (g << 2) | (g >> 4);
+    rgb[2] = (b << 3) | (b >> 2);
+}
+
+int colorDistance(const GLubyte* a, const int* b) {
+    int dr = a[0] - b[0], dg = a[1] - b[1], db = a[2] - b[2];
+    return dr * dr + dg * dg + db * db;
+}
+
+// Ler um bloco 4x4, repetindo a última linha/coluna nas bordas
+void fetchBlock(const GLubyte* rgba, int width, int height, int bx, int by, GLubyte block[16][4]) {
+    for (int y = 0; y < 4; ++y) {
+        int sy = std::min(by * 4 + y, height - 1);
+        for (int x = 0; x < 4; ++x) {
+            int sx = std::min(bx * 4 + x, width - 1);
+            const GLubyte* p = rgba + (static_cast<size_t>(sy) * width + sx) * 4;
+            for (int c = 0; c < 4; ++c) {
+                block[y * 4 + x][c] = p[c];
+            }
+        }
+    }
+}
+
+void storeBlock(GLubyte* rgba, int width, int height, int bx, int by, const GLubyte block[16][4]) {
+    for (int y = 0; y < 4; ++y) {
+        int dy = by * 4 + y;
+        if (dy >= height) break;
+        for (int x = 0; x < 4; ++x) {
+            int dx = bx * 4 + x;
+            if (dx >= width) break;
+            GLubyte* p = rgba + (static_cast<size_t>(dy) * width + dx) * 4;
+            for (int c = 0; c < 4; ++c) {
+                p[c] = block[y * 4 + x][c];
+            }
+        }
+    }
+}
+
+int blockBytes(TextureFormat format) {
+    return format == TextureFormat::BC1 ? 8 : 16;
+}
+
+}
+
+size_t TextureCompression::imageSize(int width, int height, TextureFormat format) {
+    switch (format) {
+        case TextureFormat::RGBA8:   return static_cast<size_t>(width) * height * 4;
+        case TextureFormat::RGB8:    return static_cast<size_t>(width) * height * 3;
+        case TextureFormat::RGBA16F: return static_cast<size_t>(width) * height * 8;
+        default: break;
+    }
+    size_t blocksX = (width + 3) / 4;
+    size_t blocksY = (height + 3) / 4;
+    return blocksX * blocksY * blockBytes(format);
+}
+
+bool TextureCompression::isHardwareSupported() {
+    return GLEW_EXT_texture_compression_s3tc;
+}
+
+bool TextureCompression::isCompressed(TextureFormat format) {
+    return format == TextureFormat::BC1 || format == TextureFormat::BC3;
+}
+
+GLenum TextureCompression::internalFormat(TextureFormat format) {
+    switch (format) {
+        case TextureFormat::BC1: return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+        case TextureFormat::BC3: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        case TextureFormat::RGB8: return GL_RGB8;
+        case TextureFormat::RGBA16F: return GL_RGBA16F;
+        default: return GL_RGBA8;
+    }
+}
+
+const char* TextureCompression::formatName(TextureFormat format) {
+    switch (format) {
+        case TextureFormat::BC1: return "BC1";
+        case TextureFormat::BC3: return "BC3";
+        case TextureFormat::RGB8: return "RGB8";
+        case TextureFormat::RGBA16F: return "RGBA16F";
+        default: return "RGBA8";
+    }
+}
+
+void TextureCompression::encodeColorBlock(const GLubyte block[16][4], GLubyte* out) {
+    // Extremos pela caixa envolvente, recuados 1/16 para reduzir o erro médio
+    int minColor[3] = {255, 255, 255}, maxColor[3] = {0, 0, 0};
+    for (int i = 0; i < 16; ++i) {
+        for (int c = 0; c < 3; ++c) {
+            minColor[c] = std::min<int>(minColor[c], block[i][c]);
+            maxColor[c] = std::max<int>(maxColor[c], block[i][c]);
+        }
+    }
+    for (int c = 0; c < 3; ++c) {
+        int inset = (maxColor[c] - minColor[c]) >> 4;
+        minColor[c] = std::min(255, minColor[c] + inset);
+        maxColor[c] = std::max(0, maxColor[c] - inset);
+    }
+
+    uint16_t color0 = packRGB565(maxColor[0], maxColor[1], maxColor[2]);
+    uint16_t color1 = packRGB565(minColor[0], minColor[1], minColor[2]);
+    uint32_t indices = 0;
+
+    // color0 >= color1 componente a componente; se iguais, bloco de cor única
+    if (color0 != color1) {
+        int palette[4][3];
+        unpackRGB565(color0, palette[0]);
+        unpackRGB565(color1, palette[1]);
+        for (int c = 0; c < 3; ++c) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+
+        for (int i = 0; i < 16; ++i) {
+            int best = 0;
+            int bestDistance = colorDistance(block[i], palette[0]);
+            for (int p = 1; p < 4; ++p) {
+                int distance = colorDistance(block[i], palette[p]);
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    best = p;
+                }
+            }
+            indices |= (uint32_t)best << (2 * i);
+        }
+    }
+
+    out[0] = color0 & 0xFF;
+    out[1] = color0 >> 8;
+    out[2] = color1 & 0xFF;
+    out[3] = color1 >> 8;
+    out[4] = indices & 0xFF;
+    out[5] = (indices >> 8) & 0xFF;
+    out[6] = (indices >> 16) & 0xFF;
+    out[7] = (indices >> 24) & 0xFF;
+}
+
+void TextureCompression::encodeAlphaBlock(const GLubyte block[16][4], GLubyte* out) {
+    int minAlpha = 255, maxAlpha = 0;
+    for (int i = 0; i < 16; ++i) {
+        minAlpha = std::min<int>(minAlpha, block[i][3]);
+        maxAlpha = std::max<int>(maxAlpha, block[i][3]);
+    }
+
+    uint64_t indices = 0;
+    if (maxAlpha != minAlpha) {
+        // Modo de 8 níveis (alpha0 > alpha1)
+        int palette[8];
+        palette[0] = maxAlpha;
+        palette[1] = minAlpha;
+        for (int p = 1; p < 7; ++p) {
+            palette[p + 1] = ((7 - p) * maxAlpha + p * minAlpha) / 7;
+        }
+        for (int i = 0; i < 16; ++i) {
+            int best = 0;
+            int bestDistance = 256;
+            for (int p = 0; p < 8; ++p) {
+                int distance = std::abs(block[i][3] - palette[p]);
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    best = p;
+                }
+            }
+            indices |= (uint64_t)best << (3 * i);
+        }
+    }
+
+    out[0] = (GLubyte)maxAlpha;
+    out[1] = (GLubyte)minAlpha;
+    for (int b = 0; b < 6; ++b) {
+        out[2 + b] = (indices >> (8 * b)) & 0xFF;
+    }
+}
+
+void TextureCompression::decodeColorBlock(const GLubyte* in, GLubyte block[16][4], bool forceFourColors) {
+    uint16_t color0 = in[0] | (in[1] << 8);
+    uint16_t color1 = in[2] | (in[3] << 8);
+    uint32_t indices = in[4] | (in[5] << 8) | (in[6] << 16) | ((uint32_t)in[7] << 24);
+
+    int palette[4][4];
+    unpackRGB565(color0, palette[0]);
+    unpackRGB565(color1, palette[1]);
+    palette[0][3] = palette[1][3] = 255;
+
+    if (color0 > color1 || forceFourColors) {
+        for (int c = 0; c < 3; ++c) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+        palette[2][3] = palette[3][3] = 255;
+    } else {
+        // Modo de 3 cores + preto transparente (não gerado pelo codificador)
+        for (int c = 0; c < 3; ++c) {
+            palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+            palette[3][c] = 0;
+        }
+        palette[2][3] = 255;
+        palette[3][3] = 0;
+    }
+
+    for (int i = 0; i < 16; ++i) {
+        int index = (indices >> (2 * i)) & 3;
+        for (int c = 0; c < 4; ++c) {
+            block[i][c] = (GLubyte)palette[index][c];
+        }
+    }
+}
+
+void TextureCompression::decodeAlphaBlock(const GLubyte* in, GLubyte block[16][4]) {
+    int alpha0 = in[0], alpha1 = in[1];
+    uint64_t indices = 0;
+    for (int b = 0; b < 6; ++b) {
+        indices |= (uint64_t)in[2 + b] << (8 * b);
+    }
+
+    int palette[8];
+    palette[0] = alpha0;
+    palette[1] = alpha1;
+    if (alpha0 > alpha1) {
+        for (int p = 1; p < 7; ++p) {
+            palette[p + 1] = ((7 - p) * alpha0 + p * alpha1) / 7;
+        }
+    } else {
+        for (int p = 1; p < 5; ++p) {
+            palette[p + 1] = ((5 - p) * alpha0 + p * alpha1) / 5;
+        }
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+
+    for (int i = 0; i < 16; ++i) {
+        block[i][3] = (GLubyte)palette[(indices >> (3 * i)) & 7];
+    }
+}
+
+void TextureCompression::encode(const GLubyte* rgba, int width, int height, TextureFormat format,
+                                std::vector<GLubyte>& out) {
+    out.resize(imageSize(width, height, format));
+    if (format == TextureFormat::RGBA8) {
+        std::copy(rgba, rgba + out.size(), out.begin());
+        return;
+    }
+
+    int blocksX = (width + 3) / 4;
+    int blocksY = (height + 3) / 4;
+    int bytesPerBlock = blockBytes(format);
+
+    parallelFor(0, blocksY, [&](size_t rowBegin, size_t rowEnd) {
+        GLubyte block[16][4];
+        for (size_t by = rowBegin; by < rowEnd; ++by) {
+            for (int bx = 0; bx < blocksX; ++bx) {
+                GLubyte* dst = &out[(by * blocksX + bx) * bytesPerBlock];
+                fetchBlock(rgba, width, height, bx, by, block);
+                if (format == TextureFormat::BC3) {
+                    encodeAlphaBlock(block, dst);
+                    dst += 8;
+                }
+                encodeColorBlock(block, dst);
+            }
+        }
+    }, 4);
+}
+
+void TextureCompression::decode(const GLubyte* blocks, int width, int height, TextureFormat format,
+                                std::vector<GLubyte>& rgba) {
+    rgba.resize(static_cast<size_t>(width) * height * 4);
+    if (format == TextureFormat::RGBA8) {
+        std::copy(blocks, blocks + rgba.size(), rgba.begin());
+        return;
+    }
+
+    int blocksX = (width + 3) / 4;
+    int blocksY = (height + 3) / 4;
+    int bytesPerBlock = blockBytes(format);
+
+    parallelFor(0, blocksY, [&](size_t rowBegin, size_t rowEnd) {
+        GLubyte block[16][4];
+        for (size_t by = rowBegin; by < rowEnd; ++by) {
+            for (int bx = 0; bx < blocksX; ++bx) {
+                const GLubyte* src = &blocks[(by * blocksX + bx) * bytesPerBlock];
+                if (format == TextureFormat::BC3) {
+                    decodeColorBlock(src + 8, block, true);
+                    decodeAlphaBlock(src, block);
+                } else {
+                    decodeColorBlock(src, block, false);
+                }
+                storeBlock(rgba.data(), width, height, bx, by, block);
+            }
+        }
+    }, 4);
+}
@@ -0,0 +1,49 @@
+#ifndef TEXTURECOMPRESSION_H
+#define TEXTURECOMPRESSION_H
+
+#include <GL/glew.h>
+#include <cstddef>
+#include <vector>
+
+// Formatos de armazenamento de textura suportados
+enum class TextureFormat {
+    RGBA8,   // Sem compressão, 4 bytes por texel
+    BC1,     // S3TC DXT1: 8 bytes por bloco 4x4 (0,5 byte por texel), sem alfa
+    BC3,     // S3TC DXT5: 16 bytes por bloco 4x4 (1 byte por texel), alfa interpolado
+    // Sem compressão, convertidos pelo driver a partir de RGBA8 no upload
+    RGB8,    // 3 bytes por texel (o driver pode guardar com 4)
+    RGBA16F  // Meia precisão, 8 bytes por texel
+};
+
+// Codificador/decodificador BC1/BC3 na CPU. Cada bloco 4x4 é independente,
+// então as linhas de blocos são divididas entre as threads disponíveis.
+class TextureCompression {
+private:
+    static void encodeColorBlock(const GLubyte block[16][4], GLubyte* out);
+    static void encodeAlphaBlock(const GLubyte block[16][4], GLubyte* out);
+    static void decodeColorBlock(const GLubyte* in, GLubyte block[16][4], bool forceFourColors);
+    static void decodeAlphaBlock(const GLubyte* in, GLubyte block[16][4]);
+
+public:
+    // Tamanho em bytes de uma imagem width x height no formato pedido
+    static size_t imageSize(int width, int height, TextureFormat format);
+
+    // Comprimir uma imagem RGBA8 (linhas contíguas de width * 4 bytes)
+    static void encode(const GLubyte* rgba, int width, int height, TextureFormat format,
+                       std::vector<GLubyte>& out);
+
+    // Reconstruir RGBA8 a partir dos blocos (caminho de software / validação)
+    static void decode(const GLubyte* blocks, int width, int height, TextureFormat format,
+                       std::vector<GLubyte>& rgba);
+
+    // GL_EXT_texture_compression_s3tc disponível no driver
+    static bool isHardwareSupported();
+
+    // BC1/BC3 (codificados na CPU, sem glGenerateMipmap)
+    static bool isCompressed(TextureFormat format);
+
+    static GLenum internalFormat(TextureFormat format);
+    static const char* formatName(TextureFormat format);
+};
+
+#endif
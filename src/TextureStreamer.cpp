@@ -0,0 +1,252 @@
+#include "TextureStreamer.h"
+#include "Texture.h"
+#include "GLStateCache.h"
+#include "GLProfiler.h"
+#include <iostream>
+#include <algorithm>
+#include <cstdlib>
+
+TextureStreamer::TextureStreamer(int size, int texturesPerFrame)
+    : size(size > 0 ? size : DEFAULT_SIZE), texturesPerFrame(std::max(1, texturesPerFrame)), textureBytes(0),
+      currentSlot(-1), currentSequence(0), nextSequence(1), running(false),
+      windowFrames(0), windowTextures(0), windowLatencyMs(0.0), windowRenderMs(0.0),
+      texturesPerSecond(0.0), uploadMBps(0.0), latencyMs(0.0), renderThreadMs(0.0),
+      totalTextures(0), totalBytes(0), backlogFrames(0), generateMs(0.0) {
+    for (Slot& slot : slots) {
+        slot.pbo = 0;
+        slot.texture = 0;
+        slot.fence = nullptr;
+        slot.mapped = nullptr;
+        slot.sequence = 0;
+        slot.state = SlotState::Free;
+    }
+}
+
+TextureStreamer::~TextureStreamer() {
+    cleanup();
+}
+
+int TextureStreamer::requestedRate() {
+    const char* env = std::getenv("GLPERF_TEXTURE_STREAM");
+    return env ? std::max(0, std::atoi(env)) : 0;
+}
+
+bool TextureStreamer::initialize() {
+    GLint maxSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+    if (size > maxSize) {
+        std::cerr << "Streaming de texturas: " << size << "x" << size << " acima do máximo do driver ("
+                  << maxSize << ")" << std::endl;
+        return false;
+    }
+    textureBytes = static_cast<size_t>(size) * size * 4;
+
+    for (Slot& slot : slots) {
+        glGenBuffers(1, &slot.pbo);
+        GLStateCache::bindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.pbo);
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, textureBytes, nullptr, GL_STREAM_DRAW);
+
+        // Só o nível 0: glGenerateMipmap a cada textura custaria mais que o próprio upload
+        glGenTextures(1, &slot.texture);
+        GLStateCache::bindTexture(GL_TEXTURE_2D, slot.texture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, size, size, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    }
+    // Com um PBO ligado, os uploads das outras texturas leriam dele
+    GLStateCache::bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    if (glGetError() != GL_NO_ERROR) {
+        std::cerr << "Erro ao criar PBOs/texturas de streaming" << std::endl;
+        return false;
+    }
+
+    windowStart = std::chrono::steady_clock::now();
+    running = true;
+    worker = std::thread(&TextureStreamer::run, this);
+
+    std::cout << "Streaming de texturas: " << size << "x" << size << " RGBA8, " << texturesPerFrame
+              << " por frame, " << SLOT_COUNT << " PBOs de " << textureBytes / 1024.0 << " KB" << std::endl;
+    return true;
+}
+
+void TextureStreamer::cleanup() {
+    // A thread de fundo pode estar escrevendo num mapeamento: parar antes de desmapear
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        running = false;
+    }
+    jobReady.notify_all();
+    if (worker.joinable()) {
+        worker.join();
+    }
+    jobs.clear();
+
+    if (totalTextures > 0) {
+        std::cout << "Streaming de texturas: " << totalTextures << " texturas, "
+                  << totalBytes / (1024.0 * 1024.0) << " MB enviados, " << backlogFrames
+                  << " frames sem slot livre" << std::endl;
+        totalTextures = 0;
+    }
+
+    for (Slot& slot : slots) {
+        if (slot.mapped) {
+            GLStateCache::bindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.pbo);
+            glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            slot.mapped = nullptr;
+        }
+        if (slot.fence) {
+            glDeleteSync(slot.fence);
+            slot.fence = nullptr;
+        }
+        if (slot.pbo) {
+            GLStateCache::deleteBuffers(1, &slot.pbo);
+            slot.pbo = 0;
+        }
+        if (slot.texture) {
+            GLStateCache::deleteTextures(1, &slot.texture);
+            slot.texture = 0;
+        }
+        slot.state = SlotState::Free;
+    }
+    GLStateCache::bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    currentSlot = -1;
+}
+
+void TextureStreamer::run() {
+    while (true) {
+        int index;
+        {
+            std::unique_lock<std::mutex> lock(jobMutex);
+            jobReady.wait(lock, [this] { return !jobs.empty() || !running.load(); });
+            if (!running.load()) {
+                return;
+            }
+            index = jobs.front();
+            jobs.pop_front();
+        }
+
+        // Texels escritos direto no PBO mapeado; o padrão se repete a cada 8 texturas
+        Slot& slot = slots[index];
+        auto begin = std::chrono::steady_clock::now();
+        Texture::generateProceduralTexture(static_cast<GLubyte*>(slot.mapped), size, size, slot.sequence % 8);
+        generateMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        slot.state.store(SlotState::Ready, std::memory_order_release);
+    }
+}
+
+void TextureStreamer::update() {
+    auto begin = std::chrono::steady_clock::now();
+
+    retireUploads(begin);
+    uploadReadySlots();
+    requestTextures(begin);
+    GLStateCache::bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    auto end = std::chrono::steady_clock::now();
+    windowRenderMs += std::chrono::duration<double, std::milli>(end - begin).count();
+    windowFrames++;
+
+    double windowSeconds = std::chrono::duration<double>(end - windowStart).count();
+    if (windowSeconds >= 1.0) {
+        texturesPerSecond = windowTextures / windowSeconds;
+        uploadMBps = windowTextures * textureBytes / (1024.0 * 1024.0) / windowSeconds;
+        latencyMs = windowTextures > 0 ? windowLatencyMs / windowTextures : 0.0;
+        renderThreadMs = windowRenderMs / windowFrames;
+        windowFrames = 0;
+        windowTextures = 0;
+        windowLatencyMs = 0.0;
+        windowRenderMs = 0.0;
+        windowStart = end;
+    }
+}
+
+void TextureStreamer::retireUploads(std::chrono::steady_clock::time_point now) {
+    for (int i = 0; i < SLOT_COUNT; ++i) {
+        Slot& slot = slots[i];
+        if (slot.state.load(std::memory_order_relaxed) != SlotState::Uploading) {
+            continue;
+        }
+        // Timeout 0: só consulta (o flush garante que a fence chegue à GPU)
+        GLenum result = glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+        if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED) {
+            continue;
+        }
+        glDeleteSync(slot.fence);
+        slot.fence = nullptr;
+        slot.state.store(SlotState::Free, std::memory_order_relaxed);
+
+        if (slot.sequence > currentSequence) {
+            currentSlot = i;
+            currentSequence = slot.sequence;
+        }
+        windowTextures++;
+        windowLatencyMs += std::chrono::duration<double, std::milli>(now - slot.requested).count();
+        totalTextures++;
+        totalBytes += textureBytes;
+    }
+}
+
+void TextureStreamer::uploadReadySlots() {
+    for (int uploaded = 0; uploaded < texturesPerFrame; ++uploaded) {
+        // Mais antigo primeiro, para as texturas aparecerem na ordem em que foram pedidas
+        int oldest = -1;
+        for (int i = 0; i < SLOT_COUNT; ++i) {
+            if (slots[i].state.load(std::memory_order_acquire) == SlotState::Ready &&
+                (oldest < 0 || slots[i].sequence < slots[oldest].sequence)) {
+                oldest = i;
+            }
+        }
+        if (oldest < 0) {
+            return;
+        }
+
+        Slot& slot = slots[oldest];
+        GLStateCache::bindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.pbo);
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        slot.mapped = nullptr;
+
+        // Com o PBO ligado o último argumento é um deslocamento no buffer: a
+        // chamada só enfileira a cópia e retorna
+        GLStateCache::bindTexture(GL_TEXTURE_2D, slot.texture);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, size, size, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        slot.state.store(SlotState::Uploading, std::memory_order_relaxed);
+    }
+}
+
+void TextureStreamer::requestTextures(std::chrono::steady_clock::time_point now) {
+    int requested = 0;
+    for (int i = 0; i < SLOT_COUNT && requested < texturesPerFrame; ++i) {
+        // A textura amostrada agora não é sobrescrita; as demais já saíram de uso
+        // há pelo menos um frame
+        Slot& slot = slots[i];
+        if (i == currentSlot || slot.state.load(std::memory_order_relaxed) != SlotState::Free) {
+            continue;
+        }
+
+        // A fence deste PBO já sinalizou: o mapeamento sem sincronização não espera a GPU
+        GLStateCache::bindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.pbo);
+        slot.mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, textureBytes,
+                                       GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+        if (!slot.mapped) {
+            std::cerr << "Streaming de texturas: glMapBufferRange falhou" << std::endl;
+            return;
+        }
+        slot.sequence = nextSequence++;
+        slot.requested = now;
+        slot.state.store(SlotState::Generating, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(jobMutex);
+            jobs.push_back(i);
+        }
+        jobReady.notify_one();
+        requested++;
+    }
+    if (requested < texturesPerFrame) {
+        backlogFrames++;
+    }
+}
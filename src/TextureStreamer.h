@@ -0,0 +1,108 @@
+#ifndef TEXTURESTREAMER_H
+#define TEXTURESTREAMER_H
+
+#include <GL/glew.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+// Streaming de texturas por PBOs (GL_PIXEL_UNPACK_BUFFER). Cada slot tem um PBO
+// e a textura de destino dele. A thread de render mapeia o PBO de um slot livre
+// e entrega o ponteiro à thread de fundo, que gera os texels direto no
+// mapeamento. Quando o slot fica pronto, a thread de render desmapeia, chama
+// glTexSubImage2D a partir do PBO (a cópia fica com o driver/DMA) e insere uma
+// fence. A fence é consultada com timeout 0 nos frames seguintes: só então a
+// textura passa a ser amostrada e o PBO volta a ser mapeado. A thread de render
+// nunca espera a geração nem a GPU. Sem slot livre, o pedido do frame é perdido
+// (contado em getBacklogFrames). Ativar com GLPERF_TEXTURE_STREAM=N (texturas
+// novas por frame).
+class TextureStreamer {
+public:
+    static const int SLOT_COUNT = 4;
+    static const int DEFAULT_SIZE = 1024;
+
+private:
+    enum class SlotState { Free, Generating, Ready, Uploading };
+
+    struct Slot {
+        GLuint pbo;
+        GLuint texture;
+        GLsync fence;
+        void* mapped;           // Ponteiro do glMapBufferRange enquanto a thread de fundo escreve
+        uint64_t sequence;      // Número da textura (o padrão muda a cada uma)
+        std::chrono::steady_clock::time_point requested;
+        std::atomic<SlotState> state;
+    };
+
+    Slot slots[SLOT_COUNT];
+    int size;
+    int texturesPerFrame;
+    size_t textureBytes;
+    int currentSlot;            // Última textura com upload concluído (-1 = nenhuma ainda)
+    uint64_t currentSequence;
+    uint64_t nextSequence;
+
+    std::thread worker;
+    std::atomic<bool> running;
+    std::mutex jobMutex;
+    std::condition_variable jobReady;
+    std::deque<int> jobs;       // Slots mapeados esperando a geração
+
+    // Janela de medição de um segundo (thread de render)
+    std::chrono::steady_clock::time_point windowStart;
+    int windowFrames;
+    uint64_t windowTextures;
+    double windowLatencyMs;
+    double windowRenderMs;
+    double texturesPerSecond;
+    double uploadMBps;
+    double latencyMs;
+    double renderThreadMs;
+    uint64_t totalTextures;
+    uint64_t totalBytes;
+    uint64_t backlogFrames;
+    std::atomic<double> generateMs;   // Escrito pela thread de fundo
+
+    void run();
+    // Etapas de update(): fences sinalizadas, uploads dos slots prontos e novos pedidos
+    void retireUploads(std::chrono::steady_clock::time_point now);
+    void uploadReadySlots();
+    void requestTextures(std::chrono::steady_clock::time_point now);
+
+public:
+    explicit TextureStreamer(int size = DEFAULT_SIZE, int texturesPerFrame = 1);
+    ~TextureStreamer();
+
+    // Criar PBOs e texturas e iniciar a thread de geração
+    bool initialize();
+    void cleanup();
+
+    // Uma vez por frame, na thread de render, antes de amostrar a textura
+    void update();
+
+    // Textura mais recente já enviada (0 até o primeiro upload concluir)
+    GLuint getCurrentTexture() const { return currentSlot >= 0 ? slots[currentSlot].texture : 0; }
+
+    int getSize() const { return size; }
+    int getTexturesPerFrame() const { return texturesPerFrame; }
+    // Medições do último segundo
+    double getTexturesPerSecond() const { return texturesPerSecond; }
+    double getUploadMBps() const { return uploadMBps; }
+    // Do mapeamento do PBO até a fence do upload sinalizar
+    double getLatencyMs() const { return latencyMs; }
+    // Tempo de CPU de update() por frame (mapear, desmapear, glTexSubImage2D, fences)
+    double getRenderThreadMs() const { return renderThreadMs; }
+    // Geração de uma textura na thread de fundo
+    double getGenerateMs() const { return generateMs.load(); }
+    uint64_t getTotalTextures() const { return totalTextures; }
+    uint64_t getBacklogFrames() const { return backlogFrames; }
+
+    // GLPERF_TEXTURE_STREAM=N: texturas novas por frame (0 = desligado)
+    static int requestedRate();
+};
+
+#endif
@@ -0,0 +1,243 @@
+#include "TriangleAnimation.h"
+#include "GLStateCache.h"
+#include "GLProfiler.h"
+#include <iostream>
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+
+TriangleAnimation::TriangleAnimation() : sliceTriangles(0), sliceLimit(0), maxTextureBufferTexels(0),
+                                         maxStorageBlockBytes(0), computeProgram(0), triangleCount(0),
+                                         computeAllocated(false), animationTime(0.0f) {
+}
+
+TriangleAnimation::~TriangleAnimation() {
+    cleanup();
+}
+
+AnimationPath TriangleAnimation::requestedPath() {
+    const char* env = std::getenv("GLPERF_ANIMATION");
+    std::string value = env ? env : "";
+    if (value == "vertex") return AnimationPath::VertexShader;
+    if (value == "compute") return AnimationPath::Compute;
+    return AnimationPath::CPU;
+}
+
+const char* TriangleAnimation::pathName(AnimationPath path) {
+    switch (path) {
+        case AnimationPath::CPU:          return "cpu";
+        case AnimationPath::VertexShader: return "vertex";
+        case AnimationPath::Compute:      return "compute";
+    }
+    return "?";
+}
+
+bool TriangleAnimation::isComputeSupported() {
+    return GLEW_VERSION_4_3;
+}
+
+bool TriangleAnimation::initialize(size_t maxSliceTriangles) {
+    sliceLimit = maxSliceTriangles;
+
+    // A especificação só garante 64K texels de buffer texture e 16 MB por bloco
+    // SSBO (que pode nem existir no vertex shader): as fatias seguem o driver
+    glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &maxTextureBufferTexels);
+
+    // O compute shader só é compilado onde há GL 4.3; o caminho por vertex shader funciona no 3.3
+    if (isComputeSupported()) {
+        GLint vertexBlocks = 0;
+        glGetIntegerv(GL_MAX_VERTEX_SHADER_STORAGE_BLOCKS, &vertexBlocks);
+        if (vertexBlocks > 0) {
+            glGetIntegerv(GL_MAX_SHADER_STORAGE_BLOCK_SIZE, &maxStorageBlockBytes);
+        }
+        if (!createComputeProgram()) {
+            std::cerr << "Animação por compute shader indisponível" << std::endl;
+        }
+    }
+
+    std::cout << "Animação na GPU inicializada (compute shader: " << (computeProgram ? "sim" : "não")
+              << ", fatias de " << sliceSizeFor(AnimationPath::VertexShader) << "/"
+              << sliceSizeFor(AnimationPath::Compute) << " triângulos)" << std::endl;
+    return true;
+}
+
+size_t TriangleAnimation::sliceSizeFor(AnimationPath path) const {
+    size_t limit = std::min(sliceLimit, (size_t)std::max(maxTextureBufferTexels, 0));
+    if (path == AnimationPath::Compute) {
+        if (!computeProgram) {
+            return 0;
+        }
+        limit = std::min(limit, (size_t)std::max(maxStorageBlockBytes, 0) / sizeof(glm::mat4));
+    }
+
+    // Potência de dois: as fatias dividem o bloco de geometria sem atravessá-lo
+    size_t size = sliceLimit;
+    while (size > limit) {
+        size /= 2;
+    }
+    return size >= (size_t)WORK_GROUP_SIZE ? size : 0;
+}
+
+bool TriangleAnimation::createComputeProgram() {
+    GLuint shader = glCreateShader(GL_COMPUTE_SHADER);
+    glShaderSource(shader, 1, &computeShaderSource, nullptr);
+    glCompileShader(shader);
+
+    GLint success;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (!success) {
+        GLchar infoLog[512];
+        glGetShaderInfoLog(shader, 512, nullptr, infoLog);
+        std::cerr << "Erro ao compilar compute shader: " << infoLog << std::endl;
+        glDeleteShader(shader);
+        return false;
+    }
+
+    computeProgram = glCreateProgram();
+    glAttachShader(computeProgram, shader);
+    glLinkProgram(computeProgram);
+    glDeleteShader(shader);
+
+    glGetProgramiv(computeProgram, GL_LINK_STATUS, &success);
+    if (!success) {
+        GLchar infoLog[512];
+        glGetProgramInfoLog(computeProgram, 512, nullptr, infoLog);
+        std::cerr << "Erro ao linkar compute shader: " << infoLog << std::endl;
+        GLStateCache::deleteProgram(computeProgram);
+        computeProgram = 0;
+        return false;
+    }
+    return true;
+}
+
+bool TriangleAnimation::allocate(size_t count, bool withCompute) {
+    bool compute = withCompute && computeProgram;
+    size_t size = sliceSizeFor(compute ? AnimationPath::Compute : AnimationPath::VertexShader);
+    if (size == 0) {
+        return false;
+    }
+
+    // Outro tamanho de fatia (troca de caminho): as existentes não servem mais
+    if (size != sliceTriangles) {
+        for (Slice& slice : slices) {
+            releaseSlice(slice);
+        }
+        slices.clear();
+        sliceTriangles = size;
+    }
+
+    size_t needed = (count + size - 1) / size;
+    while (slices.size() > needed) {
+        releaseSlice(slices.back());
+        slices.pop_back();
+    }
+    while (slices.size() < needed) {
+        Slice slice = {};
+        glGenBuffers(1, &slice.stateBuffer);
+        glGenTextures(1, &slice.stateTexture);
+        slices.push_back(slice);
+    }
+    for (size_t i = 0; i < slices.size(); ++i) {
+        slices[i].triangleCount = std::min(size, count - i * size);
+    }
+
+    triangleCount = count;
+    computeAllocated = compute;
+    animationTime = 0.0f;
+    return true;
+}
+
+void TriangleAnimation::uploadSlice(size_t index, const glm::vec4* states, const float* rotations) {
+    Slice& slice = slices[index];
+    GLStateCache::bindBuffer(GL_TEXTURE_BUFFER, slice.stateBuffer);
+    glBufferData(GL_TEXTURE_BUFFER, slice.triangleCount * sizeof(glm::vec4), states, GL_STATIC_DRAW);
+    GLStateCache::bindBuffer(GL_TEXTURE_BUFFER, 0);
+    GLStateCache::bindTexture(GL_TEXTURE_BUFFER, slice.stateTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, slice.stateBuffer);
+    GLStateCache::bindTexture(GL_TEXTURE_BUFFER, 0);
+
+    // Ângulos e matrizes só existem enquanto o caminho Compute está em uso (68 bytes por triângulo)
+    if (computeAllocated) {
+        if (!slice.rotationBuffer) {
+            glGenBuffers(1, &slice.rotationBuffer);
+            glGenBuffers(1, &slice.transformBuffer);
+        }
+        GLStateCache::bindBuffer(GL_SHADER_STORAGE_BUFFER, slice.rotationBuffer);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, slice.triangleCount * sizeof(float), rotations, GL_DYNAMIC_COPY);
+        GLStateCache::bindBuffer(GL_SHADER_STORAGE_BUFFER, slice.transformBuffer);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, slice.triangleCount * sizeof(glm::mat4), nullptr, GL_DYNAMIC_COPY);
+        GLStateCache::bindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    } else if (slice.rotationBuffer) {
+        GLStateCache::deleteBuffers(1, &slice.rotationBuffer);
+        GLStateCache::deleteBuffers(1, &slice.transformBuffer);
+        slice.rotationBuffer = slice.transformBuffer = 0;
+    }
+}
+
+void TriangleAnimation::advance(AnimationPath path, float deltaTime) {
+    if (path == AnimationPath::VertexShader) {
+        animationTime += deltaTime;
+        return;
+    }
+    if (path != AnimationPath::Compute || !computeProgram || !computeAllocated) {
+        return;
+    }
+
+    GLStateCache::useProgram(computeProgram);
+    glUniform1f(glGetUniformLocation(computeProgram, "deltaTime"), deltaTime);
+    GLint countLoc = glGetUniformLocation(computeProgram, "triangleCount");
+
+    // Um dispatch por fatia, com os buffers inteiros dela: sem offsets a alinhar e
+    // no máximo sliceLimit / WORK_GROUP_SIZE grupos (abaixo de GL_MAX_COMPUTE_WORK_GROUP_COUNT)
+    for (const Slice& slice : slices) {
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, slice.transformBuffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, slice.stateBuffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, slice.rotationBuffer);
+        glUniform1ui(countLoc, (GLuint)slice.triangleCount);
+        glDispatchCompute((GLuint)((slice.triangleCount + WORK_GROUP_SIZE - 1) / WORK_GROUP_SIZE), 1, 1);
+    }
+
+    // As matrizes são lidas como SSBO pelo vertex shader das passadas seguintes
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+}
+
+void TriangleAnimation::bindSlice(GLuint program, AnimationPath path, size_t index, size_t sliceOffset) {
+    const Slice& slice = slices[index];
+    if (path == AnimationPath::VertexShader) {
+        GLStateCache::bindTextureUnit(GL_TEXTURE0 + STATE_TEXTURE_UNIT, GL_TEXTURE_BUFFER, slice.stateTexture);
+        glUniform1i(glGetUniformLocation(program, "triangleStates"), STATE_TEXTURE_UNIT);
+        glUniform1f(glGetUniformLocation(program, "animationTime"), animationTime);
+    } else if (path == AnimationPath::Compute && slice.transformBuffer) {
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, slice.transformBuffer);
+    }
+    glUniform1i(glGetUniformLocation(program, "sliceOffset"), (GLint)sliceOffset);
+}
+
+size_t TriangleAnimation::getMemoryBytes() const {
+    size_t perTriangle = sizeof(glm::vec4) + (computeAllocated ? sizeof(float) + sizeof(glm::mat4) : 0);
+    return triangleCount * perTriangle;
+}
+
+void TriangleAnimation::releaseSlice(Slice& slice) {
+    GLStateCache::deleteTextures(1, &slice.stateTexture);
+    GLStateCache::deleteBuffers(1, &slice.stateBuffer);
+    if (slice.rotationBuffer) {
+        GLStateCache::deleteBuffers(1, &slice.rotationBuffer);
+        GLStateCache::deleteBuffers(1, &slice.transformBuffer);
+    }
+    slice = {};
+}
+
+void TriangleAnimation::cleanup() {
+    for (Slice& slice : slices) {
+        releaseSlice(slice);
+    }
+    slices.clear();
+    sliceTriangles = 0;
+    if (computeProgram) {
+        GLStateCache::deleteProgram(computeProgram);
+        computeProgram = 0;
+    }
+    triangleCount = 0;
+    computeAllocated = false;
+}
@@ -0,0 +1,160 @@
+#ifndef TRIANGLEANIMATION_H
+#define TRIANGLEANIMATION_H
+
+#include <GL/glew.h>
+#include <cstddef>
+#include <glm/glm.hpp>
+#include <vector>
+
+// Onde a rotação dos triângulos é calculada a cada frame
+enum class AnimationPath {
+    CPU,            // Matriz por triângulo na CPU, enviada como uniform (um draw por triângulo; até 1M)
+    VertexShader,   // Estado em buffer texture; o vertex shader monta a matriz a partir do tempo
+    Compute         // Compute shader avança a rotação e grava as matrizes em um SSBO (GL 4.3)
+};
+
+// Estado dos triângulos na GPU para os caminhos VertexShader e Compute. Nos dois
+// o vertex shader lê a matriz do próprio triângulo (gl_VertexID / 3) e cada fatia
+// de um bloco de geometria é desenhada com um único glDrawArrays, na ordem de geração.
+//
+// O estado fica em fatias com buffers próprios, nunca em um buffer do tamanho da
+// cena. A fatia é a maior potência de dois que cabe no bloco de geometria, em
+// GL_MAX_TEXTURE_BUFFER_SIZE (estado lido como buffer texture) e, no caminho
+// Compute, em GL_MAX_SHADER_STORAGE_BLOCK_SIZE (matrizes lidas como SSBO). Com os
+// limites comuns uma fatia é um bloco inteiro; no mínimo da especificação
+// (16 MB de SSBO) o bloco de 1M triângulos vira quatro fatias.
+//
+// A matriz é a mesma da CPU: translate(centro) * rotate(ângulo, z).
+// Escolher o caminho com GLPERF_ANIMATION=vertex ou GLPERF_ANIMATION=compute.
+class TriangleAnimation {
+public:
+    static const int STATE_TEXTURE_UNIT = 7;             // GL_TEXTURE7 (0-6 são textura, clusters e G-buffer)
+    static const int WORK_GROUP_SIZE = 256;
+
+    // Inserido por ShaderVariantCache no início dos vertex shaders: define
+    // "transform" conforme o caminho (#define VERTEX_ANIMATION / COMPUTE_ANIMATION)
+    static constexpr const char* TRANSFORM_SOURCE = R"(
+        #if defined(VERTEX_ANIMATION)
+        #define GPU_ANIMATION
+        uniform samplerBuffer triangleStates;   // (x, y, z, velocidade) por triângulo da fatia
+        uniform int sliceOffset;                // Primeiro triângulo da fatia dentro do bloco desenhado
+        uniform float animationTime;
+        mat4 triangleTransform() {
+            vec4 state = texelFetch(triangleStates, gl_VertexID / 3 - sliceOffset);
+            float angle = mod(state.w * animationTime, 6.28318531);
+            float c = cos(angle);
+            float s = sin(angle);
+            return mat4(vec4(c, s, 0.0, 0.0), vec4(-s, c, 0.0, 0.0), vec4(0.0, 0.0, 1.0, 0.0),
+                        vec4(state.xyz, 1.0));
+        }
+        #define transform triangleTransform()
+        #elif defined(COMPUTE_ANIMATION)
+        #define GPU_ANIMATION
+        uniform int sliceOffset;
+        layout (std430, binding = 0) readonly buffer TriangleTransforms {
+            mat4 triangleTransforms[];          // Fatia desenhada
+        };
+        #define transform triangleTransforms[gl_VertexID / 3 - sliceOffset]
+        #else
+        uniform mat4 transform;
+        #endif
+    )";
+
+private:
+    struct Slice {
+        GLuint stateBuffer;       // vec4 (x, y, z, velocidade) por triângulo
+        GLuint stateTexture;      // Buffer texture sobre stateBuffer
+        GLuint rotationBuffer;    // Ângulo atual por triângulo (só no caminho Compute)
+        GLuint transformBuffer;   // mat4 por triângulo gravada pelo compute shader
+        size_t triangleCount;
+    };
+
+    std::vector<Slice> slices;
+    size_t sliceTriangles;         // Triângulos por fatia (a última pode ter menos)
+    size_t sliceLimit;             // Bloco de geometria (potência de dois): nenhuma fatia o atravessa
+    GLint maxTextureBufferTexels;
+    GLint maxStorageBlockBytes;    // 0 sem GL 4.3 ou sem SSBOs no vertex shader
+    GLuint computeProgram;
+    size_t triangleCount;
+    bool computeAllocated;         // Fatias com ângulos e matrizes
+    float animationTime;           // Segundos desde o último upload (caminho VertexShader)
+
+    const char* computeShaderSource = R"(
+        #version 430 core
+        layout (local_size_x = 256) in;
+
+        layout (std430, binding = 0) writeonly buffer TriangleTransforms {
+            mat4 transforms[];
+        };
+        layout (std430, binding = 1) readonly buffer TriangleStates {
+            vec4 states[];          // (x, y, z, velocidade)
+        };
+        layout (std430, binding = 2) buffer TriangleRotations {
+            float rotations[];
+        };
+
+        uniform uint triangleCount;   // Triângulos nesta fatia
+        uniform float deltaTime;
+
+        void main() {
+            uint i = gl_GlobalInvocationID.x;
+            if (i >= triangleCount) {
+                return;
+            }
+
+            // Mesmo passo da CPU, inclusive a volta a zero depois de 2*pi
+            vec4 state = states[i];
+            float angle = rotations[i] + state.w * deltaTime;
+            if (angle > 6.28318531) {
+                angle = 0.0;
+            }
+            rotations[i] = angle;
+
+            float c = cos(angle);
+            float s = sin(angle);
+            transforms[i] = mat4(vec4(c, s, 0.0, 0.0), vec4(-s, c, 0.0, 0.0), vec4(0.0, 0.0, 1.0, 0.0),
+                                 vec4(state.xyz, 1.0));
+        }
+    )";
+
+    bool createComputeProgram();
+    void releaseSlice(Slice& slice);
+
+public:
+    TriangleAnimation();
+    ~TriangleAnimation();
+
+    // maxSliceTriangles: tamanho do bloco de geometria (potência de dois). Os
+    // limites de buffer texture e SSBO do driver são lidos aqui
+    bool initialize(size_t maxSliceTriangles);
+    void cleanup();
+
+    // GLPERF_ANIMATION=vertex|compute (padrão: CPU)
+    static AnimationPath requestedPath();
+    static const char* pathName(AnimationPath path);
+    // Compute shaders e SSBOs no vertex shader precisam de GL 4.3
+    static bool isComputeSupported();
+
+    // Triângulos por fatia no caminho dado; 0 se os limites do driver não
+    // comportam nem um grupo de trabalho (o caminho deve ser recusado)
+    size_t sliceSizeFor(AnimationPath path) const;
+
+    // Dimensionar as fatias para count triângulos; withCompute aloca também
+    // ângulos e matrizes. false se o caminho não cabe nos limites do driver
+    bool allocate(size_t count, bool withCompute);
+    // Enviar o estado da fatia (getSliceTriangles() triângulos, menos na última)
+    void uploadSlice(size_t index, const glm::vec4* states, const float* rotations);
+    size_t getSliceTriangles() const { return sliceTriangles; }
+    size_t getSliceCount() const { return slices.size(); }
+
+    // Avançar a animação um frame (antes de qualquer passada de desenho)
+    void advance(AnimationPath path, float deltaTime);
+
+    // Ligar a fatia para o programa ativo; sliceOffset é a posição do primeiro
+    // triângulo dela dentro do bloco de geometria desenhado
+    void bindSlice(GLuint program, AnimationPath path, size_t index, size_t sliceOffset);
+
+    size_t getMemoryBytes() const;
+};
+
+#endif
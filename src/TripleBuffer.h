@@ -0,0 +1,54 @@
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+#include <atomic>
+
+// Buffer triplo sem travas para um produtor e um consumidor: o produtor
+// escreve no slot de trás e o publica trocando-o com o slot do meio; o
+// consumidor troca o seu slot da frente com o do meio quando há dado novo.
+// Nenhum lado espera o outro nem copia dados: só índices são trocados.
+//
+// O slot do meio fica em um único atômico (bits 0-1 = índice, bit 2 = novo).
+template <typename T>
+class TripleBuffer {
+private:
+    static const unsigned INDEX_MASK = 3;
+    static const unsigned FRESH = 4;
+
+    T slots[3];
+    std::atomic<unsigned> middle;
+    unsigned back;    // Só o produtor acessa
+    unsigned front;   // Só o consumidor acessa
+
+public:
+    TripleBuffer() : middle(1), back(0), front(2) {}
+
+    // Slot em que o produtor monta o próximo snapshot
+    T& writeBuffer() { return slots[back]; }
+
+    // Tornar o snapshot montado visível ao consumidor
+    void publish() {
+        back = middle.exchange(back | FRESH, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    // Trazer o snapshot mais recente para a frente; false se nada novo foi publicado
+    bool acquire() {
+        if (!(middle.load(std::memory_order_relaxed) & FRESH)) {
+            return false;
+        }
+        front = middle.exchange(front, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+
+    // Último snapshot adquirido (estável até o próximo acquire())
+    const T& readBuffer() const { return slots[front]; }
+
+    // Voltar ao estado inicial; só com produtor e consumidor parados
+    void reset() {
+        middle.store(1, std::memory_order_relaxed);
+        back = 0;
+        front = 2;
+    }
+};
+
+#endif
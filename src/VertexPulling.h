@@ -0,0 +1,60 @@
+#ifndef VERTEXPULLING_H
+#define VERTEXPULLING_H
+
+#include <GL/glew.h>
+#include <cstddef>
+#include <cstdlib>
+#include <string>
+
+// Busca programável de vértices. Em vez de três vértices expandidos de 11 floats
+// por triângulo (132 bytes), cada bloco de geometria guarda um registro de dois
+// texels RGBA32F por triângulo (32 bytes) numa buffer texture:
+//   texel 0: (x, y, z, velocidade)   texel 1: (r, g, b, 0)
+// O vertex shader remonta os três cantos a partir de gl_VertexID e o VAO do bloco
+// fica sem atributos. Ativar com GLPERF_VERTEX_PULLING=1.
+class VertexPulling {
+public:
+    static const int RECORD_TEXTURE_UNIT = 8;     // GL_TEXTURE8 (7 é o estado da TriangleAnimation)
+    static const int TEXELS_PER_TRIANGLE = 2;
+    static const size_t FLOATS_PER_RECORD = 8;
+
+    // Inserido por ShaderVariantCache no início dos vertex shaders: declara
+    // aPos, aColor, aNormal e aTexCoord como atributos ou lidos do registro (#define PULLED_VERTICES)
+    static constexpr const char* VERTEX_INPUT_SOURCE = R"(
+        #ifdef PULLED_VERTICES
+        uniform samplerBuffer triangleRecords;   // Registros do bloco desenhado
+        // Canto em relação ao centro (xy) e coordenada de textura (zw), na mesma
+        // ordem de AdvancedRenderer::buildChunkVertices
+        const vec4 pulledCorners[3] = vec4[3](vec4(0.0, 0.1, 0.5, 1.0), vec4(-0.1, -0.1, 0.0, 0.0),
+                                              vec4(0.1, -0.1, 1.0, 0.0));
+        vec3 pulledPosition() {
+            vec4 center = texelFetch(triangleRecords, (gl_VertexID / 3) * 2);
+            return vec3(center.xy + pulledCorners[gl_VertexID % 3].xy, center.z);
+        }
+        #define aPos pulledPosition()
+        #define aColor texelFetch(triangleRecords, (gl_VertexID / 3) * 2 + 1).rgb
+        #define aNormal vec3(0.0, 0.0, 1.0)   // Todos os triângulos são gerados voltados para +z
+        #define aTexCoord pulledCorners[gl_VertexID % 3].zw
+        #else
+        layout (location = 0) in vec3 aPos;
+        layout (location = 1) in vec3 aColor;
+        layout (location = 2) in vec3 aNormal;
+        layout (location = 3) in vec2 aTexCoord;
+        #endif
+    )";
+
+    static bool isRequested() {
+        const char* env = std::getenv("GLPERF_VERTEX_PULLING");
+        return env && std::string(env) == "1";
+    }
+
+    // O GL 3.3 só garante 64K texels por buffer texture; cada bloco precisa de
+    // TEXELS_PER_TRIANGLE texels por triângulo
+    static bool isSupported(size_t trianglesPerChunk) {
+        GLint maxTexels = 0;
+        glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &maxTexels);
+        return (size_t)maxTexels >= trianglesPerChunk * TEXELS_PER_TRIANGLE;
+    }
+};
+
+#endif
@@ -7,6 +7,9 @@
 #include <cmath>
 #include "AdvancedRenderer.h"
 #include "PerformanceMonitor.h"
+#include "StartupProfile.h"
+#include "GLStateCache.h"
+#include "GLProfiler.h"
 
 // Configurações da janela
 const int WINDOW_WIDTH = 1024;
@@ -24,9 +27,10 @@ int frameCount = 0;
 double fps = 0.0;
 
 // Configurações do teste
-int currentTriangleCount = 1;
-int maxTriangles = 500;  // Reduzido para testes com efeitos
-int triangleStep = 25;
+int64_t currentTriangleCount = 1;
+int64_t maxTriangles = 500;  // Reduzido para testes com efeitos
+int64_t triangleStep = 25;
+int textureSize = 1024;  // Grande o suficiente para a amostragem depender da banda de memória
 bool testRunning = false;
 bool testComplete = false;
 
@@ -35,15 +39,29 @@ enum TestState {
     BASIC_TEST,      // Sem efeitos
     LIGHTING_TEST,   // Com iluminação
     TEXTURE_TEST,    // Com texturas
-    COMBINED_TEST    // Com ambos
+    COMBINED_TEST,   // Com ambos
+    BC1_TEST,        // Texturas comprimidas BC1 (DXT1)
+    BC3_TEST,        // Texturas comprimidas BC3 (DXT5)
+    STREAM_TEST      // Textura nova a cada frame, enviada por PBO (TextureStreamer)
 };
 
 TestState currentTest = BASIC_TEST;
-std::string testNames[] = {"Básico", "Iluminação", "Texturas", "Combinado"};
+std::string testNames[] = {"Básico", "Iluminação", "Texturas", "Combinado", "Texturas BC1", "Texturas BC3",
+                         "Streaming de texturas"};
+
+// Voltar à textura fixa sem compressão usada pelas fases de textura/combinado
+void resetTextureFormat() {
+    if (renderer && renderer->isTextureStreamingEnabled()) {
+        renderer->setTextureStreaming(false);
+    }
+    if (renderer && renderer->getTextureFormat() != TextureFormat::RGBA8) {
+        renderer->setTextureConfig(textureSize);
+    }
+}
 
 // Callback para redimensionamento da janela
 void framebuffer_size_callback(GLFWwindow* window, int width, int height) {
-    glViewport(0, 0, width, height);
+    GLStateCache::viewport(0, 0, width, height);
 }
 
 // Callback para teclado
@@ -58,6 +76,8 @@ void key_callback(GLFWwindow* window, int key, int scancode, int action, int mod
             currentTriangleCount = 1;
             testComplete = false;
             currentTest = BASIC_TEST;
+            resetTextureFormat();
+            if (perfMonitor) perfMonitor->setPhase(testNames[currentTest]);
         } else {
             std::cout << "\nTeste pausado. Pressione ESPAÇO para continuar." << std::endl;
         }
@@ -68,6 +88,7 @@ void key_callback(GLFWwindow* window, int key, int scancode, int action, int mod
         testRunning = false;
         testComplete = false;
         currentTest = BASIC_TEST;
+        resetTextureFormat();
         std::cout << "\nTeste resetado." << std::endl;
     }
     else if (key == GLFW_KEY_L && action == GLFW_PRESS) {
@@ -86,6 +107,7 @@ void key_callback(GLFWwindow* window, int key, int scancode, int action, int mod
 
 // Inicializar GLFW e criar janela
 bool initializeGLFW() {
+    StartupProfile::Scope phase("Contexto GL (GLFW)");
     if (!glfwInit()) {
         std::cerr << "Erro ao inicializar GLFW" << std::endl;
         return false;
@@ -113,6 +135,7 @@ bool initializeGLFW() {
 
 // Inicializar GLEW
 bool initializeGLEW() {
+    StartupProfile::Scope phase("GLEW");
     if (glewInit() != GLEW_OK) {
         std::cerr << "Erro ao inicializar GLEW" << std::endl;
         return false;
@@ -143,7 +166,8 @@ void updateFPS() {
             
             // Registrar dados de performance
             if (perfMonitor) {
-                perfMonitor->addDataPoint(fps, currentTriangleCount, hasLighting, hasTextures);
+                perfMonitor->addDataPoint(fps, currentTriangleCount, hasLighting, hasTextures,
+                                          renderer->getRenderStats());
             }
             
             // Avançar para próximo teste
@@ -153,9 +177,10 @@ void updateFPS() {
                 currentTriangleCount = 1;
                 currentTest = static_cast<TestState>(currentTest + 1);
                 
-                if (currentTest > COMBINED_TEST) {
+                if (currentTest > STREAM_TEST) {
                     testComplete = true;
                     testRunning = false;
+                    resetTextureFormat();
                     std::cout << "\n=== TESTE AVANÇADO CONCLUÍDO ===" << std::endl;
                     std::cout << "Gerando relatórios..." << std::endl;
                     
@@ -185,7 +210,25 @@ void updateFPS() {
                             renderer->setLightingEnabled(true);
                             renderer->setTexturesEnabled(true);
                             break;
+                        case BC1_TEST:
+                            renderer->setLightingEnabled(false);
+                            renderer->setTexturesEnabled(true);
+                            renderer->setTextureConfig(textureSize, 1, true, TextureFormat::BC1);
+                            break;
+                        case BC3_TEST:
+                            renderer->setLightingEnabled(false);
+                            renderer->setTexturesEnabled(true);
+                            renderer->setTextureConfig(textureSize, 1, true, TextureFormat::BC3);
+                            break;
+                        case STREAM_TEST:
+                            // Mesma cena da fase de texturas: a diferença no tempo de frame é o streaming
+                            resetTextureFormat();
+                            renderer->setLightingEnabled(false);
+                            renderer->setTexturesEnabled(true);
+                            renderer->setTextureStreaming(true, textureSize);
+                            break;
                     }
+                    if (perfMonitor) perfMonitor->setPhase(testNames[currentTest]);
                     std::cout << "\nIniciando teste: " << testNames[currentTest] << std::endl;
                 }
             } else {
@@ -220,7 +263,10 @@ void renderLoop() {
 
         // Renderizar triângulos
         if (renderer) {
+            // Estatísticas do pipeline (vértices, primitivas, invocações) do frame
+            if (perfMonitor) perfMonitor->beginPipelineQueries();
             renderer->render(deltaTime);
+            if (perfMonitor) perfMonitor->endPipelineQueries();
         }
 
         // Atualizar monitoramento de performance
@@ -235,6 +281,11 @@ void renderLoop() {
         glfwSwapBuffers(window);
         glfwPollEvents();
         
+        // Registrar o tempo de inicialização assim que o primeiro frame é apresentado
+        if (perfMonitor) {
+            perfMonitor->recordFirstFrame("AdvancedTest");
+        }
+        
         // Pequena pausa entre testes para estabilizar
         if (testRunning && !testComplete) {
             std::this_thread::sleep_for(std::chrono::milliseconds(100));
@@ -243,6 +294,13 @@ void renderLoop() {
 }
 
 int main() {
+    StartupProfile::start();
+    
+    // Informações do sistema (lspci) numa thread de fundo, sobrepostas à
+    // criação do contexto e dos shaders
+    perfMonitor = new PerformanceMonitor();
+    perfMonitor->querySystemInfo();
+
     std::cout << "=== OpenGL Performance Test - Iluminação e Texturas ===" << std::endl;
     std::cout << "Iniciando teste avançado de desempenho..." << std::endl;
 
@@ -261,7 +319,7 @@ int main() {
     }
 
     // Habilitar teste de profundidade
-    glEnable(GL_DEPTH_TEST);
+    GLStateCache::setDepthTest(true);
 
     // Criar renderer avançado
     renderer = new AdvancedRenderer();
@@ -274,9 +332,9 @@ int main() {
 
     // Configurar número inicial de triângulos
     renderer->setTriangleCount(currentTriangleCount);
+    renderer->setTextureConfig(textureSize);
 
-    // Criar monitor de performance
-    perfMonitor = new PerformanceMonitor();
+    // Inicializar monitor de performance
     perfMonitor->initialize();
 
     std::cout << "\nControles:" << std::endl;
@@ -285,11 +343,14 @@ int main() {
     std::cout << "T - Alternar texturas" << std::endl;
     std::cout << "R - Reset do teste" << std::endl;
     std::cout << "ESC - Sair" << std::endl;
-    std::cout << "\nO teste irá executar 4 fases:" << std::endl;
+    std::cout << "\nO teste irá executar 7 fases:" << std::endl;
     std::cout << "1. Básico (sem efeitos)" << std::endl;
     std::cout << "2. Com iluminação" << std::endl;
     std::cout << "3. Com texturas" << std::endl;
     std::cout << "4. Combinado (iluminação + texturas)" << std::endl;
+    std::cout << "5. Texturas comprimidas BC1" << std::endl;
+    std::cout << "6. Texturas comprimidas BC3" << std::endl;
+    std::cout << "7. Streaming de texturas (PBO, uma nova por frame)" << std::endl;
     std::cout << "Pressione ESPAÇO para iniciar..." << std::endl;
 
     // Loop principal
@@ -0,0 +1,48 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+#include "BenchAnalyzer.h"
+
+// Análise dos CSVs do PerformanceMonitor sem Python (substitui
+// scripts/analyze_extreme_data.py em capturas longas e hosts sem pandas)
+int main(int argc, char* argv[]) {
+    std::vector<std::string> inputs;
+    std::string outputDir = "reports";
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if ((arg == "-o" || arg == "--output") && i + 1 < argc) {
+            outputDir = argv[++i];
+        } else {
+            inputs.push_back(arg);
+        }
+    }
+
+    if (inputs.empty()) {
+        std::cout << "Uso: bench_analyze <arquivo.csv> [outros.csv ...] [-o diretório]" << std::endl;
+        std::cout << "Exemplo: bench_analyze data/extreme_performance_data.csv" << std::endl;
+        return 1;
+    }
+
+    // Vários arquivos (várias execuções) entram nos mesmos agregados
+    BenchAnalyzer analyzer;
+    for (const std::string& input : inputs) {
+        analyzer.addFile(input);
+    }
+    if (analyzer.getRowCount() == 0) {
+        std::cerr << "Nenhuma medição válida encontrada" << std::endl;
+        return 1;
+    }
+
+    analyzer.printSummary();
+
+    mkdir(outputDir.c_str(), 0755);
+    std::string svgPath = outputDir + "/bench_analysis.svg";
+    std::string markdownPath = outputDir + "/bench_summary.md";
+    if (!analyzer.writeSvg(svgPath) || !analyzer.writeMarkdown(markdownPath)) {
+        return 1;
+    }
+    std::cout << "\n✓ Gráficos salvos em: " << svgPath << std::endl;
+    std::cout << "✓ Resumo salvo em: " << markdownPath << std::endl;
+    return 0;
+}
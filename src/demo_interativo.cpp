@@ -6,8 +6,13 @@
 #include <vector>
 #include <cmath>
 #include <iomanip>
+#include <cstdlib>
 #include "AdvancedRenderer.h"
 #include "PerformanceMonitor.h"
+#include "StartupProfile.h"
+#include "DynamicResolution.h"
+#include "GLStateCache.h"
+#include "GLProfiler.h"
 
 // Configurações da janela
 const int WINDOW_WIDTH = 1280;
@@ -18,6 +23,8 @@ const char* WINDOW_TITLE = "Demo Interativa OpenGL - Teste de Performance";
 GLFWwindow* window = nullptr;
 AdvancedRenderer* renderer = nullptr;
 PerformanceMonitor* perfMonitor = nullptr;
+DynamicResolution* dynamicResolution = nullptr;
+bool useDynamicResolution = true;
 
 // Controle de FPS
 double lastTime = 0.0;
@@ -25,10 +32,19 @@ int frameCount = 0;
 double fps = 0.0;
 
 // Configurações do demo
-int currentTriangleCount = 100;
-int minTriangles = 100;
-int maxTriangles = 999999; // Sem limite prático
-int triangleStep = 100;
+int64_t currentTriangleCount = 100;
+int64_t minTriangles = 100;
+int64_t maxTriangles = 50000000; // Geometria em blocos de 1M triângulos
+
+// Passo proporcional à carga: 100 abaixo de 10 mil triângulos, depois a maior
+// potência de 10 que não passa de 10% do total (100 mil em 1M, 1M em 10M)
+int64_t triangleStepFor(int64_t count) {
+    int64_t step = 100;
+    while (step * 100 <= count) {
+        step *= 10;
+    }
+    return step;
+}
 
 // Modos de renderização
 enum RenderMode {
@@ -52,7 +68,7 @@ double lastModeChangeTime = 0.0;
 
 // Callback para redimensionamento da janela
 void framebuffer_size_callback(GLFWwindow* window, int width, int height) {
-    glViewport(0, 0, width, height);
+    GLStateCache::viewport(0, 0, width, height);
 }
 
 // Callback para teclado
@@ -100,7 +116,7 @@ void key_callback(GLFWwindow* window, int key, int scancode, int action, int mod
             case GLFW_KEY_UP:
             case GLFW_KEY_KP_ADD:
             case GLFW_KEY_EQUAL:
-                currentTriangleCount = std::min(currentTriangleCount + triangleStep, maxTriangles);
+                currentTriangleCount = std::min(currentTriangleCount + triangleStepFor(currentTriangleCount), maxTriangles);
                 renderer->setTriangleCount(currentTriangleCount);
                 std::cout << "Triângulos: " << currentTriangleCount << std::endl;
                 break;
@@ -108,11 +124,82 @@ void key_callback(GLFWwindow* window, int key, int scancode, int action, int mod
             case GLFW_KEY_DOWN:
             case GLFW_KEY_KP_SUBTRACT:
             case GLFW_KEY_MINUS:
-                currentTriangleCount = std::max(currentTriangleCount - triangleStep, minTriangles);
+                // Passo da contagem de baixo: descer desfaz a última subida
+                currentTriangleCount = std::max(currentTriangleCount - triangleStepFor(currentTriangleCount - 1),
+                                                minTriangles);
                 renderer->setTriangleCount(currentTriangleCount);
                 std::cout << "Triângulos: " << currentTriangleCount << std::endl;
                 break;
                 
+            case GLFW_KEY_D:
+                if (action == GLFW_PRESS) {
+                    renderer->setDeferredShading(!renderer->isDeferredShading());
+                }
+                break;
+                
+            case GLFW_KEY_O:
+                if (action == GLFW_PRESS) {
+                    renderer->setOverdrawAnalysis(!renderer->isOverdrawAnalysisEnabled());
+                }
+                break;
+                
+            case GLFW_KEY_P:
+                if (action == GLFW_PRESS) {
+                    system("mkdir -p reports");
+                    renderer->writeOverdrawHeatmap("reports/overdraw_demo.ppm");
+                }
+                break;
+                
+            case GLFW_KEY_L:
+                if (action == GLFW_PRESS) {
+                    // Percorrer os níveis manualmente (desliga a seleção automática)
+                    ShadingTier next = (ShadingTier)(((int)renderer->getShadingTier() + 1) % 3);
+                    renderer->setShadingTier(next);
+                }
+                break;
+                
+            case GLFW_KEY_G:
+                if (action == GLFW_PRESS) {
+                    renderer->setShadingGovernor(!renderer->isShadingGovernorEnabled());
+                }
+                break;
+                
+            case GLFW_KEY_T:
+                if (action == GLFW_PRESS) {
+                    renderer->setSimulationThread(!renderer->isSimulationThreadEnabled());
+                }
+                break;
+                
+            case GLFW_KEY_A:
+                if (action == GLFW_PRESS) {
+                    // CPU → vertex shader → compute shader (sem GL 4.3, volta para CPU)
+                    AnimationPath next = (AnimationPath)(((int)renderer->getAnimationPath() + 1) % 3);
+                    if (!renderer->setAnimationPath(next)) {
+                        renderer->setAnimationPath(AnimationPath::CPU);
+                    }
+                }
+                break;
+                
+            case GLFW_KEY_V:
+                if (action == GLFW_PRESS) {
+                    renderer->setVertexPulling(!renderer->isVertexPullingEnabled());
+                }
+                break;
+                
+            case GLFW_KEY_U:
+                if (action == GLFW_PRESS) {
+                    // Só aparece nos modos com textura (3 e 4)
+                    renderer->setTextureStreaming(!renderer->isTextureStreamingEnabled());
+                }
+                break;
+                
+            case GLFW_KEY_S:
+                if (action == GLFW_PRESS && dynamicResolution) {
+                    useDynamicResolution = !useDynamicResolution;
+                    std::cout << "Resolução dinâmica: " << (useDynamicResolution ? "ligada" : "desligada") << std::endl;
+                }
+                break;
+                
             case GLFW_KEY_H:
                 showHelp = !showHelp;
                 break;
@@ -131,6 +218,7 @@ void key_callback(GLFWwindow* window, int key, int scancode, int action, int mod
 
 // Inicializar GLFW e criar janela
 bool initializeGLFW() {
+    StartupProfile::Scope phase("Contexto GL (GLFW)");
     if (!glfwInit()) {
         std::cerr << "Erro ao inicializar GLFW" << std::endl;
         return false;
@@ -156,6 +244,7 @@ bool initializeGLFW() {
 
 // Inicializar GLEW
 bool initializeGLEW() {
+    StartupProfile::Scope phase("GLEW");
     if (glewInit() != GLEW_OK) {
         std::cerr << "Erro ao inicializar GLEW" << std::endl;
         return false;
@@ -180,8 +269,29 @@ void updateFPS() {
         std::cout << std::fixed << std::setprecision(1);
         std::cout << "FPS: " << fps 
                   << " | Triângulos: " << currentTriangleCount
-                  << " | Modo: " << modeNames[currentMode]
-                  << std::endl;
+                  << " | Modo: " << modeNames[currentMode];
+        if (renderer->isSimulationThreadEnabled()) {
+            RenderStats simulationStats = renderer->getRenderStats();
+            std::cout << " | Simulação: " << simulationStats.simulationHz << " Hz ("
+                      << simulationStats.simulationStepMs << " ms/passo)";
+        }
+        
+        // Com resolução dinâmica, cada segundo vira uma medição (escala e erro de tempo)
+        if (useDynamicResolution && dynamicResolution && perfMonitor) {
+            std::cout << " | Escala: " << dynamicResolution->getScale() * 100.0 << "%"
+                      << " | GPU: " << dynamicResolution->getGPUFrameMs() << " ms";
+            std::cout << std::endl;
+            
+            RenderStats stats = renderer->getRenderStats();
+            stats.resolutionScale = dynamicResolution->getScale();
+            stats.gpuFrameMs = dynamicResolution->getGPUFrameMs();
+            stats.frameTimeErrorMs = dynamicResolution->getFrameTimeErrorMs();
+            bool hasLighting = currentMode == MODE_ILUMINACAO || currentMode == MODE_COMBINADO;
+            bool hasTextures = currentMode == MODE_TEXTURAS || currentMode == MODE_COMBINADO;
+            perfMonitor->addDataPoint(fps, currentTriangleCount, hasLighting, hasTextures, stats);
+        } else {
+            std::cout << std::endl;
+        }
         
         frameCount = 0;
         lastTime = currentTime;
@@ -208,9 +318,19 @@ void displayHelp() {
             std::cout << "║  [3] → Modo TEXTURAS (texturas procedurais)                  ║" << std::endl;
             std::cout << "║  [4] → Modo COMBINADO (iluminação + texturas)                ║" << std::endl;
             std::cout << "║                                                               ║" << std::endl;
-            std::cout << "║  [↑] ou [+] → Aumentar triângulos (+100)                     ║" << std::endl;
-            std::cout << "║  [↓] ou [-] → Diminuir triângulos (-100)                     ║" << std::endl;
+            std::cout << "║  [↑] ou [+] → Aumentar triângulos (passo de ~10%)            ║" << std::endl;
+            std::cout << "║  [↓] ou [-] → Diminuir triângulos (passo de ~10%)            ║" << std::endl;
             std::cout << "║                                                               ║" << std::endl;
+            std::cout << "║  [D] → Alternar iluminação forward / adiada (deferred)       ║" << std::endl;
+            std::cout << "║  [O] → Ligar/desligar contagem de overdraw                   ║" << std::endl;
+            std::cout << "║  [P] → Gravar mapa de overdraw (reports/overdraw_demo.ppm)   ║" << std::endl;
+            std::cout << "║  [S] → Ligar/desligar resolução dinâmica                     ║" << std::endl;
+            std::cout << "║  [L] → Nível de shading: fragmento / vértice / sem luz       ║" << std::endl;
+            std::cout << "║  [G] → Ligar/desligar escolha automática do nível de shading ║" << std::endl;
+            std::cout << "║  [T] → Simulação em thread separada (buffer triplo)          ║" << std::endl;
+            std::cout << "║  [A] → Animação na CPU / vertex shader / compute shader      ║" << std::endl;
+            std::cout << "║  [V] → Vértices por atributos / busca programável (pulling)  ║" << std::endl;
+            std::cout << "║  [U] → Streaming de texturas por PBO (nova a cada frame)     ║" << std::endl;
             std::cout << "║  [R] → Resetar (volta ao modo básico, 50 triângulos)         ║" << std::endl;
             std::cout << "║  [H] → Mostrar/Ocultar esta ajuda                            ║" << std::endl;
             std::cout << "║  [ESC] → Sair                                                 ║" << std::endl;
@@ -226,7 +346,7 @@ void displayHelp() {
             std::cout << "╚═══════════════════════════════════════════════════════════════╝" << std::endl;
             std::cout << "\n>>> Iniciando em MODO BÁSICO com " << currentTriangleCount << " triângulos..." << std::endl;
             std::cout << ">>> Pressione as teclas de 1 a 4 para alternar entre os modos!" << std::endl;
-            std::cout << ">>> AVISO: Sem limite de triângulos - cuidado com valores muito altos!\n" << std::endl;
+            std::cout << ">>> AVISO: Até 50 milhões de triângulos - cuidado com valores muito altos!\n" << std::endl;
             helpShownOnce = true;
         }
     }
@@ -247,9 +367,17 @@ void renderLoop() {
         glClearColor(0.15f, 0.15f, 0.2f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-        // Renderizar triângulos
+        // Renderizar triângulos (no alvo reduzido quando a resolução dinâmica está ligada)
         if (renderer) {
-            renderer->render(deltaTime);
+            int framebufferWidth, framebufferHeight;
+            glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+            if (useDynamicResolution && dynamicResolution &&
+                dynamicResolution->beginFrame(framebufferWidth, framebufferHeight)) {
+                renderer->render(deltaTime);
+                dynamicResolution->endFrame();
+            } else {
+                renderer->render(deltaTime);
+            }
         }
 
         // Atualizar monitoramento de performance
@@ -263,10 +391,22 @@ void renderLoop() {
         // Trocar buffers e processar eventos
         glfwSwapBuffers(window);
         glfwPollEvents();
+        
+        // Registrar o tempo de inicialização assim que o primeiro frame é apresentado
+        if (perfMonitor) {
+            perfMonitor->recordFirstFrame("DemoInterativo");
+        }
     }
 }
 
 int main() {
+    StartupProfile::start();
+    
+    // Informações do sistema (lspci) numa thread de fundo, sobrepostas à
+    // criação do contexto e dos shaders
+    perfMonitor = new PerformanceMonitor();
+    perfMonitor->querySystemInfo();
+
     std::cout << "\n";
     std::cout << "╔═══════════════════════════════════════════════════════════════╗" << std::endl;
     std::cout << "║                   DEMO INTERATIVA OPENGL                      ║" << std::endl;
@@ -286,7 +426,7 @@ int main() {
     }
 
     // Habilitar teste de profundidade
-    glEnable(GL_DEPTH_TEST);
+    GLStateCache::setDepthTest(true);
 
     // Criar renderer avançado
     renderer = new AdvancedRenderer();
@@ -300,9 +440,16 @@ int main() {
     // Configurar número inicial de triângulos
     renderer->setTriangleCount(currentTriangleCount);
 
-    // Criar monitor de performance
-    perfMonitor = new PerformanceMonitor();
+    // Inicializar monitor de performance
     perfMonitor->initialize();
+    
+    // Resolução dinâmica para segurar o orçamento de tempo de GPU
+    dynamicResolution = new DynamicResolution(FrameBudget::requestedTargetMs());
+    if (!dynamicResolution->initialize()) {
+        std::cerr << "Resolução dinâmica indisponível, renderizando na resolução da janela" << std::endl;
+        delete dynamicResolution;
+        dynamicResolution = nullptr;
+    }
 
     std::cout << "\n✓ Inicialização concluída com sucesso!" << std::endl;
     std::cout << "✓ Aguarde carregamento da interface...\n" << std::endl;
@@ -310,7 +457,15 @@ int main() {
     // Loop principal
     renderLoop();
 
+    // Relatórios das medições com resolução dinâmica
+    if (!perfMonitor->getDataPoints().empty()) {
+        system("mkdir -p data reports");
+        perfMonitor->generateCSVReport("data/demo_performance_data.csv");
+        perfMonitor->generatePerformanceReport("reports/demo_performance_report.txt");
+    }
+
     // Limpeza
+    delete dynamicResolution;
     delete renderer;
     delete perfMonitor;
     glfwTerminate();
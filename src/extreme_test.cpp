@@ -4,9 +4,17 @@
 #include <chrono>
 #include <thread>
 #include <vector>
+#include <string>
+#include <iterator>
+#include <algorithm>
 #include <cmath>
+#include <cstdlib>
 #include "AdvancedRenderer.h"
 #include "PerformanceMonitor.h"
+#include "StartupProfile.h"
+#include "GLStateCache.h"
+#include "GLProfiler.h"
+#include "TelemetryServer.h"
 
 // Configurações da janela
 const int WINDOW_WIDTH = 1024;
@@ -17,6 +25,7 @@ const char* WINDOW_TITLE = "OpenGL Extreme Performance Test";
 GLFWwindow* window = nullptr;
 AdvancedRenderer* renderer = nullptr;
 PerformanceMonitor* perfMonitor = nullptr;
+TelemetryServer* telemetry = nullptr;   // Com GLPERF_TELEMETRY_PORT
 
 // Controle de FPS
 double lastTime = 0.0;
@@ -24,24 +33,179 @@ int frameCount = 0;
 double fps = 0.0;
 
 // Configurações do teste EXTREMO
-int currentTriangleCount = 10000;
-int maxTriangles = 200000;  // 200 mil triângulos!
-int triangleStep = 10000;   // Passo de 10 mil
+int64_t currentTriangleCount = 10000;
+int64_t maxTriangles = 200000;  // 200 mil triângulos! (GLPERF_MAX_TRIANGLES=N vai além)
+int64_t triangleStep = 10000;   // Passo de 10 mil (N/20 com GLPERF_MAX_TRIANGLES)
 bool testRunning = false;
 bool testComplete = false;
 
-// Estados dos testes (3 modos)
+// Varredura de luzes: triângulos fixos, número de luzes dobrando a cada medição
+// (acima de 8 luzes o shader usa iluminação por clusters)
+int64_t sweepTriangleCount = 50000;
+int minLights = 8;
+int currentLightCount = minLights;
+int maxLights = 4096;
+
+// Forward vs deferred: mesma varredura de triângulos e mesmas luzes nos dois
+// caminhos; o relatório aponta a partir de quantos triângulos o deferred vence
+int pathLightCount = 64;
+
+// Overdraw: cena combinada com triângulos espalhados em profundidade, desenhados
+// na ordem de geração, de frente para trás e com pré-passada de profundidade
+float depthSpread = 1.0f;
+
+// Estados dos testes (12 modos)
 enum TestState {
     BASIC_TEST,
     LIGHTING_TEST,
-    COMBINED_TEST
+    COMBINED_TEST,
+    DEPTH_UNSORTED_TEST,
+    DEPTH_SORTED_TEST,
+    DEPTH_PREPASS_TEST,
+    FORWARD_PATH_TEST,
+    DEFERRED_PATH_TEST,
+    LIGHT_SWEEP_TEST,
+    VERTEX_ANIMATION_TEST,
+    VERTEX_PULLING_TEST,
+    COMPUTE_ANIMATION_TEST
 };
 
 TestState currentTest = BASIC_TEST;
-std::string testNames[] = {"Básico", "Iluminação", "Combinado"};
+std::string testNames[] = {"Básico", "Iluminação", "Combinado", "Profundidade", "Ordenado", "Pré-passada",
+                           "Forward", "Deferred", "Luzes", "Animação VS", "Vertex pulling",
+                           "Animação Compute"};
 
 void framebuffer_size_callback(GLFWwindow* window, int width, int height) {
-    glViewport(0, 0, width, height);
+    GLStateCache::viewport(0, 0, width, height);
+}
+
+void startExtremeTest() {
+    if (testRunning || testComplete) {
+        return;
+    }
+    testRunning = true;
+    std::cout << "\n=== INICIANDO TESTE EXTREMO AUTOMÁTICO ===" << std::endl;
+    std::cout << "PASSOS DE " << triangleStep << " TRIÂNGULOS ATÉ " << maxTriangles << "!" << std::endl;
+    std::cout << "O teste rodará automaticamente pelos 12 modos" << std::endl;
+    currentTriangleCount = 10000;
+    testComplete = false;
+    currentTest = BASIC_TEST;
+    
+    // Configurar modo inicial (básico)
+    if (renderer) {
+        renderer->setLightingEnabled(false);
+        renderer->setTexturesEnabled(false);
+        renderer->setAnimationPath(AnimationPath::CPU);
+        renderer->setVertexPulling(false);
+        renderer->setTriangleCount(currentTriangleCount);
+    }
+    if (perfMonitor) {
+        perfMonitor->setPhase(testNames[currentTest]);
+    }
+    std::cout << "\n>>> Teste 1/12: BÁSICO iniciado..." << std::endl;
+}
+
+// Interromper a varredura mantendo o modo e as medições; start recomeça do modo 1
+void stopExtremeTest() {
+    if (!testRunning) {
+        return;
+    }
+    testRunning = false;
+    std::cout << "\n=== TESTE EXTREMO INTERROMPIDO (" << testNames[currentTest] << ", "
+              << currentTriangleCount << " triângulos) ===" << std::endl;
+}
+
+void writeReports() {
+    if (perfMonitor) {
+        perfMonitor->generateCSVReport("data/extreme_performance_data.csv");
+        perfMonitor->generatePerformanceReport("reports/extreme_performance_report.txt");
+    }
+}
+
+// Levar o renderer ao estado que o modo tem na varredura automática, vindo de
+// qualquer outro (comando "mode" da telemetria). Com a varredura em andamento,
+// ela continua a partir do início do modo escolhido.
+void selectTest(TestState test) {
+    currentTest = test;
+    if (testRunning) {
+        currentTriangleCount = test == LIGHT_SWEEP_TEST ? sweepTriangleCount : 10000;
+    }
+    std::cout << "\n>>> Modo " << test + 1 << "/12: " << testNames[test] << " selecionado" << std::endl;
+    
+    bool depthTest = test == DEPTH_UNSORTED_TEST || test == DEPTH_SORTED_TEST || test == DEPTH_PREPASS_TEST;
+    bool animationTest = test == VERTEX_ANIMATION_TEST || test == VERTEX_PULLING_TEST || test == COMPUTE_ANIMATION_TEST;
+    renderer->setLightingEnabled(test != BASIC_TEST && !animationTest);
+    renderer->setTexturesEnabled(test == COMBINED_TEST || depthTest);
+    renderer->setDepthSpread(depthTest ? depthSpread : 0.0f);
+    // A varredura não desliga a ordenação depois do modo Ordenado
+    renderer->setFrontToBackSort(test >= DEPTH_SORTED_TEST);
+    renderer->setDepthPrepass(test == DEPTH_PREPASS_TEST);
+    renderer->setDeferredShading(test == DEFERRED_PATH_TEST);
+    if (test == FORWARD_PATH_TEST || test == DEFERRED_PATH_TEST) {
+        renderer->setLightCount(pathLightCount);
+    } else if (test == LIGHT_SWEEP_TEST) {
+        currentLightCount = minLights;
+        renderer->setLightCount(currentLightCount);
+    }
+    renderer->setVertexPulling(test == VERTEX_PULLING_TEST);
+    if (test == COMPUTE_ANIMATION_TEST) {
+        renderer->setAnimationPath(AnimationPath::Compute);
+    } else {
+        renderer->setAnimationPath(animationTest ? AnimationPath::VertexShader : AnimationPath::CPU);
+    }
+    
+    if (perfMonitor) {
+        perfMonitor->setPhase(testNames[test]);
+    }
+    renderer->setTriangleCount(currentTriangleCount);
+}
+
+// Comandos recebidos pela telemetria, aplicados aqui entre frames (a thread do servidor não toca no GL)
+void processTelemetryCommands() {
+    TelemetryCommand command;
+    while (telemetry && telemetry->pollCommand(command)) {
+        switch (command.type) {
+            case TelemetryCommand::START_SWEEP:
+                startExtremeTest();
+                break;
+            case TelemetryCommand::STOP_SWEEP:
+                stopExtremeTest();
+                break;
+            case TelemetryCommand::SET_TRIANGLES:
+                // O servidor já recusa valores acima do máximo; o limite aqui protege o renderer
+                currentTriangleCount = std::min<int64_t>(command.value, maxTriangles);
+                renderer->setTriangleCount(currentTriangleCount);
+                break;
+            case TelemetryCommand::SET_MODE:
+                selectTest(static_cast<TestState>(command.value));
+                break;
+            case TelemetryCommand::DUMP_REPORT:
+                writeReports();
+                std::cout << "Relatórios gravados com " << perfMonitor->getDataPointCount() << " medições" << std::endl;
+                break;
+        }
+    }
+}
+
+void publishTelemetry() {
+    if (!telemetry->isPublishDue()) {
+        return;
+    }
+    const RenderStats stats = renderer->getRenderStats();
+    TelemetryState state;
+    state.fps = fps;
+    state.triangleCount = currentTriangleCount;
+    state.mode = currentTest;
+    state.running = testRunning;
+    state.complete = testComplete;
+    state.gpuFrameMs = stats.gpuFrameMs;
+    state.lightCount = stats.lightCount;
+    state.dataPoints = perfMonitor->getDataPointCount();
+    if (const PerformanceData* last = perfMonitor->getLastDataPoint()) {
+        state.cpuUsage = last->cpuUsage;
+        state.gpuUsage = last->gpuUsage;
+    }
+    telemetry->publish(state);
 }
 
 void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods) {
@@ -49,27 +213,12 @@ void key_callback(GLFWwindow* window, int key, int scancode, int action, int mod
         glfwSetWindowShouldClose(window, true);
     }
     else if (key == GLFW_KEY_SPACE && action == GLFW_PRESS) {
-        if (!testRunning && !testComplete) {
-            testRunning = true;
-            std::cout << "\n=== INICIANDO TESTE EXTREMO AUTOMÁTICO ===" << std::endl;
-            std::cout << "PASSOS DE 10.000 TRIÂNGULOS ATÉ 200.000!" << std::endl;
-            std::cout << "O teste rodará automaticamente pelos 3 modos" << std::endl;
-            currentTriangleCount = 10000;
-            testComplete = false;
-            currentTest = BASIC_TEST;
-            
-            // Configurar modo inicial (básico)
-            if (renderer) {
-                renderer->setLightingEnabled(false);
-                renderer->setTexturesEnabled(false);
-                renderer->setTriangleCount(currentTriangleCount);
-            }
-            std::cout << "\n>>> Teste 1/3: BÁSICO iniciado..." << std::endl;
-        }
+        startExtremeTest();
     }
 }
 
 bool initializeGLFW() {
+    StartupProfile::Scope phase("Contexto GL (GLFW)");
     if (!glfwInit()) {
         std::cerr << "Erro ao inicializar GLFW" << std::endl;
         return false;
@@ -94,6 +243,7 @@ bool initializeGLFW() {
 }
 
 bool initializeGLEW() {
+    StartupProfile::Scope phase("GLEW");
     if (glewInit() != GLEW_OK) {
         std::cerr << "Erro ao inicializar GLEW" << std::endl;
         return false;
@@ -118,52 +268,143 @@ void updateFPS() {
             bool hasTextures = renderer->isTexturesEnabled();
             
             std::cout << "Teste: " << testNames[currentTest] 
-                      << " | Triângulos: " << currentTriangleCount 
-                      << " | FPS: " << fps << std::endl;
+                      << " | Triângulos: " << currentTriangleCount;
+            if (currentTest == LIGHT_SWEEP_TEST) {
+                std::cout << " | Luzes: " << currentLightCount;
+            } else if (currentTest == FORWARD_PATH_TEST || currentTest == DEFERRED_PATH_TEST) {
+                std::cout << " | Luzes: " << pathLightCount;
+            }
+            if (renderer->getDepthSpread() > 0.0f) {
+                std::cout << " | Fragmentos/pixel: " << renderer->getRenderStats().shadedFragmentsPerPixel;
+            }
+            std::cout << " | FPS: " << fps << std::endl;
             
             // Registrar dados de performance
             if (perfMonitor) {
-                perfMonitor->addDataPoint(fps, currentTriangleCount, hasLighting, hasTextures);
+                perfMonitor->addDataPoint(fps, currentTriangleCount, hasLighting, hasTextures,
+                                          renderer->getRenderStats());
             }
             
-            // Avançar para próximo teste
-            currentTriangleCount += triangleStep;
-            if (currentTriangleCount > maxTriangles) {
+            // Avançar para próximo teste (na varredura de luzes, o passo é o número de luzes)
+            bool phaseDone;
+            if (currentTest == LIGHT_SWEEP_TEST) {
+                currentLightCount *= 2;
+                phaseDone = currentLightCount > maxLights;
+                if (!phaseDone) {
+                    renderer->setLightCount(currentLightCount);
+                }
+            } else {
+                currentTriangleCount += triangleStep;
+                phaseDone = currentTriangleCount > maxTriangles;
+            }
+            
+            if (phaseDone) {
+                // Mapa de overdraw da maior carga da fase (com GLPERF_OVERDRAW=1)
+                if (renderer->isOverdrawAnalysisEnabled()) {
+                    renderer->writeOverdrawHeatmap("reports/overdraw_fase" + std::to_string(currentTest + 1) + ".ppm");
+                }
+                
                 // Avançar para próximo tipo de teste
                 currentTriangleCount = 10000;
                 currentTest = static_cast<TestState>(currentTest + 1);
+                if (currentTest == COMPUTE_ANIMATION_TEST && !TriangleAnimation::isComputeSupported()) {
+                    std::cout << "\n>>> Teste 12/12: ANIMAÇÃO COMPUTE ignorado (requer OpenGL 4.3)" << std::endl;
+                    currentTest = static_cast<TestState>(currentTest + 1);
+                }
                 
-                if (currentTest > COMBINED_TEST) {
+                if (currentTest > COMPUTE_ANIMATION_TEST) {
                     testComplete = true;
                     testRunning = false;
+                    renderer->setAnimationPath(AnimationPath::CPU);
+                    renderer->setVertexPulling(false);
                     std::cout << "\n=== TESTE EXTREMO CONCLUÍDO ===" << std::endl;
                     std::cout << "Gerando relatórios..." << std::endl;
                     
                     // Gerar relatórios
-                    if (perfMonitor) {
-                        perfMonitor->generateCSVReport("data/extreme_performance_data.csv");
-                        perfMonitor->generatePerformanceReport("reports/extreme_performance_report.txt");
-                    }
+                    writeReports();
                     
                     std::cout << "Relatórios gerados em data/extreme_performance_data.csv" << std::endl;
                     std::cout << "Execute: python3 scripts/analyze_data.py data/extreme_performance_data.csv" << std::endl;
                 } else {
-                    // Configurar próximo teste
+                    // Configurar o teste que está começando
+                    if (perfMonitor) {
+                        perfMonitor->setPhase(testNames[currentTest]);
+                    }
                     switch (currentTest) {
-                        case BASIC_TEST:
-                            std::cout << "\n>>> Teste 1/3: BÁSICO concluído!" << std::endl;
-                            std::cout << ">>> Teste 2/3: ILUMINAÇÃO iniciado..." << std::endl;
+                        case LIGHTING_TEST:
+                            std::cout << "\n>>> Teste 1/12: BÁSICO concluído!" << std::endl;
+                            std::cout << ">>> Teste 2/12: ILUMINAÇÃO iniciado..." << std::endl;
                             renderer->setLightingEnabled(true);
                             renderer->setTexturesEnabled(false);
                             break;
-                        case LIGHTING_TEST:
-                            std::cout << "\n>>> Teste 2/3: ILUMINAÇÃO concluído!" << std::endl;
-                            std::cout << ">>> Teste 3/3: COMBINADO (Iluminação + Texturas) iniciado..." << std::endl;
+                        case COMBINED_TEST:
+                            std::cout << "\n>>> Teste 2/12: ILUMINAÇÃO concluído!" << std::endl;
+                            std::cout << ">>> Teste 3/12: COMBINADO (Iluminação + Texturas) iniciado..." << std::endl;
                             renderer->setLightingEnabled(true);
                             renderer->setTexturesEnabled(true);
                             break;
-                        case COMBINED_TEST:
-                            // Não deveria chegar aqui
+                        case DEPTH_UNSORTED_TEST:
+                            std::cout << "\n>>> Teste 3/12: COMBINADO concluído!" << std::endl;
+                            std::cout << ">>> Teste 4/12: PROFUNDIDADE (z em ±" << depthSpread
+                                      << ", ordem de geração) iniciado..." << std::endl;
+                            renderer->setFrontToBackSort(false);
+                            renderer->setDepthSpread(depthSpread);
+                            break;
+                        case DEPTH_SORTED_TEST:
+                            std::cout << "\n>>> Teste 4/12: PROFUNDIDADE concluído!" << std::endl;
+                            std::cout << ">>> Teste 5/12: ORDENADO (frente para trás) iniciado..." << std::endl;
+                            renderer->setFrontToBackSort(true);
+                            break;
+                        case DEPTH_PREPASS_TEST:
+                            std::cout << "\n>>> Teste 5/12: ORDENADO concluído!" << std::endl;
+                            std::cout << ">>> Teste 6/12: PRÉ-PASSADA (profundidade + GL_EQUAL) iniciado..." << std::endl;
+                            renderer->setDepthPrepass(true);
+                            break;
+                        case FORWARD_PATH_TEST:
+                            std::cout << "\n>>> Teste 6/12: PRÉ-PASSADA concluído!" << std::endl;
+                            std::cout << ">>> Teste 7/12: FORWARD (" << pathLightCount << " luzes) iniciado..." << std::endl;
+                            renderer->setDepthPrepass(false);
+                            renderer->setDepthSpread(0.0f);
+                            renderer->setLightingEnabled(true);
+                            renderer->setTexturesEnabled(false);
+                            renderer->setLightCount(pathLightCount);
+                            break;
+                        case DEFERRED_PATH_TEST:
+                            std::cout << "\n>>> Teste 7/12: FORWARD concluído!" << std::endl;
+                            std::cout << ">>> Teste 8/12: DEFERRED (" << pathLightCount << " luzes) iniciado..." << std::endl;
+                            renderer->setDeferredShading(true);
+                            break;
+                        case LIGHT_SWEEP_TEST:
+                            std::cout << "\n>>> Teste 8/12: DEFERRED concluído!" << std::endl;
+                            std::cout << ">>> Teste 9/12: LUZES (" << currentLightCount << " a " << maxLights
+                                      << ", " << sweepTriangleCount << " triângulos) iniciado..." << std::endl;
+                            renderer->setDeferredShading(false);
+                            renderer->setLightingEnabled(true);
+                            renderer->setTexturesEnabled(false);
+                            currentTriangleCount = sweepTriangleCount;
+                            renderer->setLightCount(currentLightCount);
+                            break;
+                        case VERTEX_ANIMATION_TEST:
+                            std::cout << "\n>>> Teste 9/12: LUZES concluído!" << std::endl;
+                            std::cout << ">>> Teste 10/12: ANIMAÇÃO VS (rotação no vertex shader) iniciado..." << std::endl;
+                            renderer->setLightingEnabled(false);
+                            renderer->setTexturesEnabled(false);
+                            renderer->setAnimationPath(AnimationPath::VertexShader);
+                            break;
+                        case VERTEX_PULLING_TEST:
+                            // Mesma animação da fase anterior: a diferença é só a leitura dos vértices
+                            std::cout << "\n>>> Teste 10/12: ANIMAÇÃO VS concluído!" << std::endl;
+                            std::cout << ">>> Teste 11/12: VERTEX PULLING (registro por triângulo) iniciado..."
+                                      << std::endl;
+                            renderer->setVertexPulling(true);
+                            break;
+                        case COMPUTE_ANIMATION_TEST:
+                            std::cout << "\n>>> Teste 11/12: VERTEX PULLING concluído!" << std::endl;
+                            std::cout << ">>> Teste 12/12: ANIMAÇÃO COMPUTE (matrizes em SSBO) iniciado..." << std::endl;
+                            renderer->setVertexPulling(false);
+                            renderer->setAnimationPath(AnimationPath::Compute);
+                            break;
+                        default:
                             break;
                     }
                     // Configurar os triângulos para o novo teste
@@ -194,11 +435,16 @@ void renderLoop() {
         double deltaTime = currentFrameTime - lastFrameTime;
         lastFrameTime = currentFrameTime;
         
+        processTelemetryCommands();
+        
         glClearColor(0.15f, 0.15f, 0.2f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
         if (renderer) {
+            // Estatísticas do pipeline (vértices, primitivas, invocações) do frame
+            if (perfMonitor) perfMonitor->beginPipelineQueries();
             renderer->render(deltaTime);
+            if (perfMonitor) perfMonitor->endPipelineQueries();
         }
 
         if (perfMonitor) {
@@ -210,6 +456,17 @@ void renderLoop() {
         glfwSwapBuffers(window);
         glfwPollEvents();
         
+        // Tempo do frame sem a pausa entre frames do teste automático
+        if (telemetry) {
+            telemetry->recordFrame((glfwGetTime() - currentFrameTime) * 1000.0);
+            publishTelemetry();
+        }
+        
+        // Registrar o tempo de inicialização assim que o primeiro frame é apresentado
+        if (perfMonitor) {
+            perfMonitor->recordFirstFrame("ExtremeTest");
+        }
+        
         if (testRunning && !testComplete) {
             std::this_thread::sleep_for(std::chrono::milliseconds(50));
         }
@@ -217,10 +474,27 @@ void renderLoop() {
 }
 
 int main() {
+    StartupProfile::start();
+    
+    // Informações do sistema (lspci) numa thread de fundo, sobrepostas à
+    // criação do contexto e dos shaders
+    perfMonitor = new PerformanceMonitor();
+    perfMonitor->querySystemInfo();
+
+    // Cargas de dezenas de milhões: a geometria vai para a GPU em blocos de 1M triângulos
+    const char* maxEnv = std::getenv("GLPERF_MAX_TRIANGLES");
+    int64_t requestedMax = maxEnv ? std::atoll(maxEnv) : 0;
+    if (requestedMax > maxTriangles) {
+        maxTriangles = requestedMax;
+        triangleStep = requestedMax / 20;
+    }
+
     std::cout << "=== TESTE EXTREMO DE PERFORMANCE ===" << std::endl;
-    std::cout << "Este teste usa passos de 10.000 triângulos!" << std::endl;
-    std::cout << "Variando de 10.000 até 200.000 triângulos" << std::endl;
-    std::cout << "3 Modos: Básico | Iluminação | Combinado (Iluminação + Texturas)" << std::endl;
+    std::cout << "Este teste usa passos de " << triangleStep << " triângulos!" << std::endl;
+    std::cout << "Variando de 10000 até " << maxTriangles << " triângulos" << std::endl;
+    std::cout << "12 Modos: Básico | Iluminação | Combinado (Iluminação + Texturas) | Profundidade, Ordenado e Pré-passada" << std::endl;
+    std::cout << "          | Forward e Deferred (64 luzes) | Luzes (8 a 4096) | Animação VS | Vertex pulling" << std::endl;
+    std::cout << "          | Animação Compute" << std::endl;
     std::cout << "⚠️  AVISO: Este teste é PESADO e pode deixar o sistema lento!\n" << std::endl;
 
     system("mkdir -p data reports");
@@ -234,7 +508,7 @@ int main() {
         return -1;
     }
 
-    glEnable(GL_DEPTH_TEST);
+    GLStateCache::setDepthTest(true);
 
     renderer = new AdvancedRenderer();
     if (!renderer->initialize()) {
@@ -246,16 +520,31 @@ int main() {
 
     renderer->setTriangleCount(currentTriangleCount);
 
-    perfMonitor = new PerformanceMonitor();
     perfMonitor->initialize();
 
+    // Telemetria e comandos remotos (GLPERF_TELEMETRY_PORT=N; 1 = porta padrão)
+    int telemetryPort = TelemetryServer::requestedPort();
+    if (telemetryPort > 0) {
+        telemetry = new TelemetryServer(std::vector<std::string>(std::begin(testNames), std::end(testNames)),
+                                        maxTriangles);
+        if (!telemetry->start(telemetryPort)) {
+            delete telemetry;
+            telemetry = nullptr;
+        }
+    }
+
     std::cout << "\nControles:" << std::endl;
     std::cout << "ESPAÇO - Iniciar teste extremo automático" << std::endl;
     std::cout << "ESC - Sair" << std::endl;
+    if (telemetry) {
+        std::cout << "curl -d start 127.0.0.1:" << telemetry->getPort() << "/command - Iniciar pelo socket" << std::endl;
+    }
     std::cout << "\nPressione ESPAÇO para iniciar...\n" << std::endl;
 
     renderLoop();
 
+    // Parar o servidor antes de destruir o que o laço de render publicava
+    delete telemetry;
     delete renderer;
     delete perfMonitor;
     glfwTerminate();
@@ -7,6 +7,9 @@
 #include <cmath>
 #include "Renderer.h"
 #include "PerformanceMonitor.h"
+#include "StartupProfile.h"
+#include "GLStateCache.h"
+#include "GLProfiler.h"
 
 // Configurações da janela
 const int WINDOW_WIDTH = 1024;
@@ -28,7 +31,7 @@ float rotationAngle = 0.0f;
 
 // Callback para redimensionamento da janela
 void framebuffer_size_callback(GLFWwindow* window, int width, int height) {
-    glViewport(0, 0, width, height);
+    GLStateCache::viewport(0, 0, width, height);
 }
 
 // Callback para teclado
@@ -40,6 +43,7 @@ void key_callback(GLFWwindow* window, int key, int scancode, int action, int mod
 
 // Inicializar GLFW e criar janela
 bool initializeGLFW() {
+    StartupProfile::Scope phase("Contexto GL (GLFW)");
     if (!glfwInit()) {
         std::cerr << "Erro ao inicializar GLFW" << std::endl;
         return false;
@@ -67,6 +71,7 @@ bool initializeGLFW() {
 
 // Inicializar GLEW
 bool initializeGLEW() {
+    StartupProfile::Scope phase("GLEW");
     if (glewInit() != GLEW_OK) {
         std::cerr << "Erro ao inicializar GLEW" << std::endl;
         return false;
@@ -122,10 +127,22 @@ void renderLoop() {
         // Trocar buffers e processar eventos
         glfwSwapBuffers(window);
         glfwPollEvents();
+        
+        // Registrar o tempo de inicialização assim que o primeiro frame é apresentado
+        if (perfMonitor) {
+            perfMonitor->recordFirstFrame("OpenGL_Performance_Test");
+        }
     }
 }
 
 int main() {
+    StartupProfile::start();
+    
+    // Informações do sistema (lspci) numa thread de fundo, sobrepostas à
+    // criação do contexto e dos shaders
+    perfMonitor = new PerformanceMonitor();
+    perfMonitor->querySystemInfo();
+
     std::cout << "=== OpenGL Performance Test ===" << std::endl;
     std::cout << "Iniciando teste de desempenho..." << std::endl;
 
@@ -149,8 +166,7 @@ int main() {
         return -1;
     }
 
-    // Criar monitor de performance
-    perfMonitor = new PerformanceMonitor();
+    // Inicializar monitor de performance
     perfMonitor->initialize();
 
     std::cout << "\nControles:" << std::endl;
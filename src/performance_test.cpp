@@ -7,6 +7,9 @@
 #include <cmath>
 #include "MultiTriangleRenderer.h"
 #include "PerformanceMonitor.h"
+#include "StartupProfile.h"
+#include "GLStateCache.h"
+#include "GLProfiler.h"
 
 // Configurações da janela
 const int WINDOW_WIDTH = 1024;
@@ -24,15 +27,15 @@ int frameCount = 0;
 double fps = 0.0;
 
 // Configurações do teste
-int currentTriangleCount = 1;
-int maxTriangles = 1000;
-int triangleStep = 50;
+int64_t currentTriangleCount = 1;
+int64_t maxTriangles = 1000;
+int64_t triangleStep = 50;
 bool testRunning = false;
 bool testComplete = false;
 
 // Callback para redimensionamento da janela
 void framebuffer_size_callback(GLFWwindow* window, int width, int height) {
-    glViewport(0, 0, width, height);
+    GLStateCache::viewport(0, 0, width, height);
 }
 
 // Callback para teclado
@@ -61,6 +64,7 @@ void key_callback(GLFWwindow* window, int key, int scancode, int action, int mod
 
 // Inicializar GLFW e criar janela
 bool initializeGLFW() {
+    StartupProfile::Scope phase("Contexto GL (GLFW)");
     if (!glfwInit()) {
         std::cerr << "Erro ao inicializar GLFW" << std::endl;
         return false;
@@ -88,6 +92,7 @@ bool initializeGLFW() {
 
 // Inicializar GLEW
 bool initializeGLEW() {
+    StartupProfile::Scope phase("GLEW");
     if (glewInit() != GLEW_OK) {
         std::cerr << "Erro ao inicializar GLEW" << std::endl;
         return false;
@@ -177,6 +182,11 @@ void renderLoop() {
         glfwSwapBuffers(window);
         glfwPollEvents();
         
+        // Registrar o tempo de inicialização assim que o primeiro frame é apresentado
+        if (perfMonitor) {
+            perfMonitor->recordFirstFrame("PerformanceTest");
+        }
+        
         // Pequena pausa entre testes para estabilizar
         if (testRunning && !testComplete) {
             std::this_thread::sleep_for(std::chrono::milliseconds(100));
@@ -185,6 +195,13 @@ void renderLoop() {
 }
 
 int main() {
+    StartupProfile::start();
+    
+    // Informações do sistema (lspci) numa thread de fundo, sobrepostas à
+    // criação do contexto e dos shaders
+    perfMonitor = new PerformanceMonitor();
+    perfMonitor->querySystemInfo();
+
     std::cout << "=== OpenGL Performance Test - Múltiplos Triângulos ===" << std::endl;
     std::cout << "Iniciando teste de desempenho..." << std::endl;
 
@@ -214,8 +231,7 @@ int main() {
     // Configurar número inicial de triângulos
     renderer->setTriangleCount(currentTriangleCount);
 
-    // Criar monitor de performance
-    perfMonitor = new PerformanceMonitor();
+    // Inicializar monitor de performance
     perfMonitor->initialize();
 
     std::cout << "\nControles:" << std::endl;
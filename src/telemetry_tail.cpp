@@ -0,0 +1,180 @@
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "SharedTelemetry.h"
+
+// Acompanha ao vivo os blocos /dev/shm/glperf.<pid> publicados pelos programas
+// rodando com GLPERF_SHM=1. Só lê memória compartilhada: os processos medidos
+// não fazem nenhuma E/S por causa do leitor.
+
+namespace {
+
+struct ProcessRow {
+    std::string segment;
+    int pid;
+    std::string program;
+    SharedTelemetryFrame frame;
+    bool consistent;
+    bool alive;
+};
+
+// Frames vistos na leitura anterior, para a taxa medida pelo leitor
+struct PreviousRead {
+    uint64_t frame;
+    std::chrono::steady_clock::time_point when;
+};
+
+// Preencher até a largura em caracteres (não bytes: as fases têm acentos)
+std::string pad(const std::string& text, size_t width) {
+    size_t characters = 0;
+    for (unsigned char c : text) {
+        if ((c & 0xC0) != 0x80) characters++;
+    }
+    return characters >= width ? text : text + std::string(width - characters, ' ');
+}
+
+std::string padLeft(const std::string& text, size_t width) {
+    std::string padded = pad(text, width);
+    return padded.substr(text.size()) + text;
+}
+
+bool readSegment(const std::string& segment, ProcessRow& row) {
+    int fd = shm_open(("/" + segment).c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    void* memory = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && (size_t)info.st_size >= sizeof(SharedTelemetryBlock)) {
+        memory = mmap(nullptr, sizeof(SharedTelemetryBlock), PROT_READ, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (memory == MAP_FAILED) {
+        return false;
+    }
+
+    const SharedTelemetryBlock* block = static_cast<const SharedTelemetryBlock*>(memory);
+    bool valid = block->magic == SharedTelemetry::MAGIC && block->version == SharedTelemetry::VERSION;
+    if (valid) {
+        row.segment = segment;
+        row.pid = block->pid;
+        row.program = std::string(block->program, strnlen(block->program, sizeof(block->program)));
+        row.consistent = SharedTelemetry::read(block, row.frame);
+        row.frame.phase[sizeof(row.frame.phase) - 1] = '\0';
+        row.alive = kill(row.pid, 0) == 0 || errno == EPERM;
+    }
+    munmap(memory, sizeof(SharedTelemetryBlock));
+    return valid;
+}
+
+std::vector<ProcessRow> scanSegments() {
+    std::vector<ProcessRow> rows;
+    DIR* directory = opendir("/dev/shm");
+    if (!directory) {
+        return rows;
+    }
+    while (dirent* entry = readdir(directory)) {
+        std::string segment = entry->d_name;
+        if (segment.compare(0, std::strlen(SharedTelemetry::NAME_PREFIX), SharedTelemetry::NAME_PREFIX) != 0) {
+            continue;
+        }
+        ProcessRow row;
+        if (readSegment(segment, row)) {
+            rows.push_back(row);
+        }
+    }
+    closedir(directory);
+    std::sort(rows.begin(), rows.end(), [](const ProcessRow& a, const ProcessRow& b) { return a.pid < b.pid; });
+    return rows;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    int intervalMs = 1000;
+    int iterations = 0;   // 0 = até Ctrl+C
+    bool clean = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-i" && i + 1 < argc) {
+            intervalMs = std::max(50, std::atoi(argv[++i]));
+        } else if (arg == "-n" && i + 1 < argc) {
+            iterations = std::atoi(argv[++i]);
+        } else if (arg == "--clean") {
+            clean = true;
+        } else {
+            std::cout << "Uso: telemetry_tail [-i intervalo_ms] [-n leituras] [--clean]" << std::endl;
+            std::cout << "  --clean  remover blocos de processos que já terminaram (encerrados sem limpar)" << std::endl;
+            return 1;
+        }
+    }
+
+    bool terminal = isatty(STDOUT_FILENO);
+    std::map<std::string, PreviousRead> previous;
+    for (int iteration = 0; iterations == 0 || iteration < iterations; ++iteration) {
+        if (iteration > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs));
+        }
+        auto now = std::chrono::steady_clock::now();
+        std::vector<ProcessRow> rows = scanSegments();
+
+        std::ostringstream out;
+        out << std::fixed;
+        if (terminal) {
+            out << "\033[H\033[J";
+        }
+        out << pad("PID", 8) << pad("Programa", 16) << pad("Fase", 18) << padLeft("Triângulos", 11)
+            << padLeft("FPS", 10) << padLeft("Frames/s", 10) << padLeft("Frame ms", 10) << padLeft("GL/frame", 9)
+            << padLeft("CPU%", 7) << padLeft("GPU%", 7) << padLeft("Medições", 10) << "  Estado\n";
+
+        for (const ProcessRow& row : rows) {
+            // Taxa medida aqui, pela variação do contador de frames entre leituras
+            double framesPerSecond = 0.0;
+            auto last = previous.find(row.segment);
+            bool seen = last != previous.end();
+            if (seen && row.frame.frame >= last->second.frame) {
+                double seconds = std::chrono::duration<double>(now - last->second.when).count();
+                framesPerSecond = seconds > 0 ? (row.frame.frame - last->second.frame) / seconds : 0.0;
+            }
+            previous[row.segment] = PreviousRead{row.frame.frame, now};
+
+            const char* state = !row.alive ? "encerrado"
+                              : !row.consistent ? "ocupado"
+                              : (seen && framesPerSecond == 0.0) ? "parado" : "ativo";
+            out << pad(std::to_string(row.pid), 8) << pad(row.program, 16) << pad(row.frame.phase, 18)
+                << std::setw(11) << row.frame.triangleCount
+                << std::setprecision(1) << std::setw(10) << row.frame.fps
+                << std::setw(10) << framesPerSecond
+                << std::setprecision(2) << std::setw(10) << row.frame.frameMs
+                << std::setprecision(0) << std::setw(9) << row.frame.glCallsIssued
+                << std::setw(7) << (row.frame.cpuUsage >= 0 ? row.frame.cpuUsage : 0.0)
+                << std::setw(7) << (row.frame.gpuUsage >= 0 ? row.frame.gpuUsage : 0.0)
+                << std::setw(10) << row.frame.dataPoints << "  " << state << "\n";
+
+            if (!row.alive && clean) {
+                shm_unlink(("/" + row.segment).c_str());
+                previous.erase(row.segment);
+            }
+        }
+        if (rows.empty()) {
+            out << "(nenhum processo com GLPERF_SHM=1)\n";
+        }
+        std::cout << out.str() << std::flush;
+    }
+    return 0;
+}
@@ -0,0 +1,297 @@
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include "AdvancedRenderer.h"
+#include "PerformanceMonitor.h"
+#include "StartupProfile.h"
+#include "GLStateCache.h"
+#include "GLProfiler.h"
+
+// Matriz de amostragem de texturas: tamanho x formato x filtro x escala de UV
+// sobre a cena combinada (iluminação + texturas). Cada configuração é medida
+// com GL_TIME_ELAPSED; os fragmentos vêm do GL_SAMPLES_PASSED do renderer.
+// Amostras/s = fragmentos / tempo de GPU; texels/s multiplica pelos texels que
+// o filtro lê por amostra (estimativa: o hardware pode ler menos).
+
+// Configurações da janela
+const int WINDOW_WIDTH = 1024;
+const int WINDOW_HEIGHT = 768;
+const char* WINDOW_TITLE = "OpenGL Performance Test - Benchmark de Texturas";
+
+// Frames por configuração
+const int WARMUP_FRAMES = 10;
+const int MEASURED_FRAMES = 60;
+
+GLFWwindow* window = nullptr;
+AdvancedRenderer* renderer = nullptr;
+PerformanceMonitor* perfMonitor = nullptr;
+
+struct FilterPreset {
+    const char* name;
+    GLenum minFilter;
+    GLenum magFilter;
+    float anisotropy;
+};
+
+const FilterPreset FILTER_PRESETS[] = {
+    {"nearest",      GL_NEAREST,                GL_NEAREST, 1.0f},
+    {"bilinear",     GL_LINEAR,                 GL_LINEAR,  1.0f},
+    {"bilinear-mip", GL_LINEAR_MIPMAP_NEAREST,  GL_LINEAR,  1.0f},
+    {"trilinear",    GL_LINEAR_MIPMAP_LINEAR,   GL_LINEAR,  1.0f},
+    {"aniso4x",      GL_LINEAR_MIPMAP_LINEAR,   GL_LINEAR,  4.0f},
+    {"aniso16x",     GL_LINEAR_MIPMAP_LINEAR,   GL_LINEAR,  16.0f},
+};
+
+// Texels lidos por amostra: com UV abaixo de 1 a textura é ampliada (filtro de
+// magnificação); acima, reduzida (filtro de minificação e anisotropia)
+double texelsPerSample(const FilterPreset& preset, float uvScale) {
+    if (uvScale < 1.0f) {
+        return preset.magFilter == GL_NEAREST ? 1.0 : 4.0;
+    }
+    double taps = 4.0;
+    if (preset.minFilter == GL_NEAREST || preset.minFilter == GL_NEAREST_MIPMAP_NEAREST) {
+        taps = 1.0;
+    } else if (preset.minFilter == GL_LINEAR_MIPMAP_LINEAR) {
+        taps = 8.0;
+    }
+    return taps * preset.anisotropy;
+}
+
+// Callback para redimensionamento da janela
+void framebuffer_size_callback(GLFWwindow* window, int width, int height) {
+    GLStateCache::viewport(0, 0, width, height);
+}
+
+// Inicializar GLFW e criar janela
+bool initializeGLFW() {
+    StartupProfile::Scope phase("Contexto GL (GLFW)");
+    if (!glfwInit()) {
+        std::cerr << "Erro ao inicializar GLFW" << std::endl;
+        return false;
+    }
+
+    // Configurar versão do OpenGL
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+    window = glfwCreateWindow(WINDOW_WIDTH, WINDOW_HEIGHT, WINDOW_TITLE, nullptr, nullptr);
+    if (!window) {
+        std::cerr << "Erro ao criar janela GLFW" << std::endl;
+        glfwTerminate();
+        return false;
+    }
+
+    glfwMakeContextCurrent(window);
+    glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
+    // Sem VSync: o tempo de GPU não depende dele, mas o benchmark termina antes
+    glfwSwapInterval(0);
+
+    return true;
+}
+
+// Inicializar GLEW
+bool initializeGLEW() {
+    StartupProfile::Scope phase("GLEW");
+    if (glewInit() != GLEW_OK) {
+        std::cerr << "Erro ao inicializar GLEW" << std::endl;
+        return false;
+    }
+
+    std::cout << "OpenGL Version: " << glGetString(GL_VERSION) << std::endl;
+    std::cout << "GPU: " << glGetString(GL_RENDERER) << std::endl;
+    std::cout << "Vendor: " << glGetString(GL_VENDOR) << std::endl;
+
+    return true;
+}
+
+// Um frame da cena; deltaTime 0 mantém a mesma cena em todas as configurações
+void renderFrame(GLuint timeQuery) {
+    glClearColor(0.15f, 0.15f, 0.2f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    if (timeQuery) glBeginQuery(GL_TIME_ELAPSED, timeQuery);
+    renderer->render(0.0f);
+    if (timeQuery) glEndQuery(GL_TIME_ELAPSED);
+
+    perfMonitor->update();
+    glfwSwapBuffers(window);
+    glfwPollEvents();
+
+    perfMonitor->recordFirstFrame("TextureBenchmark");
+}
+
+// Medir a configuração atual e registrar como uma fase; false se a janela foi fechada
+bool measureConfiguration(const std::string& label, const FilterPreset& preset, float uvScale,
+                          int64_t triangles, GLuint* timeQueries) {
+    for (int i = 0; i < WARMUP_FRAMES; ++i) {
+        renderFrame(0);
+    }
+
+    auto begin = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < MEASURED_FRAMES; ++i) {
+        renderFrame(timeQueries[i]);
+    }
+    double wallSeconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - begin).count();
+
+    // Resultados lidos só no fim: esperar aqui não atrapalha os frames medidos
+    double gpuSeconds = 0.0;
+    for (int i = 0; i < MEASURED_FRAMES; ++i) {
+        GLuint64 elapsed = 0;
+        glGetQueryObjectui64v(timeQueries[i], GL_QUERY_RESULT, &elapsed);
+        gpuSeconds += elapsed * 1e-9;
+    }
+
+    RenderStats stats = renderer->getRenderStats();
+    double gpuFrameMs = gpuSeconds * 1000.0 / MEASURED_FRAMES;
+    stats.gpuFrameMs = gpuFrameMs;
+    if (gpuSeconds > 0.0) {
+        stats.textureSamplesPerSecond = stats.shadedFragments * MEASURED_FRAMES / gpuSeconds;
+        stats.texelsPerSecond = stats.textureSamplesPerSecond * texelsPerSample(preset, uvScale);
+    }
+    double fps = wallSeconds > 0.0 ? MEASURED_FRAMES / wallSeconds : 0.0;
+
+    perfMonitor->setPhase(label);
+    perfMonitor->addDataPoint(fps, triangles, true, true, stats);
+
+    std::cout << std::left << std::setw(40) << label << std::right << std::fixed << std::setprecision(3)
+              << std::setw(10) << gpuFrameMs << " ms" << std::setprecision(2)
+              << std::setw(10) << stats.textureSamplesPerSecond / 1e9 << " Gamostras/s"
+              << std::setw(10) << stats.texelsPerSecond / 1e9 << " Gtexels/s" << std::endl;
+    std::cout.unsetf(std::ios::floatfield);
+
+    return !glfwWindowShouldClose(window);
+}
+
+int main(int argc, char* argv[]) {
+    StartupProfile::start();
+
+    int64_t triangles = 2000;
+    int maxSize = 8192;
+    bool quick = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--triangles" && i + 1 < argc) {
+            triangles = std::max<int64_t>(1, std::atoll(argv[++i]));
+        } else if (arg == "--max-size" && i + 1 < argc) {
+            maxSize = std::atoi(argv[++i]);
+        } else if (arg == "--quick") {
+            quick = true;
+        } else {
+            std::cout << "Uso: TextureBenchmark [--triangles N] [--max-size N] [--quick]" << std::endl;
+            std::cout << "  --quick  só 256/1024/4096, nearest/bilinear/trilinear/aniso16x e UV 1/16" << std::endl;
+            return 1;
+        }
+    }
+
+    perfMonitor = new PerformanceMonitor();
+    perfMonitor->querySystemInfo();
+
+    std::cout << "=== OpenGL Performance Test - Benchmark de Amostragem de Texturas ===" << std::endl;
+
+    // Criar diretórios necessários
+    system("mkdir -p data reports");
+
+    if (!initializeGLFW()) {
+        return -1;
+    }
+    if (!initializeGLEW()) {
+        glfwTerminate();
+        return -1;
+    }
+
+    GLStateCache::setDepthTest(true);
+
+    renderer = new AdvancedRenderer();
+    if (!renderer->initialize()) {
+        std::cerr << "Erro ao inicializar renderer avançado" << std::endl;
+        delete renderer;
+        glfwTerminate();
+        return -1;
+    }
+    renderer->setTriangleCount(triangles);
+    renderer->setLightingEnabled(true);
+    renderer->setTexturesEnabled(true);
+
+    perfMonitor->initialize();
+
+    GLint driverMaxSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &driverMaxSize);
+    float maxAnisotropy = Texture::getMaxAnisotropy();
+
+    std::vector<int> sizes = quick ? std::vector<int>{256, 1024, 4096}
+                                   : std::vector<int>{256, 512, 1024, 2048, 4096, 8192};
+    std::vector<TextureFormat> formats = {TextureFormat::RGB8, TextureFormat::RGBA8, TextureFormat::RGBA16F,
+                                          TextureFormat::BC1, TextureFormat::BC3};
+    std::vector<float> uvScales = quick ? std::vector<float>{1.0f, 16.0f} : std::vector<float>{0.0625f, 1.0f, 16.0f};
+    std::vector<FilterPreset> presets;
+    for (const FilterPreset& preset : FILTER_PRESETS) {
+        if (quick && (preset.minFilter == GL_LINEAR_MIPMAP_NEAREST || preset.anisotropy == 4.0f)) continue;
+        if (preset.anisotropy > maxAnisotropy) {
+            std::cout << "Preset " << preset.name << " ignorado (anisotropia máxima do driver: "
+                      << maxAnisotropy << ")" << std::endl;
+            continue;
+        }
+        presets.push_back(preset);
+    }
+
+    std::cout << "\nCena combinada com " << triangles << " triângulos, " << WARMUP_FRAMES << " frames de aquecimento e "
+              << MEASURED_FRAMES << " medidos por configuração" << std::endl;
+
+    GLuint timeQueries[MEASURED_FRAMES];
+    glGenQueries(MEASURED_FRAMES, timeQueries);
+
+    bool running = true;
+    for (TextureFormat format : formats) {
+        for (int size : sizes) {
+            if (!running) break;
+            if (size > maxSize || size > driverMaxSize) {
+                continue;
+            }
+            // Descartar erros anteriores: só o GL_OUT_OF_MEMORY da geração interessa
+            while (glGetError() != GL_NO_ERROR) {}
+            // Mipmaps da textura são sempre gerados: os presets sem mip só não os usam
+            bool generated = renderer->setTextureConfig(size, 1, false, format);
+            if (glGetError() == GL_OUT_OF_MEMORY || !generated) {
+                std::cerr << TextureCompression::formatName(format) << " " << size << "x" << size
+                          << " ignorada (sem memória ou não suportada)" << std::endl;
+                continue;
+            }
+
+            for (const FilterPreset& preset : presets) {
+                renderer->setTextureSampling(preset.minFilter, preset.magFilter, preset.anisotropy);
+                for (float uvScale : uvScales) {
+                    renderer->setUVScale(uvScale);
+                    std::ostringstream label;
+                    label << renderer->getRenderStats().textureFormat << " " << size << " " << preset.name
+                          << " uv" << uvScale;
+                    if (!measureConfiguration(label.str(), preset, uvScale, triangles, timeQueries)) {
+                        running = false;
+                        break;
+                    }
+                }
+                if (!running) break;
+            }
+        }
+        if (!running) break;
+    }
+    glDeleteQueries(MEASURED_FRAMES, timeQueries);
+
+    std::cout << "\nGerando relatórios..." << std::endl;
+    perfMonitor->generateCSVReport("data/texture_benchmark.csv");
+    perfMonitor->generatePerformanceReport("reports/texture_benchmark_report.txt");
+
+    delete renderer;
+    delete perfMonitor;
+    glfwTerminate();
+
+    std::cout << "\nPrograma finalizado!" << std::endl;
+    return 0;
+}